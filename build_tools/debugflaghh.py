@@ -48,6 +48,9 @@ parser.add_argument("fmt",
         help="whether the flag is a format flag (True or False)")
 parser.add_argument("components",
         help="components of a compound flag, if applicable, joined with :")
+parser.add_argument("traced", nargs="?", default="True",
+        help="whether the DPRINTFs of the flag are compiled in "
+             "(True or False)")
 
 args = parser.parse_args()
 
@@ -61,6 +64,12 @@ else:
     sys.exit(1)
 components = args.components.split(':') if args.components else []
 
+traced = args.traced.lower()
+if traced not in ('true', 'false'):
+    print(f'Unrecognized "TRACED" value {traced}', file=sys.stderr)
+    sys.exit(1)
+traced = traced == 'true'
+
 code = code_formatter()
 
 code('''
@@ -118,6 +127,14 @@ code('''
 inline constexpr const auto& ${{args.name}} = 
     ::gem5::debug::unions::${{args.name}}.${{args.name}};
 
+namespace compiled
+{
+
+// Whether the DPRINTFs guarded by this flag are compiled in.
+inline constexpr bool ${{args.name}} = ${{"true" if traced else "false"}};
+
+} // namespace compiled
+
 } // namespace debug
 } // namespace gem5
 
@@ -38,7 +38,7 @@ from common import ObjectList
 from common import HMC
 
 def create_mem_intf(intf, r, i, intlv_bits, intlv_size,
-                    xor_low_bit):
+                    xor_low_bit, channel_xor_masks=None):
     """
     Helper function for creating a single memoy controller from the given
     options.  This function is invoked multiple times in config_mem function
@@ -46,6 +46,7 @@ def create_mem_intf(intf, r, i, intlv_bits, intlv_size,
     """
 
     import math
+    from m5.util import fatal
     intlv_low_bit = int(math.log(intlv_size, 2))
 
     # Use basic hashing for the channel selection, and preferably use
@@ -92,6 +93,17 @@ def create_mem_intf(intf, r, i, intlv_bits, intlv_size,
 
             intlv_low_bit = int(math.log(buffer_size, 2))
 
+    # Explicit channel hashing functions take precedence over the
+    # interleaving bits
+    if channel_xor_masks:
+        if len(channel_xor_masks) != intlv_bits:
+            fatal("%d channel XOR masks given for %d channel bits" %
+                  (len(channel_xor_masks), intlv_bits))
+        interface.range = m5.objects.AddrRange(r.start, size = r.size(),
+                                               masks = channel_xor_masks,
+                                               intlvMatch = i)
+        return interface
+
     # We got all we need to configure the appropriate address
     # range
     interface.range = m5.objects.AddrRange(r.start, size = r.size(),
@@ -134,6 +146,9 @@ def config_mem(options, system):
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
     opt_xor_low_bit = getattr(options, "xor_low_bit", 0)
+    opt_channel_xor_masks = getattr(options, "mem_channels_xor_masks", None)
+    opt_bank_xor_masks = getattr(options, "mem_bank_xor_masks", None)
+    opt_mem_channels_quantum = getattr(options, "mem_channels_quantum", None)
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -200,7 +215,8 @@ def config_mem(options, system):
             if opt_mem_type and (not opt_nvm_type or range_iter % 2 != 0):
                 # Create the DRAM interface
                 dram_intf = create_mem_intf(intf, r, i,
-                    intlv_bits, intlv_size, opt_xor_low_bit)
+                    intlv_bits, intlv_size, opt_xor_low_bit,
+                    opt_channel_xor_masks)
 
                 # Set the number of ranks based on the command-line
                 # options if it was explicitly set
@@ -212,6 +228,10 @@ def config_mem(options, system):
                 if issubclass(intf, m5.objects.DRAMInterface):
                     dram_intf.enable_dram_powerdown = opt_dram_powerdown
 
+                if issubclass(intf, m5.objects.MemInterface) and \
+                   opt_bank_xor_masks:
+                    dram_intf.bank_xor_masks = opt_bank_xor_masks
+
                 if opt_elastic_trace_en:
                     dram_intf.latency = '1ns'
                     print("For elastic trace, over-riding Simple Memory "
@@ -224,7 +244,8 @@ def config_mem(options, system):
 
             elif opt_nvm_type and (not opt_mem_type or range_iter % 2 == 0):
                 nvm_intf = create_mem_intf(n_intf, r, i,
-                    intlv_bits, intlv_size, opt_xor_low_bit)
+                    intlv_bits, intlv_size, opt_xor_low_bit,
+                    opt_channel_xor_masks)
 
                 # Set the number of ranks based on the command-line
                 # options if it was explicitly set
@@ -246,6 +267,13 @@ def config_mem(options, system):
     for i in range(len(nvm_intfs)):
         mem_ctrls[i].nvm = nvm_intfs[i];
 
+    # Give every controller, and the interfaces it drives, an event queue
+    # of its own. The queue 0 is left to the rest of the system, and the
+    # quantum is set on the root object.
+    if opt_mem_channels_quantum:
+        for i, mem_ctrl in enumerate(mem_ctrls):
+            mem_ctrl.eventq_index = i + 1
+
     # Connect the controller to the xbar port
     for i in range(len(mem_ctrls)):
         if opt_mem_type == "HMC_2500_1x32":
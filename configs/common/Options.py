@@ -131,6 +131,20 @@ def addNoISAOptions(parser):
                         help="Enable low-power states in DRAMInterface")
     parser.add_argument("--mem-channels-intlv", type=int, default=0,
                         help="Memory channels interleave")
+    parser.add_argument("--mem-channels-xor-masks", type=lambda s: int(s, 0),
+                        nargs="+", default=None,
+                        help="Address masks selecting the memory channel, "
+                        "one per channel bit, each bit being the parity "
+                        "of the address bits in its mask")
+    parser.add_argument("--mem-bank-xor-masks", type=lambda s: int(s, 0),
+                        nargs="+", default=None,
+                        help="Address masks hashed into the bank index "
+                        "of the memory channels, one per bank bit, see "
+                        "util/dram_addr_mapping.py")
+    parser.add_argument("--mem-channels-quantum", type=int, default=None,
+                        help="Simulate every memory channel in an event "
+                        "queue and host thread of its own, synchronised "
+                        "every given number of ticks")
 
     parser.add_argument("--memchecker", action="store_true")
 
@@ -385,6 +399,10 @@ def addCommonOptions(parser):
     parser.add_argument(
         "-F", "--fast-forward", action="store", type=str, default=None,
         help="Number of instructions to fast forward before switching")
+    parser.add_argument(
+        "--warm-bp", action="store_true", default=False,
+        help="""Train the branch predictor of the switch CPUs while fast
+                forwarding on a simple CPU.""")
     parser.add_argument(
         "-S", "--simpoint", action="store_true", default=False,
         help="""Use workload simpoints as an instruction offset for
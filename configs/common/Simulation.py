@@ -488,6 +488,10 @@ def run(options, root, testsys, cpu_class):
                     options.indirect_bp_type)
                 switch_cpus[i].branchPred.indirectBranchPred = \
                     IndirectBPClass()
+            if options.warm_bp:
+                if not isinstance(testsys.cpu[i], BaseSimpleCPU):
+                    fatal("--warm-bp needs a simple CPU to fast-forward")
+                testsys.cpu[i].warmBranchPredictorFor(switch_cpus[i])
             switch_cpus[i].createThreads()
 
         # If elastic tracing is enabled attach the elastic trace probe
@@ -0,0 +1,165 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath, fatal
+from m5.stats import periodicStatDump
+
+addToPath('../')
+
+from common import ObjectList
+
+# this script runs the same traffic against the detailed memory
+# controller and DRAM interface, and against the analytical FastDRAM
+# model of the same memory, to calibrate the latency table of the
+# latter, see util/plot_dram/fast_dram_calibration.py to compare the
+# two and fit the latency scales of the FastDRAM
+
+parser = argparse.ArgumentParser()
+
+parser.add_argument("--mem-type", default="DDR3_1600_8x8",
+                    choices=ObjectList.mem_list.get_names(),
+                    help = "type of memory to use")
+
+parser.add_argument("--mem-ranks", "-r", type=int, default=1,
+                    help = "Number of ranks per channel")
+
+parser.add_argument("--addr-map",
+                    choices=ObjectList.dram_addr_map_list.get_names(),
+                    default="RoRaBaCoCh", help = "DRAM address map policy")
+
+parser.add_argument("--row-hit-scale", type=float, default=1.0,
+                    help = "FastDRAM row hit latency scale")
+parser.add_argument("--row-miss-scale", type=float, default=1.0,
+                    help = "FastDRAM closed bank latency scale")
+parser.add_argument("--row-conflict-scale", type=float, default=1.0,
+                    help = "FastDRAM row conflict latency scale")
+
+args = parser.parse_args()
+
+intf_class = ObjectList.mem_list.get(args.mem_type)
+if not issubclass(intf_class, DRAMInterface):
+    fatal("This script assumes the memory is a DRAMInterface subclass")
+
+# we are fine with 256 MB memory for now
+mem_range = AddrRange('256MB')
+
+def create_system(fast):
+    # the same 2.0 GHz crossbar as the DRAM sweep
+    system = System(membus = IOXBar(width = 32))
+    system.clk_domain = SrcClockDomain(clock = '2.0GHz',
+                                       voltage_domain =
+                                       VoltageDomain(voltage = '1V'))
+    system.mem_ranges = [mem_range]
+
+    # do not worry about reserving space for the backing store
+    system.mmap_using_noreserve = True
+
+    # there is no point slowing things down by saving any data
+    intf = intf_class(range = mem_range, null = True,
+                      ranks_per_channel = args.mem_ranks,
+                      addr_mapping = args.addr_map)
+    if fast:
+        system.mem_ctrl = FastDRAM.from_interface(
+            intf, row_hit_scale = args.row_hit_scale,
+            row_miss_scale = args.row_miss_scale,
+            row_conflict_scale = args.row_conflict_scale)
+    else:
+        system.mem_ctrl = intf.controller()
+    system.mem_ctrl.port = system.membus.mem_side_ports
+
+    system.tgen = PyTrafficGen()
+    system.tgen.port = system.membus.cpu_side_ports
+
+    # connect the system port even if it is not used in this example
+    system.system_port = system.membus.cpu_side_ports
+    return system
+
+root = Root(full_system = False,
+            detailed = create_system(False),
+            fast = create_system(True))
+root.detailed.mem_mode = 'timing'
+root.fast.mem_mode = 'timing'
+
+# the organisation of the memory, as in the DRAM sweep
+dram = root.detailed.mem_ctrl.dram
+nbr_banks = dram.banks_per_rank.value
+burst_size = int((dram.devices_per_rank.value *
+                  dram.device_bus_width.value *
+                  dram.burst_length.value) / 8)
+page_size = dram.devices_per_rank.value * dram.device_rowbuffer_size.value
+itt = getattr(dram.tBURST_MIN, 'value', dram.tBURST.value) * 1000000000000
+
+# stay in each phase for 0.1 ms, long enough to see a few refreshes,
+# and dump and reset the stats of both systems at the end of it
+period = 100000000
+periodicStatDump(period)
+
+m5.instantiate()
+
+addr_map = ObjectList.dram_addr_map_list.get(args.addr_map)
+
+# the phases cover row hits, closed banks and row conflicts, with a
+# varying share of writes, and both at the peak bandwidth of the
+# memory and at a quarter of it
+phases = []
+for rd_perc in (100, 70):
+    for rate in (1, 4):
+        phases.append(("linear", rd_perc, rate, 0, 0))
+        phases.append(("random", rd_perc, rate, 0, 0))
+        for stride in (burst_size, page_size // 2):
+            for banks in (1, nbr_banks):
+                phases.append(("dram", rd_perc, rate, stride, banks))
+
+def trace(tgen):
+    for mode, rd_perc, rate, stride, banks in phases:
+        min_itt = int(itt * rate)
+        max_itt = min_itt
+        if mode == "linear":
+            yield tgen.createLinear(period, 0, mem_range.end, burst_size,
+                                    min_itt, max_itt, rd_perc, 0)
+        elif mode == "random":
+            yield tgen.createRandom(period, 0, mem_range.end, burst_size,
+                                    min_itt, max_itt, rd_perc, 0)
+        else:
+            num_seq_pkts = max(1, stride // burst_size)
+            yield tgen.createDram(period, 0, mem_range.end, burst_size,
+                                  min_itt, max_itt, rd_perc, 0,
+                                  num_seq_pkts, page_size, nbr_banks, banks,
+                                  addr_map, args.mem_ranks)
+    yield tgen.createExit(0)
+
+for i, (mode, rd_perc, rate, stride, banks) in enumerate(phases):
+    print("Phase %d: %s, read %d%%, period %d bursts, stride %d, banks %d" %
+          (i, mode, rd_perc, rate, stride, banks))
+
+print("FastDRAM scales: hit %f, miss %f, conflict %f" %
+      (args.row_hit_scale, args.row_miss_scale, args.row_conflict_scale))
+
+root.detailed.tgen.start(trace(root.detailed.tgen))
+root.fast.tgen.start(trace(root.fast.tgen))
+
+m5.simulate()
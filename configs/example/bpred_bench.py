@@ -0,0 +1,63 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replay a branch trace through a branch predictor and report its accuracy
+# and host speed, e.g.:
+#
+#   gem5.opt configs/example/bpred_bench.py --bp-type=LTAGE trace.txt
+#
+# See src/cpu/testers/branch_trace/branch_trace_tester.hh for the trace
+# format.
+
+import argparse
+
+import m5
+from m5.objects import *
+from m5.util import addToPath
+
+addToPath('../')
+
+from common import ObjectList
+
+parser = argparse.ArgumentParser()
+parser.add_argument("trace", help="Branch trace to replay")
+parser.add_argument("--bp-type", default="TournamentBP",
+                    choices=ObjectList.bp_list.get_names(),
+                    help="Branch predictor to exercise")
+parser.add_argument("--max-branches", type=int, default=0,
+                    help="Number of branches to read from the trace "
+                         "(0: all)")
+parser.add_argument("--repeat", type=int, default=1,
+                    help="Number of times to replay the trace")
+args = parser.parse_args()
+
+tester = BranchTraceTester(trace_file=args.trace,
+                           max_branches=args.max_branches,
+                           repeat=args.repeat)
+tester.predictor = ObjectList.bp_list.get(args.bp_type)()
+
+root = Root(full_system=False, tester=tester)
+m5.instantiate()
+
+exit_event = m5.simulate()
+print('Exiting @ tick', m5.curTick(), 'because', exit_event.getCause())
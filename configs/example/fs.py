@@ -345,6 +345,9 @@ else:
     print("Error I don't know how to create more than 2 systems.")
     sys.exit(1)
 
+if args.mem_channels_quantum:
+    root.sim_quantum = args.mem_channels_quantum
+
 if ObjectList.is_kvm_cpu(TestCPUClass) or \
     ObjectList.is_kvm_cpu(FutureClass):
     # Required for running kvm on multiple host cores.
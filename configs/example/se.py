@@ -272,4 +272,8 @@ if args.wait_gdb:
     system.workload.wait_for_remote_gdb = True
 
 root = Root(full_system = False, system = system)
+
+if args.mem_channels_quantum:
+    root.sim_quantum = args.mem_channels_quantum
+
 Simulation.run(args, root, system, FutureClass)
@@ -144,6 +144,12 @@ class Decoder : public InstDecoder
 
     StaticInstPtr decode(PCStateBase &pc) override;
 
+    void
+    invalidate(Addr addr, Addr size) override
+    {
+        defaultCache.invalidate(addr, size);
+    }
+
   public: // ARM-specific decoder state manipulation
     void
     setContext(FPSCR fpscr)
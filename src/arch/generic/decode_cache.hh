@@ -64,16 +64,26 @@ class BasicDecodeCache
 
         entry.machInst = mach_inst;
 
-        auto iter = instMap.find(mach_inst);
-        if (iter != instMap.end()) {
-            entry.inst = iter->second;
+        entry.inst = instMap.find(mach_inst);
+        if (entry.inst)
             return entry.inst;
-        }
 
         entry.inst = decoder->decodeInst(mach_inst);
-        instMap[mach_inst] = entry.inst;
+        instMap.insert(mach_inst, entry.inst);
         return entry.inst;
     }
+
+    /// Forget the instructions decoded from [addr, addr + size).
+    /// @param addr The first byte which was written.
+    /// @param size The number of bytes which were written.
+    void
+    invalidate(Addr addr, Addr size)
+    {
+        // An instruction which starts before addr may still overlap it.
+        Addr lead = sizeof(EMI) - 1;
+        Addr start = addr > lead ? addr - lead : 0;
+        decodePages.invalidate(start, size + (addr - start));
+    }
 };
 
 } // namespace GenericISA
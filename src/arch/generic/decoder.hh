@@ -92,6 +92,19 @@ class InstDecoder : public SimObject
         outOfBytes = old->outOfBytes;
     }
 
+    /**
+     * Drop any cached decodings of the bytes in [addr, addr + size).
+     *
+     * CPU models call this when a store writes memory which might hold
+     * code. Cached decodings are checked against the fetched bytes
+     * anyway, so this only releases stale entries early; decoders
+     * without an address indexed cache don't need to implement it.
+     *
+     * @param addr Virtual address of the first byte written.
+     * @param size Number of bytes written.
+     */
+    virtual void invalidate(Addr addr, Addr size) {}
+
     void *moreBytesPtr() const { return _moreBytesPtr; }
     size_t moreBytesSize() const { return _moreBytesSize; }
     Addr pcMask() const { return _pcMask; }
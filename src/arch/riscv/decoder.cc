@@ -85,9 +85,11 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     DPRINTF(Decode, "Decoding instruction 0x%08x at address %#x\n",
             mach_inst, addr);
 
-    StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
+    StaticInstPtr si = instMap.find(mach_inst);
+    if (!si) {
         si = decodeInst(mach_inst);
+        instMap.insert(mach_inst, si);
+    }
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
             si->getName(), mach_inst);
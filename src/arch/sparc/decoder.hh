@@ -109,6 +109,12 @@ class Decoder : public InstDecoder
         instDone = false;
         return decode(emi, next_pc.instAddr());
     }
+
+    void
+    invalidate(Addr addr, Addr size) override
+    {
+        defaultCache.invalidate(addr, size);
+    }
 };
 
 } // namespace SparcISA
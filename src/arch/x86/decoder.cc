@@ -677,14 +677,10 @@ Decoder::InstCacheMap Decoder::instCacheMap;
 StaticInstPtr
 Decoder::decode(ExtMachInst mach_inst, Addr addr)
 {
-    StaticInstPtr si;
-
-    auto iter = instMap->find(mach_inst);
-    if (iter != instMap->end()) {
-        si = iter->second;
-    } else {
+    StaticInstPtr si = instMap->find(mach_inst);
+    if (!si) {
         si = decodeInst(mach_inst);
-        (*instMap)[mach_inst] = si;
+        instMap->insert(mach_inst, si);
     }
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
@@ -692,6 +688,30 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     return si;
 }
 
+void
+Decoder::invalidate(Addr addr, Addr size)
+{
+    // The longest legal x86 instruction is 15 bytes, so anything which
+    // starts up to 14 bytes before addr might overlap the write.
+    const Addr lead = 14;
+    Addr start = addr > lead ? addr - lead : 0;
+    Addr len = size + (addr - start);
+
+    // The state machine holds on to the entry it's filling in or checking
+    // until decode() hands the instruction out, so keep that one intact.
+    bool busy = (state != ResetState || instDone) &&
+        origPC < start + len && start < origPC + lead + 1;
+    InstBytes in_flight;
+    if (busy)
+        in_flight = *instBytes;
+
+    for (auto &cache: addrCacheMap)
+        cache.second->invalidate(start, len);
+
+    if (busy)
+        *instBytes = std::move(in_flight);
+}
+
 StaticInstPtr
 Decoder::decode(PCStateBase &next_pc)
 {
@@ -353,6 +353,8 @@ class Decoder : public InstDecoder
   public:
     StaticInstPtr decode(PCStateBase &next_pc) override;
 
+    void invalidate(Addr addr, Addr size) override;
+
     StaticInstPtr fetchRomMicroop(
             MicroPC micropc, StaticInstPtr curMacroop) override;
 };
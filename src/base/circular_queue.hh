@@ -73,7 +73,7 @@ class CircularQueue
 
     using reference = typename std::vector<T>::reference;
     using const_reference = typename std::vector<T>::const_reference;
-    const size_t _capacity;
+    size_t _capacity;
     size_t _size = 0;
     size_t _head = 1;
 
@@ -426,6 +426,26 @@ class CircularQueue
         _size = 0;
     }
 
+    /**
+     * Grow the backing store to hold at least the given number of
+     * elements. The elements keep their indices, so iterators to them
+     * remain valid.
+     *
+     * @param size Minimum capacity of the queue.
+     */
+    void
+    reserve(size_t size)
+    {
+        if (size <= _capacity)
+            return;
+
+        std::vector<T> new_data(size);
+        for (size_t idx = _head; idx < _head + _size; idx++)
+            new_data[idx % size] = std::move(data[idx % _capacity]);
+        data = std::move(new_data);
+        _capacity = size;
+    }
+
     /**
      * Test if the index is in the range of valid elements.
      */
@@ -265,3 +265,39 @@ TEST(CircularQueueTest, MultipleRound)
 
     ASSERT_EQ(ending_it - starting_it, cq_size);
 }
+
+/** Growing the queue keeps the elements and the iterators
+ * pointing to them valid, even once the queue has wrapped around */
+TEST(CircularQueueTest, Reserve)
+{
+    const auto cq_size = 8;
+    CircularQueue<uint32_t> cq(cq_size);
+
+    for (auto idx = 0; idx < cq_size + 3; idx++) {
+        cq.push_back(idx);
+    }
+
+    auto it = cq.begin() + 2;
+    ASSERT_EQ(*it, 5);
+
+    cq.reserve(cq_size * 2);
+    ASSERT_EQ(cq.capacity(), cq_size * 2);
+    ASSERT_EQ(cq.size(), cq_size);
+    ASSERT_EQ(*it, 5);
+
+    uint32_t expected = 3;
+    for (auto val : cq) {
+        ASSERT_EQ(val, expected++);
+    }
+
+    // Shrinking is not supported
+    cq.reserve(cq_size);
+    ASSERT_EQ(cq.capacity(), cq_size * 2);
+
+    for (auto idx = 0; idx < cq_size; idx++) {
+        cq.push_back(idx);
+    }
+    ASSERT_TRUE(cq.full());
+    ASSERT_EQ(cq.front(), 3);
+    ASSERT_EQ(*it, 5);
+}
@@ -1951,6 +1951,37 @@ class Scalar : public ScalarBase<Scalar, StatStor>
     }
 };
 
+/**
+ * A scalar counter that can be updated from the threads of a
+ * multi-eventq simulation without synchronisation. Each thread
+ * accumulates into a private shard and the shards are merged when the
+ * stat is prepared for dumping.
+ * @sa Stat, ScalarBase, ShardedStatStor
+ */
+class ShardedScalar : public ScalarBase<ShardedScalar, ShardedStatStor>
+{
+  public:
+    using ScalarBase<ShardedScalar, ShardedStatStor>::operator=;
+
+    ShardedScalar(Group *parent = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedScalar(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : ScalarBase<ShardedScalar, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A stat that calculates the per tick average of a value.
  * @sa Stat, ScalarBase, AvgStor
@@ -2025,6 +2056,32 @@ class Vector : public VectorBase<Vector, StatStor>
     }
 };
 
+/**
+ * A vector of sharded scalar stats.
+ * @sa Stat, VectorBase, ShardedStatStor
+ */
+class ShardedVector : public VectorBase<ShardedVector, ShardedStatStor>
+{
+  public:
+    ShardedVector(Group *parent = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedVector(Group *parent, const char *name, const units::Base *unit,
+                  const char *desc = nullptr)
+        : VectorBase<ShardedVector, ShardedStatStor>(parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A vector of Average stats.
  * @sa Stat, VectorBase, AvgStor
@@ -2077,6 +2134,34 @@ class Vector2d : public Vector2dBase<Vector2d, StatStor>
     }
 };
 
+/**
+ * A 2-Dimensional vector of sharded scalar stats.
+ * @sa Stat, Vector2dBase, ShardedStatStor
+ */
+class ShardedVector2d : public Vector2dBase<ShardedVector2d, ShardedStatStor>
+{
+  public:
+    ShardedVector2d(Group *parent = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, nullptr, units::Unspecified::get(), nullptr)
+    {
+    }
+
+    ShardedVector2d(Group *parent, const char *name,
+                    const char *desc = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, name, units::Unspecified::get(), desc)
+    {
+    }
+
+    ShardedVector2d(Group *parent, const char *name,
+                    const units::Base *unit, const char *desc = nullptr)
+        : Vector2dBase<ShardedVector2d, ShardedStatStor>(
+                parent, name, unit, desc)
+    {
+    }
+};
+
 /**
  * A simple distribution stat.
  * @sa Stat, DistBase, DistStor
@@ -2700,6 +2785,14 @@ class Temp
         : node(new ScalarStatNode(s.info()))
     { }
 
+    /**
+     * Create a new ScalarStatNode.
+     * @param s The ScalarStat to place in a node.
+     */
+    Temp(const ShardedScalar &s)
+        : node(new ScalarStatNode(s.info()))
+    { }
+
     /**
      * Create a new VectorStatNode.
      * @param s The VectorStat to place in a node.
@@ -2712,6 +2805,14 @@ class Temp
         : node(new VectorStatNode(s.info()))
     { }
 
+    /**
+     * Create a new VectorStatNode.
+     * @param s The VectorStat to place in a node.
+     */
+    Temp(const ShardedVector &s)
+        : node(new VectorStatNode(s.info()))
+    { }
+
     /**
      *
      */
@@ -42,6 +42,8 @@
 #include "base/stats/storage.hh"
 
 #include <cmath>
+#include <mutex>
+#include <vector>
 
 namespace gem5
 {
@@ -50,6 +52,52 @@ GEM5_DEPRECATED_NAMESPACE(Stats, statistics);
 namespace statistics
 {
 
+__thread int _curStatShard = 0;
+
+void
+curStatShard(int shard)
+{
+    fatal_if(shard < 0 || shard >= MaxStatShards,
+            "Stat shard %d is out of range, at most %d threads can update "
+            "sharded stats.", shard, MaxStatShards);
+    _curStatShard = shard;
+}
+
+StatShardBlock statShardBlocks[MaxStatShards];
+
+namespace
+{
+
+std::mutex statShardSlotMutex;
+size_t statShardSlots = 0;
+std::vector<size_t> freeStatShardSlots;
+
+} // anonymous namespace
+
+size_t
+allocStatShardSlot()
+{
+    std::lock_guard<std::mutex> lock(statShardSlotMutex);
+    if (freeStatShardSlots.empty())
+        return statShardSlots++;
+    const size_t slot = freeStatShardSlots.back();
+    freeStatShardSlots.pop_back();
+    return slot;
+}
+
+void
+freeStatShardSlot(size_t slot)
+{
+    std::lock_guard<std::mutex> lock(statShardSlotMutex);
+    freeStatShardSlots.push_back(slot);
+}
+
+size_t
+numStatShardSlots()
+{
+    return statShardSlots;
+}
+
 void
 DistStor::sample(Counter val, int number)
 {
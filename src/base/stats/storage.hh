@@ -32,6 +32,8 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <vector>
 
 #include "base/cast.hh"
 #include "base/compiler.hh"
@@ -117,6 +119,174 @@ class StatStor
     bool zero() const { return data == Counter(); }
 };
 
+/** The maximum number of host threads that can update a sharded stat. */
+const int MaxStatShards = 64;
+
+/** The stat shard owned by the running host thread. */
+extern __thread int _curStatShard;
+
+inline int curStatShard() { return _curStatShard; }
+
+/**
+ * Set the stat shard that the running host thread updates. Each thread
+ * servicing a main event queue must own a distinct shard.
+ * @param shard The index of the shard, usually the event queue index.
+ */
+void curStatShard(int shard);
+
+/**
+ * The values of the sharded stats updated by one host thread, indexed by
+ * the slot of each stat. A block is only ever written by the thread
+ * owning its shard, and is cache line aligned so that the threads do not
+ * false share the blocks.
+ */
+struct alignas(64) StatShardBlock
+{
+    std::vector<Counter> values;
+};
+
+/** The blocks of all of the shards. */
+extern StatShardBlock statShardBlocks[MaxStatShards];
+
+/**
+ * Allocate the slot of a sharded stat in the blocks. Slots are allocated
+ * and freed from serial context only.
+ * @return The index of the slot.
+ */
+size_t allocStatShardSlot();
+
+/**
+ * Release the slot of a sharded stat for reuse.
+ * @param slot The index of the slot.
+ */
+void freeStatShardSlot(size_t slot);
+
+/** @return The number of slots allocated so far. */
+size_t numStatShardSlots();
+
+/**
+ * Storage for a scalar stat that may be updated concurrently from the
+ * threads of a multi-eventq simulation. Every thread accumulates into its
+ * own shard, so updates need neither locks nor atomics. The shards are
+ * only read and merged from serial context, i.e., when preparing, dumping
+ * or resetting stats while all simulation threads are on a barrier.
+ *
+ * The stat itself only holds the index of its slot, the values live in
+ * the block of each shard, so a stat costs a counter per thread that
+ * actually updates sharded stats.
+ */
+class ShardedStatStor
+{
+  private:
+    /** The index of the stat in the blocks of the shards. */
+    const size_t slot;
+
+    /**
+     * Get the value of the stat in a shard, growing the block of the
+     * shard if needed. Only the owner of the shard, or serial context,
+     * may call this.
+     * @param shard The index of the shard.
+     * @return The value in the shard.
+     */
+    Counter &
+    shardValue(int shard)
+    {
+        auto &values = statShardBlocks[shard].values;
+        if (slot >= values.size())
+            values.resize(numStatShardSlots());
+        return values[slot];
+    }
+
+  public:
+    struct Params : public StorageParams {};
+
+    ShardedStatStor(const StorageParams* const storage_params)
+        : slot(allocStatShardSlot())
+    {
+        reset(storage_params);
+    }
+
+    ~ShardedStatStor() { freeStatShardSlot(slot); }
+
+    ShardedStatStor(const ShardedStatStor &) = delete;
+    ShardedStatStor &operator=(const ShardedStatStor &) = delete;
+
+    /**
+     * Set the stat to the given value. Must be called from serial context.
+     * @param val The new value.
+     */
+    void
+    set(Counter val)
+    {
+        reset(nullptr);
+        shardValue(0) = val;
+    }
+
+    /**
+     * Increment the shard of the running thread by the given value.
+     * @param val The new value.
+     */
+    void inc(Counter val) { shardValue(curStatShard()) += val; }
+
+    /**
+     * Decrement the shard of the running thread by the given value.
+     * @param val The new value.
+     */
+    void dec(Counter val) { shardValue(curStatShard()) -= val; }
+
+    /**
+     * Return the value of this stat as its base type, i.e., the sum of
+     * all of the shards.
+     * @return The value of this stat.
+     */
+    Counter
+    value() const
+    {
+        Counter total = Counter();
+        for (int i = 0; i < MaxStatShards; ++i) {
+            const auto &values = statShardBlocks[i].values;
+            if (slot < values.size())
+                total += values[slot];
+        }
+        return total;
+    }
+
+    /**
+     * Return the value of this stat as a result type.
+     * @return The value of this stat.
+     */
+    Result result() const { return (Result)value(); }
+
+    /**
+     * Fold all of the shards into the first one.
+     */
+    void
+    prepare(const StorageParams* const storage_params)
+    {
+        const Counter total = value();
+        reset(storage_params);
+        shardValue(0) = total;
+    }
+
+    /**
+     * Reset stat value to default
+     */
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        for (int i = 0; i < MaxStatShards; ++i) {
+            auto &values = statShardBlocks[i].values;
+            if (slot < values.size())
+                values[slot] = Counter();
+        }
+    }
+
+    /**
+     * @return true if zero value
+     */
+    bool zero() const { return value() == Counter(); }
+};
+
 /**
  * Templatized storage and interface to a per-tick average stat. This keeps
  * a current count and updates a total (count * ticks) when this count
@@ -30,6 +30,8 @@
 #include <gtest/gtest.h>
 
 #include <cmath>
+#include <thread>
+#include <vector>
 
 #include "base/gtest/cur_tick_fake.hh"
 #include "base/gtest/logging.hh"
@@ -129,6 +131,96 @@ TEST(StatsStatStorTest, ZeroReset)
     ASSERT_FALSE(stor.zero());
 }
 
+/** Test setting and getting a value to the sharded storage. */
+TEST(StatsShardedStatStorTest, SetValueResult)
+{
+    statistics::ShardedStatStor stor(nullptr);
+
+    stor.inc(5);
+    stor.set(10);
+    ASSERT_EQ(stor.value(), 10);
+    ASSERT_EQ(stor.result(), statistics::Result(10));
+}
+
+/** Test that updates to different shards are summed and merged. */
+TEST(StatsShardedStatStorTest, IncDecPrepare)
+{
+    statistics::ShardedStatStor stor(nullptr);
+
+    stor.inc(10);
+    statistics::curStatShard(3);
+    stor.inc(7);
+    stor.dec(2);
+    statistics::curStatShard(0);
+    ASSERT_EQ(stor.value(), 15);
+
+    stor.prepare(nullptr);
+    ASSERT_EQ(stor.value(), 15);
+    stor.inc(1);
+    ASSERT_EQ(stor.value(), 16);
+}
+
+/** Test concurrent updates from several threads, each on its own shard. */
+TEST(StatsShardedStatStorTest, Threads)
+{
+    statistics::ShardedStatStor stor(nullptr);
+    const int num_threads = 4;
+    const int num_incs = 10000;
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < num_threads; i++) {
+        threads.emplace_back([&stor, i]() {
+            statistics::curStatShard(i);
+            for (int j = 0; j < num_incs; j++)
+                stor.inc(1);
+        });
+    }
+    for (auto &t : threads)
+        t.join();
+
+    ASSERT_EQ(stor.value(), num_threads * num_incs);
+}
+
+/** Test that the sharded storage is zero on creation and after a reset. */
+TEST(StatsShardedStatStorTest, ZeroReset)
+{
+    statistics::ShardedStatStor stor(nullptr);
+    ASSERT_TRUE(stor.zero());
+
+    statistics::curStatShard(1);
+    stor.inc(10);
+    statistics::curStatShard(0);
+    ASSERT_FALSE(stor.zero());
+
+    stor.reset(nullptr);
+    ASSERT_TRUE(stor.zero());
+}
+
+/** Test that the slot of a destroyed stat is reused from zero. */
+TEST(StatsShardedStatStorTest, SlotReuse)
+{
+    auto *stor = new statistics::ShardedStatStor(nullptr);
+    statistics::curStatShard(2);
+    stor->inc(10);
+    statistics::curStatShard(0);
+    stor->inc(5);
+    delete stor;
+
+    statistics::ShardedStatStor reused(nullptr);
+    ASSERT_TRUE(reused.zero());
+    reused.inc(1);
+    ASSERT_EQ(reused.value(), 1);
+}
+
+/** Test that out of range shards are rejected. */
+TEST(StatsShardedStatStorTest, ShardOutOfRange)
+{
+    gtestLogOutput.str("");
+    EXPECT_ANY_THROW(statistics::curStatShard(statistics::MaxStatShards));
+    ASSERT_NE(gtestLogOutput.str().find("is out of range"),
+        std::string::npos);
+}
+
 /** Test setting and getting a value to the storage. */
 TEST(StatsAvgStorTest, SetValueResult)
 {
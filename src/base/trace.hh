@@ -177,28 +177,39 @@ struct StringWrap
  * @{
  */
 
+/**
+ * Whether the DPRINTFs of debug flag x are compiled in. Builds using a
+ * TRACE_FLAGS_ALLOWLIST only keep the DPRINTFs of the listed flags, all
+ * the other ones are eliminated at compile time.
+ *
+ * This only applies to the macros below. Code guarded by a plain
+ * "if (debug::x)" check is still compiled in and tested at run time, it
+ * must also test TRACE_COMPILED(x) to be eliminated.
+ */
+#define TRACE_COMPILED(x) (TRACING_ON && ::gem5::debug::compiled::x)
+
 #define DDUMP(x, data, count) do {               \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x))     \
+    if (GEM5_UNLIKELY(TRACE_COMPILED(x) && ::gem5::debug::x)) \
         ::gem5::Trace::getDebugLogger()->dump(           \
             ::gem5::curTick(), name(), data, count, #x); \
 } while (0)
 
 #define DPRINTF(x, ...) do {                     \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {   \
+    if (GEM5_UNLIKELY(TRACE_COMPILED(x) && ::gem5::debug::x)) { \
         ::gem5::Trace::getDebugLogger()->dprintf_flag(   \
             ::gem5::curTick(), name(), #x, __VA_ARGS__); \
     }                                            \
 } while (0)
 
 #define DPRINTFS(x, s, ...) do {                        \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {          \
+    if (GEM5_UNLIKELY(TRACE_COMPILED(x) && ::gem5::debug::x)) {   \
         ::gem5::Trace::getDebugLogger()->dprintf_flag(          \
                 ::gem5::curTick(), (s)->name(), #x, __VA_ARGS__); \
     }                                                   \
 } while (0)
 
 #define DPRINTFR(x, ...) do {                          \
-    if (GEM5_UNLIKELY(TRACING_ON && ::gem5::debug::x)) {         \
+    if (GEM5_UNLIKELY(TRACE_COMPILED(x) && ::gem5::debug::x)) {    \
         ::gem5::Trace::getDebugLogger()->dprintf_flag(         \
             (::gem5::Tick)-1, std::string(), #x, __VA_ARGS__); \
     }                                                  \
@@ -0,0 +1,188 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/work_stealing_pool.hh"
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+WorkStealingPool::WorkStealingPool(unsigned num_participants,
+                                   const ThreadInit &thread_init)
+    : ranges(num_participants), curTask(nullptr), generation(0), busy(0),
+      terminate(false)
+{
+    fatal_if(num_participants == 0,
+             "A work stealing pool needs at least one participant.");
+
+    for (auto &range : ranges)
+        range.bounds = pack(0, 0);
+
+    threads.reserve(num_participants - 1);
+    for (unsigned i = 1; i < num_participants; ++i)
+        threads.emplace_back(&WorkStealingPool::threadMain, this, i,
+                             thread_init);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        terminate = true;
+    }
+    startCond.notify_all();
+
+    for (auto &t : threads)
+        t.join();
+}
+
+bool
+WorkStealingPool::takeFront(Range &range, size_t &task)
+{
+    uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+    while (true) {
+        const uint32_t begin = bounds;
+        const uint32_t end = bounds >> 32;
+        if (begin >= end)
+            return false;
+        if (range.bounds.compare_exchange_weak(bounds, pack(begin + 1, end),
+                                               std::memory_order_relaxed)) {
+            task = begin;
+            return true;
+        }
+    }
+}
+
+bool
+WorkStealingPool::takeBack(Range &range, size_t &task)
+{
+    uint64_t bounds = range.bounds.load(std::memory_order_relaxed);
+    while (true) {
+        const uint32_t begin = bounds;
+        const uint32_t end = bounds >> 32;
+        if (begin >= end)
+            return false;
+        if (range.bounds.compare_exchange_weak(bounds, pack(begin, end - 1),
+                                               std::memory_order_relaxed)) {
+            task = end - 1;
+            return true;
+        }
+    }
+}
+
+void
+WorkStealingPool::work(unsigned participant)
+{
+    const Task &task = *curTask;
+    const unsigned num_ranges = ranges.size();
+    size_t idx;
+
+    while (takeFront(ranges[participant], idx))
+        task(idx);
+
+    // Our own range is exhausted, steal from the others until all of
+    // them are empty.
+    bool found = true;
+    while (found) {
+        found = false;
+        for (unsigned i = 1; i < num_ranges; ++i) {
+            Range &victim = ranges[(participant + i) % num_ranges];
+            if (takeBack(victim, idx)) {
+                task(idx);
+                found = true;
+            }
+        }
+    }
+}
+
+void
+WorkStealingPool::threadMain(unsigned participant, ThreadInit thread_init)
+{
+    if (thread_init)
+        thread_init(participant);
+
+    uint64_t seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCond.wait(lock, [&]() {
+                return terminate || generation != seen;
+            });
+            if (terminate)
+                return;
+            seen = generation;
+        }
+
+        work(participant);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)
+                doneCond.notify_one();
+        }
+    }
+}
+
+void
+WorkStealingPool::run(size_t num_tasks, const Task &task)
+{
+    fatal_if(num_tasks > UINT32_MAX,
+             "Too many tasks (%d) for a work stealing batch.", num_tasks);
+
+    if (num_tasks == 0)
+        return;
+
+    // Not worth waking up the helpers for a single task.
+    if (threads.empty() || num_tasks == 1) {
+        for (size_t i = 0; i < num_tasks; ++i)
+            task(i);
+        return;
+    }
+
+    const unsigned num_ranges = ranges.size();
+    for (unsigned i = 0; i < num_ranges; ++i) {
+        ranges[i].bounds.store(pack(num_tasks * i / num_ranges,
+                                    num_tasks * (i + 1) / num_ranges),
+                               std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        curTask = &task;
+        busy = threads.size();
+        ++generation;
+    }
+    startCond.notify_all();
+
+    work(0);
+
+    // The helpers may still be running the last tasks they claimed.
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCond.wait(lock, [this]() { return busy == 0; });
+    curTask = nullptr;
+}
+
+} // namespace gem5
@@ -0,0 +1,126 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_WORK_STEALING_POOL_HH__
+#define __BASE_WORK_STEALING_POOL_HH__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * A pool of host threads that cooperatively run batches of independent
+ * tasks. The tasks of a batch are split into contiguous ranges, one per
+ * participant. Each participant runs the tasks of its own range from the
+ * front and, once that range is empty, steals tasks from the back of the
+ * ranges of the other participants.
+ *
+ * The thread calling run() takes part in the batch as participant 0, so a
+ * pool of N participants only creates N - 1 helper threads.
+ */
+class WorkStealingPool
+{
+  public:
+    typedef std::function<void(size_t)> Task;
+    typedef std::function<void(unsigned)> ThreadInit;
+
+    /**
+     * @param num_participants Number of threads running a batch,
+     *        including the one calling run().
+     * @param thread_init Optional callback run by each helper thread
+     *        when it starts, with the participant index of the thread.
+     */
+    WorkStealingPool(unsigned num_participants,
+                     const ThreadInit &thread_init=nullptr);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool &) = delete;
+    WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+    /** Number of threads running a batch, including the caller. */
+    unsigned size() const { return ranges.size(); }
+
+    /**
+     * Run task(i) for every i in [0, num_tasks) and return once all of
+     * them have completed. The order in which the tasks run is not
+     * defined. Must not be called concurrently from several threads.
+     */
+    void run(size_t num_tasks, const Task &task);
+
+  private:
+    /**
+     * The remaining tasks of a participant, packed as [begin, end) in a
+     * single word so that the owner and the thieves can claim tasks with
+     * a single compare and swap. Padded to avoid false sharing.
+     */
+    struct alignas(64) Range
+    {
+        std::atomic<uint64_t> bounds;
+    };
+
+    static uint64_t
+    pack(uint32_t begin, uint32_t end)
+    {
+        return (uint64_t(end) << 32) | begin;
+    }
+
+    /** Claim the first task of a range, returns false if it is empty. */
+    static bool takeFront(Range &range, size_t &task);
+    /** Claim the last task of a range, returns false if it is empty. */
+    static bool takeBack(Range &range, size_t &task);
+
+    /** Run tasks until no participant has any left. */
+    void work(unsigned participant);
+
+    void threadMain(unsigned participant, ThreadInit thread_init);
+
+    std::vector<Range> ranges;
+    std::vector<std::thread> threads;
+
+    /** The task of the batch being run. */
+    const Task *curTask;
+
+    std::mutex mutex;
+    std::condition_variable startCond;
+    std::condition_variable doneCond;
+    /** Incremented every time a batch starts. */
+    uint64_t generation;
+    /** Number of helper threads still working on the current batch. */
+    unsigned busy;
+    bool terminate;
+};
+
+} // namespace gem5
+
+#endif // __BASE_WORK_STEALING_POOL_HH__
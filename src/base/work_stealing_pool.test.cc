@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/work_stealing_pool.hh"
+
+using namespace gem5;
+
+/** Every task of a batch must run exactly once. */
+TEST(WorkStealingPool, RunsEveryTaskOnce)
+{
+    WorkStealingPool pool(4);
+    const size_t num_tasks = 1000;
+    std::vector<std::atomic<int>> count(num_tasks);
+    for (auto &c : count)
+        c = 0;
+
+    pool.run(num_tasks, [&count](size_t i) { count[i]++; });
+
+    for (size_t i = 0; i < num_tasks; i++)
+        ASSERT_EQ(count[i], 1);
+}
+
+/** Several batches can be run back to back on the same pool. */
+TEST(WorkStealingPool, RepeatedBatches)
+{
+    WorkStealingPool pool(3);
+    std::atomic<size_t> sum(0);
+
+    for (size_t n = 0; n < 50; n++)
+        pool.run(n, [&sum](size_t i) { sum += i + 1; });
+
+    size_t expected = 0;
+    for (size_t n = 0; n < 50; n++)
+        expected += n * (n + 1) / 2;
+    ASSERT_EQ(sum, expected);
+}
+
+/** Tasks of a busy participant are stolen by the idle ones. */
+TEST(WorkStealingPool, Steal)
+{
+    WorkStealingPool pool(2);
+    std::mutex m;
+    std::set<std::thread::id> ids;
+
+    // Task 0 belongs to the caller and blocks until the other
+    // participant has run every other task, including the ones of the
+    // caller's range.
+    std::atomic<int> done(0);
+    const size_t num_tasks = 8;
+    pool.run(num_tasks, [&](size_t i) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            ids.insert(std::this_thread::get_id());
+        }
+        if (i == 0) {
+            while (done != num_tasks - 1)
+                std::this_thread::yield();
+        } else {
+            done++;
+        }
+    });
+
+    ASSERT_EQ(done, num_tasks - 1);
+    ASSERT_EQ(ids.size(), 2);
+}
+
+/** The thread init callback is run by each helper thread. */
+TEST(WorkStealingPool, ThreadInit)
+{
+    std::atomic<unsigned> mask(0);
+    {
+        WorkStealingPool pool(4, [&mask](unsigned p) { mask |= 1 << p; });
+        ASSERT_EQ(pool.size(), 4);
+        pool.run(16, [](size_t i) {});
+    }
+    ASSERT_EQ(mask, 0xe);
+}
@@ -0,0 +1,89 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.SimObject import *
+from m5.params import *
+
+class SamplingController(SimObject):
+    """SMARTS style sampling: each period of `period` instructions runs
+    functional warming on `functional_cpus`, then `detailed_warmup` and
+    `measurement` instructions on `detailed_cpus`. The functional CPUs
+    must be active and the detailed ones switched out when simulation
+    starts, unless the period has no functional warming. Use run() to
+    drive the simulation, and warmBranchPredictorFor() on the functional
+    CPUs to keep the detailed CPUs' branch predictors warm too."""
+
+    type = 'SamplingController'
+    cxx_header = "cpu/sampling_controller.hh"
+    cxx_class = 'gem5::SamplingController'
+
+    cxx_exports = [
+        PyBindMethod("startDetailed"),
+        PyBindMethod("startFunctional"),
+        PyBindMethod("done"),
+        PyBindMethod("numSamples"),
+    ]
+
+    functional_cpus = VectorParam.BaseCPU([],
+        "CPUs used for functional warming, e.g. atomic CPUs")
+    detailed_cpus = VectorParam.BaseCPU("CPUs used for detailed windows")
+
+    period = Param.Counter("Instructions between the starts of samples")
+    detailed_warmup = Param.Counter(2000,
+        "Instructions of detailed warming before each measurement")
+    measurement = Param.Counter(1000,
+        "Instructions in each measurement window")
+
+    min_samples = Param.Counter(30,
+        "Samples to take before checking the confidence interval")
+    max_samples = Param.Counter(0, "Stop after this many samples (0: never)")
+    z_score = Param.Float(3.0,
+        "Z score of the confidence interval (3.0 is 99.7%)")
+    target_error = Param.Float(0.03,
+        "Stop once the confidence interval half width relative to the "
+        "mean IPC is below this (0: never)")
+
+    def run(self, system, max_ticks=None):
+        """Simulate until the workload exits or enough samples have been
+        taken, switching CPUs at the window boundaries. Returns the exit
+        event which ended the run."""
+        import m5
+
+        to_detailed = list(zip(self.functional_cpus, self.detailed_cpus))
+        to_functional = list(zip(self.detailed_cpus, self.functional_cpus))
+
+        while True:
+            if max_ticks is None:
+                event = m5.simulate()
+            else:
+                event = m5.simulate(max_ticks - m5.curTick())
+            cause = event.getCause()
+
+            if cause == "sampling: switch to detailed":
+                m5.switchCpus(system, to_detailed, verbose=False)
+                self.startDetailed()
+            elif cause == "sampling: switch to functional":
+                m5.switchCpus(system, to_functional, verbose=False)
+                self.startFunctional()
+            else:
+                return event
@@ -29,10 +29,15 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <algorithm>
+#include <array>
+#include <bitset>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/intmath.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -42,15 +47,80 @@ GEM5_DEPRECATED_NAMESPACE(DecodeCache, decode_cache);
 namespace decode_cache
 {
 
-/// Hash for decoded instructions.
-template <typename EMI>
-using InstMap = std::unordered_map<EMI, StaticInstPtr>;
+/**
+ * Hash for decoded instructions, fronted by a small direct-mapped table
+ * of recently used entries so that the common case of re-decoding a hot
+ * instruction doesn't pay for a full hash table probe.
+ */
+template <typename EMI, size_t FrontEntries = 64>
+class InstMap
+{
+  protected:
+    static_assert(isPowerOf2(FrontEntries),
+                  "The front table size must be a power of 2");
+
+    struct FrontEntry
+    {
+        EMI machInst = {};
+        StaticInstPtr inst;
+    };
+
+    std::unordered_map<EMI, StaticInstPtr> instMap;
+    std::array<FrontEntry, FrontEntries> front;
+
+    static size_t
+    frontIndex(const EMI &mach_inst)
+    {
+        // Spread the hash with a Fibonacci multiply so instructions which
+        // differ only in their upper bits don't alias in the front table.
+        uint64_t h = std::hash<EMI>()(mach_inst);
+        return (h * 0x9E3779B97F4A7C15ULL) >>
+            (64 - floorLog2(FrontEntries));
+    }
+
+  public:
+    /// Find the decoded instruction for mach_inst.
+    /// @retval The StaticInst, or nullptr if it hasn't been decoded.
+    StaticInstPtr
+    find(const EMI &mach_inst)
+    {
+        FrontEntry &entry = front[frontIndex(mach_inst)];
+        if (entry.inst && entry.machInst == mach_inst)
+            return entry.inst;
+
+        auto it = instMap.find(mach_inst);
+        if (it == instMap.end())
+            return nullptr;
+
+        entry.machInst = mach_inst;
+        entry.inst = it->second;
+        return entry.inst;
+    }
+
+    /// Record that mach_inst decodes to inst.
+    void
+    insert(const EMI &mach_inst, const StaticInstPtr &inst)
+    {
+        instMap[mach_inst] = inst;
+        FrontEntry &entry = front[frontIndex(mach_inst)];
+        entry.machInst = mach_inst;
+        entry.inst = inst;
+    }
+};
 
-/// A sparse map from an Addr to a Value, stored in page chunks.
-template<class Value, Addr CacheChunkShift = 12>
+/**
+ * A sparse map from an Addr to a Value, stored in page chunks. Chunks are
+ * found through a small direct-mapped table of recently used pages before
+ * falling back to the hash map. Chunks are never freed, so references
+ * returned by lookup() stay valid for the life of the map.
+ */
+template<class Value, Addr CacheChunkShift = 12, size_t FrontEntries = 16>
 class AddrMap
 {
   protected:
+    static_assert(isPowerOf2(FrontEntries),
+                  "The front table size must be a power of 2");
+
     static constexpr Addr CacheChunkBytes = 1ULL << CacheChunkShift;
 
     static constexpr Addr
@@ -65,6 +135,12 @@ class AddrMap
         return addr & ~(CacheChunkBytes - 1);
     }
 
+    static constexpr size_t
+    chunkIndex(Addr chunk_addr, size_t entries)
+    {
+        return (chunk_addr >> CacheChunkShift) & (entries - 1);
+    }
+
     // A chunk of cache entries.
     struct CacheChunk
     {
@@ -72,68 +148,85 @@ class AddrMap
     };
     // A map of cache chunks which allows a sparse mapping.
     typedef typename std::unordered_map<Addr, CacheChunk *> ChunkMap;
-    typedef typename ChunkMap::iterator ChunkIt;
-    // Mini cache of recent lookups.
-    ChunkIt recent[2];
     ChunkMap chunkMap;
 
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(ChunkIt recentest)
+    // Direct-mapped cache of recently used chunks.
+    struct FrontEntry
     {
-        recent[1] = recent[0];
-        recent[0] = recentest;
-    }
+        Addr chunkAddr = MaxAddr;
+        CacheChunk *chunk = nullptr;
+    };
+    std::array<FrontEntry, FrontEntries> front;
 
-    /// Attempt to find the CacheChunk which goes with a particular
-    /// address. First check the small cache of recent results, then
-    /// actually look in the hash map.
+    // One bit per hashed page which has ever held a chunk. Lets
+    // invalidate() reject the common case of a store to a data page
+    // without touching the hash map.
+    static constexpr size_t FilterBits = 4096;
+    std::bitset<FilterBits> chunkFilter;
+
+    /// Find the chunk holding addr, checking the front table first.
     /// @param addr The address to look up.
+    /// @param allocate Whether to allocate the chunk if it is missing.
+    /// @retval The chunk, or nullptr if missing and not allocated.
     CacheChunk *
-    getChunk(Addr addr)
+    findChunk(Addr addr, bool allocate)
     {
         Addr chunk_addr = chunkStart(addr);
 
-        // Check against recent lookups.
-        if (recent[0] != chunkMap.end()) {
-            if (recent[0]->first == chunk_addr)
-                return recent[0]->second;
-            if (recent[1] != chunkMap.end() &&
-                    recent[1]->first == chunk_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
+        FrontEntry &entry = front[chunkIndex(chunk_addr, FrontEntries)];
+        if (entry.chunkAddr == chunk_addr)
+            return entry.chunk;
 
-        // Actually look in the hash_map.
-        ChunkIt it = chunkMap.find(chunk_addr);
+        CacheChunk *chunk;
+        auto it = chunkMap.find(chunk_addr);
         if (it != chunkMap.end()) {
-            update(it);
-            return it->second;
+            chunk = it->second;
+        } else if (allocate) {
+            chunk = new CacheChunk;
+            chunkMap.emplace(chunk_addr, chunk);
+            chunkFilter.set(chunkIndex(chunk_addr, FilterBits));
+        } else {
+            return nullptr;
         }
 
-        // Didn't find an existing chunk, so add a new one.
-        CacheChunk *newChunk = new CacheChunk;
-        typename ChunkMap::value_type to_insert(chunk_addr, newChunk);
-        update(chunkMap.insert(to_insert).first);
-        return newChunk;
+        entry.chunkAddr = chunk_addr;
+        entry.chunk = chunk;
+        return chunk;
     }
 
   public:
-    /// Constructor
-    AddrMap()
-    {
-        recent[0] = recent[1] = chunkMap.end();
-    }
-
     Value &
     lookup(Addr addr)
     {
-        CacheChunk *chunk = getChunk(addr);
+        CacheChunk *chunk = findChunk(addr, true);
         return chunk->items[chunkOffset(addr)];
     }
+
+    /**
+     * Reset every entry in [addr, addr + size) to its default value. Only
+     * pages which already hold entries are touched, so this is cheap to
+     * call on every store.
+     */
+    void
+    invalidate(Addr addr, Addr size)
+    {
+        Addr end = addr + size;
+        while (addr < end) {
+            Addr chunk_addr = chunkStart(addr);
+            Addr chunk_end = std::min(end, chunk_addr + CacheChunkBytes);
+            if (chunk_end <= addr)
+                chunk_end = end; // Wrapped around the address space.
+            if (chunkFilter.test(chunkIndex(chunk_addr, FilterBits))) {
+                if (CacheChunk *chunk = findChunk(addr, false)) {
+                    std::fill(&chunk->items[chunkOffset(addr)],
+                              &chunk->items[chunkOffset(addr)] +
+                                  (chunk_end - addr),
+                              Value());
+                }
+            }
+            addr = chunk_end;
+        }
+    }
 };
 
 } // namespace decode_cache
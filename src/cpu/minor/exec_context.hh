@@ -48,6 +48,7 @@
 #ifndef __CPU_MINOR_EXEC_CONTEXT_HH__
 #define __CPU_MINOR_EXEC_CONTEXT_HH__
 
+#include "arch/generic/decoder.hh"
 #include "cpu/exec_context.hh"
 #include "cpu/minor/execute.hh"
 #include "cpu/minor/pipeline.hh"
@@ -130,6 +131,8 @@ class ExecContext : public gem5::ExecContext
         override
     {
         assert(byte_enable.size() == size);
+        // Drop any code decoded from the bytes being overwritten.
+        thread.decoder->invalidate(addr, size);
         return execute.getLSQ().pushRequest(inst, false /* store */, data,
             size, addr, flags, res, nullptr, byte_enable);
     }
@@ -139,6 +142,7 @@ class ExecContext : public gem5::ExecContext
                    AtomicOpFunctorPtr amo_op) override
     {
         // AMO requests are pushed through the store path
+        thread.decoder->invalidate(addr, size);
         return execute.getLSQ().pushRequest(inst, false /* amo */, nullptr,
             size, addr, flags, nullptr, std::move(amo_op),
             std::vector<bool>(size, true));
@@ -54,6 +54,12 @@ class SMTQueuePolicy(ScopedEnum):
 class CommitPolicy(ScopedEnum):
     vals = [ 'RoundRobin', 'OldestReady' ]
 
+class IQScheduler(ScopedEnum):
+    vals = [ 'List', 'Matrix' ]
+
+class LSQSearchPolicy(ScopedEnum):
+    vals = [ 'Linear', 'Indexed', 'Checked' ]
+
 class BaseO3CPU(BaseCPU):
     type = 'BaseO3CPU'
     cxx_class = 'gem5::o3::CPU'
@@ -132,6 +138,10 @@ class BaseO3CPU(BaseCPU):
     LSQCheckLoads = Param.Bool(True,
         "Should dependency violations be checked for "
         "loads & stores or just stores")
+    LSQSearch = Param.LSQSearchPolicy('Indexed', "How the LQ and SQ are "
+        "searched for store to load forwarding and ordering violations: "
+        "by walking the queues, through an index of their addresses, or "
+        "both and checking they agree")
     store_set_clear_period = Param.Unsigned(250000,
             "Number of load/store insts before the dep predictor "
             "should be invalidated")
@@ -151,6 +161,9 @@ class BaseO3CPU(BaseCPU):
     # most ISAs don't use condition-code regs, so default is 0
     numPhysCCRegs = Param.Unsigned(0, "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqScheduler = Param.IQScheduler('List', "Wakeup and select logic of "
+        "the instruction queue, either dependency chains and per op class "
+        "ready lists, or wakeup and age matrices")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
@@ -0,0 +1,255 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_AGE_MATRIX_HH__
+#define __CPU_O3_AGE_MATRIX_HH__
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Bit matrix alternative to the per op class ready queues of the IQ and
+ * the list ordering them. Each ready instruction gets an entry, with a
+ * bitmask per op class of its ready entries, and a row per entry of the
+ * entries holding older instructions.
+ *
+ * Selection works on a set of candidate entries, initially all the ready
+ * ones. The oldest candidate is the one with no older candidate in its
+ * row, and blocking an op class (e.g. because its functional units are
+ * busy) removes its entries from the candidates. This picks instructions
+ * in the same order as walking the ready queues by age of their oldest
+ * instruction.
+ */
+template <class DynInstPtr>
+class AgeMatrix
+{
+  public:
+    /**
+     * Size the matrix.
+     * @param num_classes Number of op classes.
+     * @param num_entries Expected number of ready instructions. The
+     * matrix grows if more instructions end up ready.
+     */
+    void
+    resize(int num_classes, int num_entries)
+    {
+        numClasses = num_classes;
+        numEntries = 0;
+        numWords = 0;
+        numReady = 0;
+        older.clear();
+        classes.clear();
+        ready.clear();
+        candidates.clear();
+        insts.clear();
+        entryClass.clear();
+        freeEntries.clear();
+        grow(num_entries);
+    }
+
+    /** Clear the matrix. */
+    void reset() { resize(numClasses, numEntries); }
+
+    /** Check if there are no ready instructions. */
+    bool empty() const { return numReady == 0; }
+
+    /** Number of ready instructions of an op class. */
+    int
+    size(int op_class) const
+    {
+        int num = 0;
+        for (int w = 0; w < numWords; w++)
+            num += popCount(classes[op_class * numWords + w]);
+        return num;
+    }
+
+    /** Add a ready instruction. */
+    void
+    insert(const DynInstPtr &inst, int op_class)
+    {
+        if (freeEntries.empty())
+            grow(2 * numEntries);
+        const int entry = freeEntries.back();
+        freeEntries.pop_back();
+
+        uint64_t *row = &older[entry * numWords];
+        std::fill(row, row + numWords, 0);
+        for (int w = 0; w < numWords; w++) {
+            for (uint64_t word = ready[w]; word; word &= word - 1) {
+                const int other = w * 64 + findLsbSet(word);
+                if (insts[other]->seqNum < inst->seqNum) {
+                    setBit(row, other);
+                    clearBit(&older[other * numWords], entry);
+                } else {
+                    setBit(&older[other * numWords], entry);
+                }
+            }
+        }
+
+        insts[entry] = inst;
+        entryClass[entry] = op_class;
+        setBit(ready.data(), entry);
+        setBit(&classes[op_class * numWords], entry);
+        numReady++;
+    }
+
+    /** Make all the ready instructions candidates for selection. */
+    void startSelection() { candidates = ready; }
+
+    /**
+     * Find the oldest candidate.
+     * @return Its entry, or -1 if there are no candidates left.
+     */
+    int
+    selectOldest() const
+    {
+        for (int w = 0; w < numWords; w++) {
+            for (uint64_t word = candidates[w]; word; word &= word - 1) {
+                const int entry = w * 64 + findLsbSet(word);
+                const uint64_t *row = &older[entry * numWords];
+                bool oldest = true;
+                for (int v = 0; v < numWords && oldest; v++)
+                    oldest = !(row[v] & candidates[v]);
+                if (oldest)
+                    return entry;
+            }
+        }
+        return -1;
+    }
+
+    /** Remove all the instructions of an op class from the candidates. */
+    void
+    block(int op_class)
+    {
+        const uint64_t *mask = &classes[op_class * numWords];
+        for (int w = 0; w < numWords; w++)
+            candidates[w] &= ~mask[w];
+    }
+
+    /** The instruction of an entry. */
+    const DynInstPtr &inst(int entry) const { return insts[entry]; }
+
+    /** The op class of an entry. */
+    int opClass(int entry) const { return entryClass[entry]; }
+
+    /** Remove a ready instruction, e.g. once it has been issued. */
+    void
+    remove(int entry)
+    {
+        clearBit(ready.data(), entry);
+        clearBit(&classes[entryClass[entry] * numWords], entry);
+        if (!candidates.empty())
+            clearBit(candidates.data(), entry);
+        insts[entry] = nullptr;
+        freeEntries.push_back(entry);
+        numReady--;
+    }
+
+  private:
+    static void
+    setBit(uint64_t *mask, int entry)
+    {
+        mask[entry / 64] |= 1ULL << (entry % 64);
+    }
+
+    static void
+    clearBit(uint64_t *mask, int entry)
+    {
+        mask[entry / 64] &= ~(1ULL << (entry % 64));
+    }
+
+    /** Grow the matrix to have at least the given number of entries. */
+    void
+    grow(int num_entries)
+    {
+        const int new_words = std::max(1, (num_entries + 63) / 64);
+        if (numEntries && new_words <= numWords)
+            return;
+        const int new_entries = new_words * 64;
+
+        std::vector<uint64_t> new_older((size_t)new_entries * new_words, 0);
+        for (int e = 0; e < numEntries; e++) {
+            std::copy_n(&older[e * numWords], numWords,
+                        &new_older[e * new_words]);
+        }
+        older.swap(new_older);
+
+        std::vector<uint64_t> new_classes((size_t)numClasses * new_words, 0);
+        for (int c = 0; c < numClasses && numWords; c++) {
+            std::copy_n(&classes[c * numWords], numWords,
+                        &new_classes[c * new_words]);
+        }
+        classes.swap(new_classes);
+
+        ready.resize(new_words, 0);
+        candidates.resize(new_words, 0);
+        insts.resize(new_entries);
+        entryClass.resize(new_entries, 0);
+        // Hand out the lowest entries first.
+        for (int e = new_entries - 1; e >= numEntries; e--)
+            freeEntries.push_back(e);
+
+        numEntries = new_entries;
+        numWords = new_words;
+    }
+
+    /** Number of op classes. */
+    int numClasses = 0;
+    /** Number of entries, a multiple of 64. */
+    int numEntries = 0;
+    /** Number of 64 bit words in a bitmask of entries. */
+    int numWords = 0;
+    /** Number of ready instructions. */
+    int numReady = 0;
+
+    /** For each entry, the bitmask of the entries older than it. */
+    std::vector<uint64_t> older;
+    /** For each op class, the bitmask of its ready entries. */
+    std::vector<uint64_t> classes;
+    /** Bitmask of the entries holding a ready instruction. */
+    std::vector<uint64_t> ready;
+    /** Bitmask of the entries which can still be selected. */
+    std::vector<uint64_t> candidates;
+    /** The instruction of each entry. */
+    std::vector<DynInstPtr> insts;
+    /** The op class of each entry. */
+    std::vector<int> entryClass;
+    /** The entries with no instruction. */
+    std::vector<int> freeEntries;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_AGE_MATRIX_HH__
@@ -0,0 +1,174 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/o3/age_matrix.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+/** The only part of an instruction the age matrix looks at. */
+struct Inst
+{
+    uint64_t seqNum;
+};
+
+typedef AgeMatrix<Inst *> Matrix;
+
+/** Select and remove all the candidates, returning their sequence numbers. */
+std::vector<uint64_t>
+drain(Matrix &matrix)
+{
+    std::vector<uint64_t> order;
+    matrix.startSelection();
+    for (int entry = matrix.selectOldest(); entry >= 0;
+         entry = matrix.selectOldest()) {
+        order.push_back(matrix.inst(entry)->seqNum);
+        matrix.remove(entry);
+    }
+    return order;
+}
+
+} // anonymous namespace
+
+/** A new matrix has nothing to select. */
+TEST(AgeMatrixTest, Empty)
+{
+    Matrix matrix;
+    matrix.resize(2, 16);
+    ASSERT_TRUE(matrix.empty());
+    ASSERT_EQ(matrix.size(0), 0);
+    matrix.startSelection();
+    ASSERT_EQ(matrix.selectOldest(), -1);
+}
+
+/** The oldest ready instruction is selected first, whatever the order
+ * the instructions became ready in. */
+TEST(AgeMatrixTest, OldestReady)
+{
+    std::vector<Inst> insts = {{5}, {2}, {9}, {1}, {7}};
+    Matrix matrix;
+    matrix.resize(2, 16);
+    for (size_t i = 0; i < insts.size(); i++)
+        matrix.insert(&insts[i], i % 2);
+    ASSERT_EQ(matrix.size(0), 3);
+    ASSERT_EQ(matrix.size(1), 2);
+
+    matrix.startSelection();
+    const int entry = matrix.selectOldest();
+    ASSERT_EQ(matrix.inst(entry)->seqNum, 1u);
+    ASSERT_EQ(matrix.opClass(entry), 1);
+
+    ASSERT_EQ(drain(matrix), std::vector<uint64_t>({1, 2, 5, 7, 9}));
+    ASSERT_TRUE(matrix.empty());
+}
+
+/** Blocking an op class removes its instructions from the candidates,
+ * but not from the ready instructions. */
+TEST(AgeMatrixTest, Block)
+{
+    std::vector<Inst> insts = {{1}, {2}, {3}, {4}};
+    Matrix matrix;
+    matrix.resize(2, 16);
+    matrix.insert(&insts[0], 0);
+    matrix.insert(&insts[1], 1);
+    matrix.insert(&insts[2], 0);
+    matrix.insert(&insts[3], 1);
+
+    matrix.startSelection();
+    matrix.block(0);
+    int entry = matrix.selectOldest();
+    ASSERT_EQ(matrix.inst(entry)->seqNum, 2u);
+    matrix.remove(entry);
+    entry = matrix.selectOldest();
+    ASSERT_EQ(matrix.inst(entry)->seqNum, 4u);
+    matrix.remove(entry);
+    ASSERT_EQ(matrix.selectOldest(), -1);
+
+    // a new selection unblocks the op class
+    ASSERT_EQ(matrix.size(0), 2);
+    ASSERT_EQ(drain(matrix), std::vector<uint64_t>({1, 3}));
+}
+
+/** Removing instructions, e.g. when squashing them, clears their rows
+ * and columns, so that the instructions reusing their entries are
+ * ordered by their own age only. */
+TEST(AgeMatrixTest, Squash)
+{
+    std::vector<Inst> insts = {{10}, {20}, {30}, {40}, {15}, {35}};
+    Matrix matrix;
+    matrix.resize(1, 16);
+    for (int i = 0; i < 4; i++)
+        matrix.insert(&insts[i], 0);
+
+    // squash the oldest and the youngest instruction, then make two new
+    // ones ready, which take their entries
+    matrix.startSelection();
+    const int oldest = matrix.selectOldest();
+    ASSERT_EQ(matrix.inst(oldest)->seqNum, 10u);
+    matrix.remove(oldest);
+    // the entries are handed out lowest first
+    int youngest = -1;
+    for (int entry = 0; entry < 4; entry++) {
+        if (entry != oldest && matrix.inst(entry)->seqNum == 40)
+            youngest = entry;
+    }
+    ASSERT_NE(youngest, -1);
+    matrix.remove(youngest);
+    ASSERT_EQ(matrix.size(0), 2);
+
+    matrix.insert(&insts[4], 0);
+    matrix.insert(&insts[5], 0);
+    ASSERT_EQ(drain(matrix), std::vector<uint64_t>({15, 20, 30, 35}));
+}
+
+/** The matrix grows past its initial size and keeps the age order. */
+TEST(AgeMatrixTest, Grow)
+{
+    std::vector<Inst> insts(200);
+    for (size_t i = 0; i < insts.size(); i++)
+        insts[i].seqNum = i;
+    std::mt19937 gen(1);
+    std::shuffle(insts.begin(), insts.end(), gen);
+
+    Matrix matrix;
+    matrix.resize(3, 16);
+    for (size_t i = 0; i < insts.size(); i++)
+        matrix.insert(&insts[i], i % 3);
+
+    const std::vector<uint64_t> order = drain(matrix);
+    ASSERT_EQ(order.size(), insts.size());
+    for (size_t i = 0; i < order.size(); i++)
+        ASSERT_EQ(order[i], uint64_t(i));
+}
@@ -77,9 +77,12 @@ CPU::CPU(const BaseO3CPUParams &params)
                 false, Event::CPU_Tick_Pri),
       threadExitEvent([this]{ exitThreads(); }, "O3CPU exit threads",
                 false, Event::CPU_Exit_Pri),
+      dynInstPool(this),
 #ifndef NDEBUG
       instcount(0),
 #endif
+      instList(params.numROBEntries +
+               params.numThreads * params.fetchQueueSize),
       removeInstsThisCycle(false),
       fetch(this, params),
       decode(this, params),
@@ -1309,7 +1312,7 @@ CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
             tid, seq_num, (*inst_iter)->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
+    while (!*inst_iter || (*inst_iter)->seqNum > seq_num) {
 
         bool break_loop = (inst_iter == instList.begin());
 
@@ -1325,7 +1328,7 @@ CPU::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 void
 CPU::squashInstIt(const ListIt &instIt, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    if (*instIt && (*instIt)->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
                 (*instIt)->threadNumber,
@@ -1376,6 +1379,12 @@ CPU::dumpInsts()
     cprintf("Dumping Instruction List\n");
 
     while (inst_list_it != instList.end()) {
+        // Skip the holes left by squashed instructions.
+        if (!*inst_list_it) {
+            inst_list_it++;
+            continue;
+        }
+
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
                 num, (*inst_list_it)->pcState().instAddr(),
@@ -55,10 +55,12 @@
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/commit.hh"
 #include "cpu/o3/decode.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/fetch.hh"
 #include "cpu/o3/free_list.hh"
 #include "cpu/o3/iew.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/rename.hh"
 #include "cpu/o3/rob.hh"
@@ -94,7 +96,7 @@ class ThreadContext;
 class CPU : public BaseCPU
 {
   public:
-    typedef std::list<DynInstPtr>::iterator ListIt;
+    typedef InstRing::iterator ListIt;
 
     friend class ThreadContext;
 
@@ -373,13 +375,20 @@ class CPU : public BaseCPU
     void dumpInsts();
 
   public:
+    /** Recycles the storage of the dynamic instructions. Declared before
+     * any structure holding instructions so that it outlives them.
+     */
+    DynInstPool dynInstPool;
+
 #ifndef NDEBUG
     /** Count of total number of dynamic instructions in flight. */
     int instcount;
 #endif
 
-    /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    /** List of all the instructions in flight. As the threads share it,
+     *  squashing one of them can leave null holes in the list.
+     */
+    InstRing instList;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
@@ -167,8 +167,11 @@ DynInst::operator new(size_t count, Arrays &arrays)
     // Figure out how much space we need in total.
     size_t total_size = ready_src_idx + ready_src_idx_size;
 
-    // Actually allocate it.
-    uint8_t *buf = (uint8_t *)::operator new(total_size);
+    // Actually allocate it, recycling the storage of an earlier
+    // instruction with the same number of registers if possible.
+    assert(arrays.pool);
+    uint8_t *buf =
+        (uint8_t *)arrays.pool->allocate(num_srcs, num_dests, total_size);
 
     // Fill in "arrays" with pointers to all the arrays.
     arrays.flatDestIdx = (RegId *)(buf + flat_dest_idx);
@@ -187,6 +190,18 @@ DynInst::operator new(size_t count, Arrays &arrays)
     return buf;
 }
 
+void
+DynInst::operator delete(void *ptr)
+{
+    DynInstPool::release(ptr);
+}
+
+void
+DynInst::operator delete(void *ptr, Arrays &arrays)
+{
+    DynInstPool::release(ptr);
+}
+
 DynInst::~DynInst()
 {
     /*
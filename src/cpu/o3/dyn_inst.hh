@@ -57,7 +57,9 @@
 #include "cpu/inst_res.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/cpu.hh"
+#include "cpu/o3/dyn_inst_pool.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/o3/lsq_unit.hh"
 #include "cpu/op_class.hh"
 #include "cpu/reg_class.hh"
@@ -81,13 +83,16 @@ class DynInst : public ExecContext, public RefCounted
 
   public:
     // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename InstRing::iterator ListIt;
 
     struct Arrays
     {
         size_t numSrcs;
         size_t numDests;
 
+        /** The pool the instruction storage is recycled through. */
+        DynInstPool *pool;
+
         RegId *flatDestIdx;
         PhysRegIdPtr *destIdx;
         PhysRegIdPtr *prevDestIdx;
@@ -96,6 +101,8 @@ class DynInst : public ExecContext, public RefCounted
     };
 
     static void *operator new(size_t count, Arrays &arrays);
+    static void operator delete(void *ptr);
+    static void operator delete(void *ptr, Arrays &arrays);
 
     /** BaseDynInst constructor given a binary instruction. */
     DynInst(const Arrays &arrays, const StaticInstPtr &staticInst,
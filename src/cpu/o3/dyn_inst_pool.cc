@@ -0,0 +1,99 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/dyn_inst_pool.hh"
+
+#include <cassert>
+#include <new>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+DynInstPool::DynInstPool(statistics::Group *parent)
+    : statistics::Group(parent, "dynInstPool"),
+      buckets(MaxRegs * MaxRegs),
+      ADD_STAT(allocations, statistics::units::Count::get(),
+               "Number of dynamic instruction buffers allocated"),
+      ADD_STAT(reused, statistics::units::Count::get(),
+               "Number of dynamic instruction buffers recycled from the "
+               "pool"),
+      ADD_STAT(reuseRate, statistics::units::Ratio::get(),
+               "Fraction of the buffers recycled from the pool",
+               reused / allocations)
+{
+}
+
+DynInstPool::~DynInstPool()
+{
+    for (auto &bucket : buckets) {
+        for (auto *header : bucket.free)
+            ::operator delete(header);
+    }
+}
+
+void *
+DynInstPool::allocate(size_t num_srcs, size_t num_dests, size_t size)
+{
+    allocations++;
+
+    Header *header;
+    if (num_srcs >= MaxRegs || num_dests >= MaxRegs) {
+        header = (Header *)::operator new(sizeof(Header) + size);
+        header->pool = nullptr;
+        return header + 1;
+    }
+
+    const uint32_t idx = num_srcs * MaxRegs + num_dests;
+    Bucket &bucket = buckets[idx];
+    if (bucket.free.empty()) {
+        assert(bucket.size == 0 || bucket.size == sizeof(Header) + size);
+        bucket.size = sizeof(Header) + size;
+        header = (Header *)::operator new(bucket.size);
+        header->pool = this;
+        header->bucket = idx;
+    } else {
+        reused++;
+        header = bucket.free.back();
+        bucket.free.pop_back();
+    }
+
+    return header + 1;
+}
+
+void
+DynInstPool::release(void *ptr)
+{
+    Header *header = (Header *)ptr - 1;
+    if (header->pool)
+        header->pool->buckets[header->bucket].free.push_back(header);
+    else
+        ::operator delete(header);
+}
+
+} // namespace o3
+} // namespace gem5
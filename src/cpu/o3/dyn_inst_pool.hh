@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_POOL_HH__
+#define __CPU_O3_DYN_INST_POOL_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/statistics.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Recycles the storage of the dynamic instructions of a CPU. A DynInst
+ * and its register index arrays live in a single buffer whose size only
+ * depends on the number of source and destination registers of the
+ * instruction, so freed buffers are kept in free lists bucketed by those
+ * counts and handed out again to later instructions with the same
+ * counts, rather than going through the global allocator for every
+ * fetched instruction.
+ */
+class DynInstPool : public statistics::Group
+{
+  public:
+    /**
+     * Bookkeeping placed in front of every buffer so that it can be
+     * returned to the pool it came from.
+     */
+    struct alignas(alignof(std::max_align_t)) Header
+    {
+        /** The owning pool, null for buffers that aren't pooled. */
+        DynInstPool *pool;
+        /** The free list the buffer belongs to. */
+        uint32_t bucket;
+    };
+
+    DynInstPool(statistics::Group *parent);
+    ~DynInstPool();
+
+    /**
+     * Get a buffer, preceded by a header, large enough for an instruction
+     * with the given register counts.
+     *
+     * @param num_srcs Number of source registers.
+     * @param num_dests Number of destination registers.
+     * @param size Size of the buffer, excluding the header.
+     * @return Pointer to the buffer, after the header.
+     */
+    void *allocate(size_t num_srcs, size_t num_dests, size_t size);
+
+    /** Return a buffer obtained from allocate(). */
+    static void release(void *ptr);
+
+  private:
+    /** Register counts above this limit are not pooled. */
+    static const size_t MaxRegs = 32;
+
+    struct Bucket
+    {
+        /** Size of the buffers of the bucket, including the header. */
+        size_t size = 0;
+        std::vector<Header *> free;
+    };
+
+    std::vector<Bucket> buckets;
+
+    statistics::Scalar allocations;
+    statistics::Scalar reused;
+    statistics::Formula reuseRate;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_DYN_INST_POOL_HH__
@@ -114,6 +114,12 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
     //dependency graph.
     dependGraph.resize(numPhysRegs);
 
+    matrixScheduler = params.iqScheduler == IQScheduler::Matrix;
+    if (matrixScheduler) {
+        wakeupMatrix.resize(numPhysRegs, numEntries);
+        ageMatrix.resize(Num_OpClasses, numEntries);
+    }
+
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
 
@@ -123,6 +129,10 @@ InstructionQueue::InstructionQueue(CPU *cpu_ptr, IEW *iew_ptr,
         memDepUnit[tid].setIQ(this);
     }
 
+    for (ThreadID tid = 0; tid < numThreads; tid++) {
+        instList[tid].reserve(params.numROBEntries);
+    }
+
     resetState();
 
     //Figure out resource sharing policy
@@ -420,6 +430,10 @@ InstructionQueue::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    if (matrixScheduler) {
+        wakeupMatrix.reset();
+        ageMatrix.reset();
+    }
     nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
@@ -452,6 +466,7 @@ bool
 InstructionQueue::isDrained() const
 {
     bool drained = dependGraph.empty() &&
+                   wakeupMatrix.empty() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -464,6 +479,7 @@ void
 InstructionQueue::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(wakeupMatrix.empty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -545,7 +561,7 @@ InstructionQueue::isFull(ThreadID tid)
 bool
 InstructionQueue::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || !ageMatrix.empty()) {
         return true;
     }
 
@@ -744,6 +760,94 @@ InstructionQueue::processFUCompletion(const DynInstPtr &inst, int fu_idx)
     instsToExecute.push_back(inst);
 }
 
+bool
+InstructionQueue::issueInst(const DynInstPtr &issuing_inst,
+                            IssueStruct *i2e_info)
+{
+    OpClass op_class = issuing_inst->opClass();
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            iqIOStats.fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            iqIOStats.vecAluAccesses++;
+        } else {
+            iqIOStats.intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == FUPool::NoFreeFU) {
+        iqStats.statFuBusy[op_class]++;
+        iqStats.fuBusy[tid]++;
+        return false;
+    }
+
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
+    } else {
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
+    }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (issuing_inst->firstIssue == -1)
+        issuing_inst->firstIssue = curTick();
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    iqStats.statIssuedInstType[tid][op_class]++;
+
+    return true;
+}
+
 // @todo: Figure out a better way to remove the squashed items from the
 // lists.  Checking the top item of each list to see if it's squashed
 // wastes time and forces jumps.
@@ -774,6 +878,41 @@ InstructionQueue::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
+
+    if (matrixScheduler) {
+        // The age matrix gives the oldest instruction among the op
+        // classes which haven't been found to have busy FUs yet, which
+        // is the order the age order list below is walked in.
+        ageMatrix.startSelection();
+
+        while (total_issued < totalWidth) {
+            int entry = ageMatrix.selectOldest();
+            if (entry < 0)
+                break;
+
+            OpClass op_class = (OpClass)ageMatrix.opClass(entry);
+            DynInstPtr issuing_inst = ageMatrix.inst(entry);
+
+            if (issuing_inst->isFloating()) {
+                iqIOStats.fpInstQueueReads++;
+            } else if (issuing_inst->isVector()) {
+                iqIOStats.vecInstQueueReads++;
+            } else {
+                iqIOStats.intInstQueueReads++;
+            }
+
+            if (issuing_inst->isSquashed()) {
+                ageMatrix.remove(entry);
+                ++iqStats.squashedInstsIssued;
+            } else if (issueInst(issuing_inst, i2e_info)) {
+                ageMatrix.remove(entry);
+                ++total_issued;
+            } else {
+                ageMatrix.block(op_class);
+            }
+        }
+    }
+
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
 
@@ -811,60 +950,7 @@ InstructionQueue::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                iqIOStats.fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                iqIOStats.vecAluAccesses++;
-            } else {
-                iqIOStats.intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueInst(issuing_inst, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -874,31 +960,10 @@ InstructionQueue::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (issuing_inst->firstIssue == -1)
-                issuing_inst->firstIssue = curTick();
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            iqStats.statIssuedInstType[tid][op_class]++;
         } else {
-            iqStats.statFuBusy[op_class]++;
-            iqStats.fuBusy[tid]++;
             ++order_it;
         }
     }
@@ -950,17 +1015,42 @@ InstructionQueue::commit(const InstSeqNum &inst, ThreadID tid)
     DPRINTF(IQ, "[tid:%i] Committing instructions older than [sn:%llu]\n",
             tid,inst);
 
-    ListIt iq_it = instList[tid].begin();
-
-    while (iq_it != instList[tid].end() &&
-           (*iq_it)->seqNum <= inst) {
-        ++iq_it;
+    while (!instList[tid].empty() &&
+           instList[tid].front()->seqNum <= inst) {
         instList[tid].pop_front();
     }
 
     assert(freeEntries == (numEntries - countInsts()));
 }
 
+int
+InstructionQueue::wakeMatrixDependents(PhysRegIdPtr dest_reg)
+{
+    int dependents = 0;
+    const RegIndex flat_idx = dest_reg->flatIndex();
+
+    // The matrix holds a single bit per instruction and register, so
+    // mark every source reading the register as ready at once.
+    while (DynInstPtr dep_inst = wakeupMatrix.pop(flat_idx)) {
+        DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
+                "PC %s.\n", dep_inst->seqNum, dep_inst->pcState());
+
+        for (int src_idx = 0; src_idx < dep_inst->numSrcRegs(); src_idx++) {
+            PhysRegIdPtr src_reg = dep_inst->renamedSrcIdx(src_idx);
+            if (!dep_inst->readySrcIdx(src_idx) &&
+                    !src_reg->isFixedMapping() &&
+                    src_reg->flatIndex() == flat_idx) {
+                dep_inst->markSrcRegReady(src_idx);
+                ++dependents;
+            }
+        }
+
+        addIfReady(dep_inst);
+    }
+
+    return dependents;
+}
+
 int
 InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
 {
@@ -1030,6 +1120,12 @@ InstructionQueue::wakeDependents(const DynInstPtr &completed_inst)
                 dest_reg->index(),
                 dest_reg->className());
 
+        if (matrixScheduler) {
+            dependents += wakeMatrixDependents(dest_reg);
+            regScoreboard[dest_reg->flatIndex()] = true;
+            continue;
+        }
+
         //Go through the dependency chain, marking the registers as
         //ready within the waiting instructions.
         DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
@@ -1067,6 +1163,23 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
+    addToReadyQueue(ready_inst);
+
+    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
+            "the ready list, PC %s opclass:%i [sn:%llu].\n",
+            ready_inst->pcState(), op_class, ready_inst->seqNum);
+}
+
+void
+InstructionQueue::addToReadyQueue(const DynInstPtr &ready_inst)
+{
+    OpClass op_class = ready_inst->opClass();
+
+    if (matrixScheduler) {
+        ageMatrix.insert(ready_inst, op_class);
+        return;
+    }
+
     readyInsts[op_class].push(ready_inst);
 
     // Will need to reorder the list if either a queue is not on the list,
@@ -1078,10 +1191,6 @@ InstructionQueue::addReadyMemInst(const DynInstPtr &ready_inst)
         listOrder.erase(readyIt[op_class]);
         addToOrderList(op_class);
     }
-
-    DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
-            "the ready list, PC %s opclass:%i [sn:%llu].\n",
-            ready_inst->pcState(), op_class, ready_inst->seqNum);
 }
 
 void
@@ -1133,7 +1242,7 @@ InstructionQueue::cacheUnblocked()
 DynInstPtr
 InstructionQueue::getDeferredMemInstToExecute()
 {
-    for (ListIt it = deferredMemInsts.begin(); it != deferredMemInsts.end();
+    for (auto it = deferredMemInsts.begin(); it != deferredMemInsts.end();
          ++it) {
         if ((*it)->translationCompleted() || (*it)->isSquashed()) {
             DynInstPtr mem_inst = std::move(*it);
@@ -1183,19 +1292,15 @@ InstructionQueue::squash(ThreadID tid)
 void
 InstructionQueue::doSquash(ThreadID tid)
 {
-    // Start at the tail.
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     DPRINTF(IQ, "[tid:%i] Squashing until sequence number %i!\n",
             tid, squashedSeqNum[tid]);
 
     // Squash any instructions younger than the squashed sequence number
-    // given.
-    while (squash_it != instList[tid].end() &&
-           (*squash_it)->seqNum > squashedSeqNum[tid]) {
+    // given, starting at the tail.
+    while (!instList[tid].empty() &&
+           instList[tid].back()->seqNum > squashedSeqNum[tid]) {
 
-        DynInstPtr squashed_inst = (*squash_it);
+        DynInstPtr squashed_inst = instList[tid].back();
         if (squashed_inst->isFloating()) {
             iqIOStats.fpInstQueueWrites++;
         } else if (squashed_inst->isVector()) {
@@ -1204,13 +1309,10 @@ InstructionQueue::doSquash(ThreadID tid)
             iqIOStats.intInstQueueWrites++;
         }
 
-        // Only handle the instruction if it actually is in the IQ and
-        // hasn't already been squashed in the IQ.
-        if (squashed_inst->threadNumber != tid ||
-            squashed_inst->isSquashedInIQ()) {
-            --squash_it;
-            continue;
-        }
+        // The list only holds instructions of this thread, and they
+        // leave it as soon as they are squashed in the IQ.
+        assert(squashed_inst->threadNumber == tid &&
+               !squashed_inst->isSquashedInIQ());
 
         if (!squashed_inst->isIssued() ||
             (squashed_inst->isMemRef() &&
@@ -1250,8 +1352,13 @@ InstructionQueue::doSquash(ThreadID tid)
 
                     if (!squashed_inst->readySrcIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        if (matrixScheduler) {
+                            wakeupMatrix.remove(src_reg->flatIndex(),
+                                                squashed_inst);
+                        } else {
+                            dependGraph.remove(src_reg->flatIndex(),
+                                               squashed_inst);
+                        }
                     }
 
                     ++iqStats.squashedOperandsExamined;
@@ -1317,7 +1424,7 @@ InstructionQueue::doSquash(ThreadID tid)
             assert(dependGraph.empty(dest_reg->flatIndex()));
             dependGraph.clearInst(dest_reg->flatIndex());
         }
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
         ++iqStats.squashedInstsExamined;
     }
 }
@@ -1336,6 +1443,7 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
     // them to the dependency list if they are not ready.
     int8_t total_src_regs = new_inst->numSrcRegs();
     bool return_val = false;
+    int slot = -1;
 
     for (int src_reg_idx = 0;
          src_reg_idx < total_src_regs;
@@ -1357,7 +1465,13 @@ InstructionQueue::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (matrixScheduler) {
+                    if (slot < 0)
+                        slot = wakeupMatrix.allocate(new_inst);
+                    wakeupMatrix.insert(src_reg->flatIndex(), slot);
+                } else {
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
+                }
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1397,14 +1511,25 @@ InstructionQueue::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
+        // No instruction may still wait on the value of a previous
+        // producer of the register.
+        if (matrixScheduler) {
+            panic_if(!wakeupMatrix.empty(dest_reg->flatIndex()),
+                     "Wakeup matrix %i (%s) (flat: %i) not empty!",
+                     dest_reg->index(), dest_reg->className(),
+                     dest_reg->flatIndex());
+        } else if (!dependGraph.empty(dest_reg->flatIndex())) {
             dependGraph.dump();
             panic("Dependency graph %i (%s) (flat: %i) not empty!",
                   dest_reg->index(), dest_reg->className(),
                   dest_reg->flatIndex());
         }
 
-        dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+        // The wakeup matrix tracks the consumers on its own, and nothing
+        // would clear the head node of the dependency graph, keeping the
+        // producer alive.
+        if (!matrixScheduler)
+            dependGraph.setInst(dest_reg->flatIndex(), new_inst);
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
@@ -1436,17 +1561,7 @@ InstructionQueue::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
-        readyInsts[op_class].push(inst);
-
-        // Will need to reorder the list if either a queue is not on the list,
-        // or it has an older instruction than last time.
-        if (!queueOnList[op_class]) {
-            addToOrderList(op_class);
-        } else if (readyInsts[op_class].top()->seqNum  <
-                   (*readyIt[op_class]).oldestInst) {
-            listOrder.erase(readyIt[op_class]);
-            addToOrderList(op_class);
-        }
+        addToReadyQueue(inst);
     }
 }
 
@@ -1460,7 +1575,8 @@ void
 InstructionQueue::dumpLists()
 {
     for (int i = 0; i < Num_OpClasses; ++i) {
-        cprintf("Ready list %i size: %i\n", i, readyInsts[i].size());
+        cprintf("Ready list %i size: %i\n", i, matrixScheduler ?
+                ageMatrix.size(i) : readyInsts[i].size());
 
         cprintf("\n");
     }
@@ -1544,7 +1660,7 @@ InstructionQueue::dumpInsts()
 
     int num = 0;
     int valid_num = 0;
-    ListIt inst_list_it = instsToExecute.begin();
+    std::list<DynInstPtr>::iterator inst_list_it = instsToExecute.begin();
 
     while (inst_list_it != instsToExecute.end())
     {
@@ -50,14 +50,19 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/age_matrix.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/dep_graph.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/mem_dep_unit.hh"
 #include "cpu/o3/store_set.hh"
+#include "cpu/o3/wakeup_matrix.hh"
 #include "cpu/op_class.hh"
+#include "cpu/reg_class.hh"
 #include "cpu/timebuf.hh"
+#include "enums/IQScheduler.hh"
 #include "enums/SMTQueuePolicy.hh"
 #include "sim/eventq.hh"
 
@@ -99,7 +104,7 @@ class InstructionQueue
 {
   public:
     // Typedef of iterator through the list of instructions.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename InstRing::iterator ListIt;
 
     /** FU completion event class. */
     class FUCompletion : public Event
@@ -317,8 +322,11 @@ class InstructionQueue
     // Instruction lists, ready queues, and ordering
     //////////////////////////////////////
 
-    /** List of all the instructions in the IQ (some of which may be issued). */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** List of all the instructions in the IQ (some of which may be issued).
+     *  Issued instructions stay in the list until they commit, so it is
+     *  sized to the ROB rather than to the IQ.
+     */
+    InstRing instList[MaxThreads];
 
     /** List of instructions that are ready to be executed. */
     std::list<DynInstPtr> instsToExecute;
@@ -404,6 +412,19 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Whether the matrices below replace the dependency graph, and the
+     *  ready queues and their age order list. The dependency graph is
+     *  then left empty, the scoreboard tracking which registers are
+     *  ready and the wakeup matrix which instructions wait on them.
+     */
+    bool matrixScheduler;
+
+    /** Instructions waiting on each register, with the matrix scheduler. */
+    WakeupMatrix<DynInstPtr> wakeupMatrix;
+
+    /** Ready instructions and their ages, with the matrix scheduler. */
+    AgeMatrix<DynInstPtr> ageMatrix;
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
@@ -463,6 +484,21 @@ class InstructionQueue
     /** Moves an instruction to the ready queue if it is ready. */
     void addIfReady(const DynInstPtr &inst);
 
+    /** Adds an instruction with its operands ready to the ready queues. */
+    void addToReadyQueue(const DynInstPtr &ready_inst);
+
+    /**
+     * Tries to get a FU for a ready instruction and issue it.
+     * @return Whether the instruction was issued.
+     */
+    bool issueInst(const DynInstPtr &issuing_inst,
+                   IssueStruct *i2e_info);
+
+    /** Wakes the instructions waiting on a register in the wakeup matrix.
+     *  @return Number of operands made ready.
+     */
+    int wakeMatrixDependents(PhysRegIdPtr dest_reg);
+
     /** Debugging function to count how many entries are in the IQ.  It does
      *  a linear walk through the instructions, so do not call this function
      *  during normal execution.
@@ -0,0 +1,93 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/inst_ring.hh"
+
+#include <algorithm>
+#include <cassert>
+
+#include "cpu/o3/dyn_inst.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+InstRing::InstRing(size_t capacity) : Base(capacity) {}
+
+InstRing::~InstRing() {}
+
+void
+InstRing::push_back(const DynInstPtr &inst)
+{
+    if (full())
+        reserve(std::max<size_t>(2 * capacity(), 16));
+    Base::push_back(inst);
+}
+
+void
+InstRing::pop_front()
+{
+    front() = nullptr;
+    Base::pop_front();
+    trim();
+}
+
+void
+InstRing::pop_back()
+{
+    back() = nullptr;
+    Base::pop_back();
+    trim();
+}
+
+void
+InstRing::erase(iterator it)
+{
+    assert(it.dereferenceable());
+    *it = nullptr;
+    trim();
+}
+
+void
+InstRing::clear()
+{
+    for (auto &inst : *this)
+        inst = nullptr;
+    flush();
+}
+
+void
+InstRing::trim()
+{
+    while (!empty() && !front())
+        Base::pop_front();
+    while (!empty() && !back())
+        Base::pop_back();
+}
+
+} // namespace o3
+} // namespace gem5
@@ -0,0 +1,84 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_INST_RING_HH__
+#define __CPU_O3_INST_RING_HH__
+
+#include <cstddef>
+
+#include "base/circular_queue.hh"
+#include "cpu/o3/dyn_inst_ptr.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * A program ordered list of in-flight instructions backed by a circular
+ * buffer, so that adding an instruction doesn't allocate a list node and
+ * iterators are plain indices which stay valid until their instruction
+ * is removed.
+ *
+ * Instructions are normally removed from either end of the list. One
+ * removed from the middle leaves a null hole behind, which is reclaimed
+ * once it reaches an end, so code walking the list must skip null
+ * entries. The list is sized up front from the structure it mirrors, and
+ * grows (keeping iterators valid) in the unlikely case it overflows.
+ */
+class InstRing : public CircularQueue<DynInstPtr>
+{
+  private:
+    using Base = CircularQueue<DynInstPtr>;
+
+  public:
+    explicit InstRing(size_t capacity=0);
+    ~InstRing();
+
+    /** Add an instruction at the tail of the list. */
+    void push_back(const DynInstPtr &inst);
+
+    /** Remove the instruction at the head of the list. */
+    void pop_front();
+
+    /** Remove the instruction at the tail of the list. */
+    void pop_back();
+
+    /** Remove the instruction pointed to by an iterator. */
+    void erase(iterator it);
+
+    /** Remove all the instructions. */
+    void clear();
+
+  private:
+    /** Reclaim the holes left at either end of the list. */
+    void trim();
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_INST_RING_HH__
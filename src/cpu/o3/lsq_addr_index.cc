@@ -0,0 +1,103 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+namespace gem5
+{
+
+namespace o3
+{
+
+void
+LSQAddrIndex::init(size_t num_entries, unsigned line_shift)
+{
+    size_t num_buckets = 1;
+    while (num_buckets < 2 * num_entries)
+        num_buckets *= 2;
+
+    buckets.assign(num_buckets, std::vector<Entry>());
+    mask = num_buckets - 1;
+    lineShift = line_shift;
+    numEntries = 0;
+}
+
+void
+LSQAddrIndex::clear()
+{
+    for (auto &b: buckets)
+        b.clear();
+    numEntries = 0;
+}
+
+void
+LSQAddrIndex::insert(Addr addr, unsigned size, size_t idx)
+{
+    const Addr last = lastLine(addr, size);
+    for (Addr line = firstLine(addr); line <= last; line++)
+        bucket(line).push_back({line, idx});
+    numEntries++;
+}
+
+void
+LSQAddrIndex::remove(Addr addr, unsigned size, size_t idx)
+{
+    const Addr last = lastLine(addr, size);
+    for (Addr line = firstLine(addr); line <= last; line++) {
+        auto &b = bucket(line);
+        auto it = std::find_if(b.begin(), b.end(),
+                [line, idx](const Entry &e)
+                { return e.line == line && e.idx == idx; });
+        assert(it != b.end());
+        *it = b.back();
+        b.pop_back();
+    }
+    assert(numEntries > 0);
+    numEntries--;
+}
+
+void
+LSQAddrIndex::find(Addr addr, unsigned size, std::vector<size_t> &idxs) const
+{
+    idxs.clear();
+    const Addr first = firstLine(addr);
+    const Addr last = lastLine(addr, size);
+    for (Addr line = first; line <= last; line++) {
+        for (const auto &e: bucket(line)) {
+            if (e.line == line)
+                idxs.push_back(e.idx);
+        }
+    }
+
+    std::sort(idxs.begin(), idxs.end());
+    if (last != first)
+        idxs.erase(std::unique(idxs.begin(), idxs.end()), idxs.end());
+}
+
+} // namespace o3
+} // namespace gem5
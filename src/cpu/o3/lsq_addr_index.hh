@@ -0,0 +1,108 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Index of the entries of a load or store queue by the lines of memory
+ * they access. It lets the LSQ unit find the entries which may overlap
+ * an access without walking the whole queue. Entries are identified by
+ * their position in the queue, which grows with their age, and they are
+ * hashed by line into a fixed number of buckets sized after the queue so
+ * that the index doesn't allocate once it has warmed up.
+ */
+class LSQAddrIndex
+{
+  public:
+    /**
+     * Size the index.
+     * @param num_entries Number of entries of the indexed queue.
+     * @param line_shift Log2 of the line size entries are indexed by.
+     */
+    void init(size_t num_entries, unsigned line_shift);
+
+    /** Remove all the entries. */
+    void clear();
+
+    /** Add the entry at a queue position for an address range. */
+    void insert(Addr addr, unsigned size, size_t idx);
+
+    /** Remove the entry at a queue position, given its address range. */
+    void remove(Addr addr, unsigned size, size_t idx);
+
+    /**
+     * Find the entries on the lines an address range touches.
+     * @param idxs Queue positions of the entries, oldest first. Entries
+     * on those lines might not overlap the range itself.
+     */
+    void find(Addr addr, unsigned size, std::vector<size_t> &idxs) const;
+
+    /** Check if there are no entries. */
+    bool empty() const { return numEntries == 0; }
+
+  private:
+    struct Entry
+    {
+        Addr line;
+        size_t idx;
+    };
+
+    /** First and last line of an address range. */
+    Addr firstLine(Addr addr) const { return addr >> lineShift; }
+    Addr
+    lastLine(Addr addr, unsigned size) const
+    {
+        return (addr + (size ? size : 1) - 1) >> lineShift;
+    }
+
+    std::vector<Entry> &bucket(Addr line) { return buckets[line & mask]; }
+    const std::vector<Entry> &
+    bucket(Addr line) const
+    {
+        return buckets[line & mask];
+    }
+
+    std::vector<std::vector<Entry>> buckets;
+    Addr mask = 0;
+    unsigned lineShift = 0;
+    size_t numEntries = 0;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_LSQ_ADDR_INDEX_HH__
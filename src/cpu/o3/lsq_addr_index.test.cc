@@ -0,0 +1,147 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+/** Index with 64 byte lines, for a queue of 8 entries. */
+class LSQAddrIndexTest : public testing::Test
+{
+  protected:
+    LSQAddrIndexTest() { index.init(8, 6); }
+
+    /** Queue positions of the entries on the lines of a range. */
+    std::vector<size_t>
+    find(Addr addr, unsigned size)
+    {
+        std::vector<size_t> idxs;
+        index.find(addr, size, idxs);
+        return idxs;
+    }
+
+    LSQAddrIndex index;
+};
+
+} // anonymous namespace
+
+/** A new index finds nothing. */
+TEST_F(LSQAddrIndexTest, Empty)
+{
+    ASSERT_TRUE(index.empty());
+    ASSERT_TRUE(find(0x1000, 8).empty());
+}
+
+/** Entries are found by the accesses to their line, whether they overlap
+ * the access or not, oldest first. */
+TEST_F(LSQAddrIndexTest, SameLine)
+{
+    index.insert(0x1008, 8, 3);
+    index.insert(0x1000, 4, 1);
+    index.insert(0x1030, 8, 2);
+    index.insert(0x1040, 8, 4);
+    ASSERT_FALSE(index.empty());
+
+    ASSERT_EQ(find(0x1000, 8), std::vector<size_t>({1, 2, 3}));
+    ASSERT_EQ(find(0x103f, 1), std::vector<size_t>({1, 2, 3}));
+    ASSERT_EQ(find(0x1040, 1), std::vector<size_t>({4}));
+    ASSERT_TRUE(find(0x2000, 8).empty());
+}
+
+/** Lines falling in the same bucket are told apart. */
+TEST_F(LSQAddrIndexTest, Collision)
+{
+    // 16 buckets of 64 byte lines, so lines 1 KiB apart collide
+    index.insert(0x1000, 8, 0);
+    index.insert(0x1400, 8, 1);
+    ASSERT_EQ(find(0x1000, 8), std::vector<size_t>({0}));
+    ASSERT_EQ(find(0x1400, 8), std::vector<size_t>({1}));
+    ASSERT_TRUE(find(0x1800, 8).empty());
+}
+
+/** An entry straddling two lines is found from both, and an access
+ * straddling two lines finds the entries of both, only once each. */
+TEST_F(LSQAddrIndexTest, Straddling)
+{
+    index.insert(0x103c, 8, 5);
+    index.insert(0x1038, 4, 2);
+    index.insert(0x1040, 4, 6);
+
+    ASSERT_EQ(find(0x1000, 4), std::vector<size_t>({2, 5}));
+    ASSERT_EQ(find(0x1078, 4), std::vector<size_t>({5, 6}));
+    ASSERT_EQ(find(0x1030, 32), std::vector<size_t>({2, 5, 6}));
+
+    // a zero sized access touches the line of its address
+    ASSERT_EQ(find(0x1040, 0), std::vector<size_t>({5, 6}));
+}
+
+/** Removing entries, e.g. squashed ones, removes them from all their
+ * lines, and leaves the other entries in place. */
+TEST_F(LSQAddrIndexTest, Remove)
+{
+    index.insert(0x1000, 8, 0);
+    index.insert(0x103c, 8, 1);
+    index.insert(0x1008, 8, 2);
+    index.insert(0x1044, 8, 3);
+
+    // squash the two youngest entries
+    index.remove(0x1044, 8, 3);
+    index.remove(0x1008, 8, 2);
+    ASSERT_EQ(find(0x1000, 64), std::vector<size_t>({0, 1}));
+    ASSERT_EQ(find(0x1040, 64), std::vector<size_t>({1}));
+
+    // their positions are reused by new entries
+    index.insert(0x1040, 8, 2);
+    ASSERT_EQ(find(0x1040, 8), std::vector<size_t>({1, 2}));
+
+    index.remove(0x103c, 8, 1);
+    ASSERT_EQ(find(0x1000, 8), std::vector<size_t>({0}));
+    ASSERT_EQ(find(0x1040, 8), std::vector<size_t>({2}));
+
+    index.remove(0x1000, 8, 0);
+    index.remove(0x1040, 8, 2);
+    ASSERT_TRUE(index.empty());
+    ASSERT_TRUE(find(0x1000, 128).empty());
+}
+
+/** Clearing the index removes all the entries. */
+TEST_F(LSQAddrIndexTest, Clear)
+{
+    for (size_t i = 0; i < 8; i++)
+        index.insert(0x1000 + 24 * i, 8, i);
+    ASSERT_EQ(find(0x1000, 256).size(), size_t(8));
+
+    index.clear();
+    ASSERT_TRUE(index.empty());
+    ASSERT_TRUE(find(0x1000, 256).empty());
+}
@@ -42,6 +42,7 @@
 #include "cpu/o3/lsq_unit.hh"
 
 #include "arch/generic/debugfaults.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -218,6 +219,14 @@ LSQUnit::init(CPU *cpu_ptr, IEW *iew_ptr, const BaseO3CPUParams &params,
     depCheckShift = params.LSQDepCheckShift;
     checkLoads = params.LSQCheckLoads;
     needsTSO = params.needsTSO;
+    searchPolicy = params.LSQSearch;
+
+    // The index has to be at least as coarse as the dependence checks for
+    // the loads on the lines of an access to include all its conflicts.
+    unsigned index_shift =
+        std::max<unsigned>(floorLog2(cpu->cacheLineSize()), depCheckShift);
+    loadIndex.init(loadQueue.capacity(), index_shift);
+    storeIndex.init(storeQueue.capacity(), index_shift);
 
     resetState();
 }
@@ -514,23 +523,40 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
 
+    // With the index only the loads on the lines of the access need to be
+    // checked, otherwise all of them are, oldest first.
+    const bool indexed = searchPolicy == LSQSearchPolicy::Indexed;
+    if (searchPolicy != LSQSearchPolicy::Linear) {
+        loadIndex.find(inst->effAddr, inst->effSize, indexMatches);
+        indexMatches.erase(indexMatches.begin(),
+                std::lower_bound(indexMatches.begin(), indexMatches.end(),
+                    loadIt.idx()));
+    }
+    const size_t num_loads = indexed ? indexMatches.size() :
+        loadQueue.end().idx() - loadIt.idx();
+
     /** @todo in theory you only need to check an instruction that has executed
      * however, there isn't a good way in the pipeline at the moment to check
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
      */
-    while (loadIt != loadQueue.end()) {
-        DynInstPtr ld_inst = loadIt->instruction();
-        if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
+    for (size_t i = 0; i < num_loads; i++) {
+        const size_t ld_idx = indexed ? indexMatches[i] : loadIt.idx() + i;
+        DynInstPtr ld_inst = loadQueue[ld_idx].instruction();
+        if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered())
             continue;
-        }
 
         Addr ld_eff_addr1 = ld_inst->effAddr >> depCheckShift;
         Addr ld_eff_addr2 =
             (ld_inst->effAddr + ld_inst->effSize - 1) >> depCheckShift;
 
         if (inst_eff_addr2 >= ld_eff_addr1 && inst_eff_addr1 <= ld_eff_addr2) {
+            panic_if(searchPolicy == LSQSearchPolicy::Checked &&
+                    !std::binary_search(indexMatches.begin(),
+                        indexMatches.end(), ld_idx),
+                    "Load [sn:%lli] conflicting with [sn:%lli] is missing "
+                    "from the LQ index\n", ld_inst->seqNum, inst->seqNum);
+
             if (inst->isLoad()) {
                 // If this load is to the same block as an external snoop
                 // invalidate that we've observed then the load needs to be
@@ -578,8 +604,6 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
                     inst->seqNum, ld_inst->seqNum, ld_eff_addr1);
             }
         }
-
-        ++loadIt;
     }
     return NoFault;
 }
@@ -587,6 +611,156 @@ LSQUnit::checkViolations(typename LoadQueue::iterator& loadIt,
 
 
 
+void
+LSQUnit::indexEntry(LSQAddrIndex &index, LSQEntry &entry, size_t idx)
+{
+    const DynInstPtr &inst = entry.instruction();
+    if (entry.indexed()) {
+        if (entry.indexAddr() == inst->effAddr &&
+                entry.indexSize() == inst->effSize) {
+            return;
+        }
+        unindexEntry(index, entry, idx);
+    }
+    index.insert(inst->effAddr, inst->effSize, idx);
+    entry.setIndexed(true, inst->effAddr, inst->effSize);
+}
+
+void
+LSQUnit::unindexEntry(LSQAddrIndex &index, LSQEntry &entry, size_t idx)
+{
+    if (!entry.indexed())
+        return;
+    index.remove(entry.indexAddr(), entry.indexSize(), idx);
+    entry.setIndexed(false);
+}
+
+LSQUnit::AddrRangeCoverage
+LSQUnit::storeCoverage(LSQRequest *request, SQEntry &store)
+{
+    int store_size = store.size();
+
+    // Cache maintenance instructions go down via the store
+    // path but they carry no data and they shouldn't be
+    // considered for forwarding
+    if (store_size == 0 || store.instruction()->strictlyOrdered() ||
+        (store.request()->mainReq() &&
+         store.request()->mainReq()->isCacheMaintenance())) {
+        return AddrRangeCoverage::NoAddrRangeCoverage;
+    }
+
+    assert(store.instruction()->effAddrValid());
+
+    // Check if the store data is within the lower and upper bounds of
+    // addresses that the request needs.
+    auto req_s = request->mainReq()->getVaddr();
+    auto req_e = req_s + request->mainReq()->getSize();
+    auto st_s = store.instruction()->effAddr;
+    auto st_e = st_s + store_size;
+
+    bool store_has_lower_limit = req_s >= st_s;
+    bool store_has_upper_limit = req_e <= st_e;
+    bool lower_load_has_store_part = req_s < st_e;
+    bool upper_load_has_store_part = req_e > st_s;
+
+    auto coverage = AddrRangeCoverage::NoAddrRangeCoverage;
+
+    // If the store entry is not atomic (atomic does not have valid
+    // data), the store has all of the data needed, and
+    // the load is not LLSC, then
+    // we can forward data from the store to the load
+    if (!store.instruction()->isAtomic() &&
+        store_has_lower_limit && store_has_upper_limit &&
+        !request->mainReq()->isLLSC()) {
+
+        const auto& store_req = store.request()->mainReq();
+        coverage = store_req->isMasked() ?
+            AddrRangeCoverage::PartialAddrRangeCoverage :
+            AddrRangeCoverage::FullAddrRangeCoverage;
+    } else if (
+        // This is the partial store-load forwarding case where a store
+        // has only part of the load's data and the load isn't LLSC
+        (!request->mainReq()->isLLSC() &&
+         ((store_has_lower_limit && lower_load_has_store_part) ||
+          (store_has_upper_limit && upper_load_has_store_part) ||
+          (lower_load_has_store_part && upper_load_has_store_part))) ||
+        // The load is LLSC, and the store has all or part of the
+        // load's data
+        (request->mainReq()->isLLSC() &&
+         ((store_has_lower_limit || upper_load_has_store_part) &&
+          (store_has_upper_limit || lower_load_has_store_part))) ||
+        // The store entry is atomic and has all or part of the load's
+        // data
+        (store.instruction()->isAtomic() &&
+         ((store_has_lower_limit || upper_load_has_store_part) &&
+          (store_has_upper_limit || lower_load_has_store_part)))) {
+
+        coverage = AddrRangeCoverage::PartialAddrRangeCoverage;
+    }
+
+    return coverage;
+}
+
+LSQUnit::AddrRangeCoverage
+LSQUnit::findForwardingStore(LSQRequest *request,
+        const DynInstPtr &load_inst, typename StoreQueue::iterator &store_it)
+{
+    auto coverage = AddrRangeCoverage::NoAddrRangeCoverage;
+    auto linear_it = load_inst->sqIt;
+
+    if (searchPolicy != LSQSearchPolicy::Indexed) {
+        // End once we've reached the top of the LSQ
+        while (linear_it != storeWBIt) {
+            // Move the index to one younger
+            linear_it--;
+            assert(linear_it->valid());
+            assert(linear_it->instruction()->seqNum < load_inst->seqNum);
+
+            coverage = storeCoverage(request, *linear_it);
+            if (coverage != AddrRangeCoverage::NoAddrRangeCoverage)
+                break;
+        }
+        if (coverage == AddrRangeCoverage::NoAddrRangeCoverage)
+            linear_it = load_inst->sqIt;
+    }
+
+    if (searchPolicy == LSQSearchPolicy::Linear) {
+        store_it = linear_it;
+        return coverage;
+    }
+
+    // Only the stores between the next one to write back and the load
+    // may forward to it, and only those on the lines it reads may
+    // overlap it. Look for the youngest one which does.
+    auto indexed_coverage = AddrRangeCoverage::NoAddrRangeCoverage;
+    auto indexed_it = load_inst->sqIt;
+    storeIndex.find(request->mainReq()->getVaddr(),
+            request->mainReq()->getSize(), indexMatches);
+    auto match = std::lower_bound(indexMatches.begin(), indexMatches.end(),
+            load_inst->sqIt.idx());
+    while (match != indexMatches.begin() && *(match - 1) >= storeWBIt.idx()) {
+        --match;
+        auto candidate = storeQueue.getIterator(*match);
+        assert(candidate->valid());
+        assert(candidate->instruction()->seqNum < load_inst->seqNum);
+
+        indexed_coverage = storeCoverage(request, *candidate);
+        if (indexed_coverage != AddrRangeCoverage::NoAddrRangeCoverage) {
+            indexed_it = candidate;
+            break;
+        }
+    }
+
+    panic_if(searchPolicy == LSQSearchPolicy::Checked &&
+            (indexed_coverage != coverage || indexed_it != linear_it),
+            "The SQ index found store idx %i instead of %i to forward to "
+            "load [sn:%lli]\n", indexed_it.idx(), linear_it.idx(),
+            load_inst->seqNum);
+
+    store_it = indexed_it;
+    return indexed_coverage;
+}
+
 Fault
 LSQUnit::executeLoad(const DynInstPtr &inst)
 {
@@ -735,6 +909,7 @@ LSQUnit::commitLoad()
                     inst->lastWakeDependents - inst->firstIssue));
     }
 
+    unindexEntry(loadIndex, loadQueue.front(), loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 }
@@ -955,6 +1130,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         }
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        unindexEntry(loadIndex, loadQueue.back(), loadQueue.tail());
         loadQueue.back().clear();
 
         loadQueue.pop_back();
@@ -1026,6 +1202,7 @@ LSQUnit::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        unindexEntry(storeIndex, storeQueue.back(), storeQueue.tail());
         storeQueue.back().clear();
 
         storeQueue.pop_back();
@@ -1150,6 +1327,7 @@ LSQUnit::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            unindexEntry(storeIndex, storeQueue.front(), storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
         } while (storeQueue.front().completed() &&
@@ -1325,6 +1503,9 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
 
     assert(!load_inst->isExecuted());
 
+    if (searchPolicy != LSQSearchPolicy::Linear)
+        indexEntry(loadIndex, load_entry, load_idx);
+
     // Make sure this isn't a strictly ordered load
     // A bit of a hackish way to get strictly ordered accesses to work
     // only if they're at the head of the LSQ and are ready to commit
@@ -1386,184 +1567,119 @@ LSQUnit::read(LSQRequest *request, ssize_t load_idx)
     // Check the SQ for any previous stores that might lead to forwarding
     auto store_it = load_inst->sqIt;
     assert (store_it >= storeWBIt);
-    // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt && !load_inst->isDataPrefetch()) {
-        // Move the index to one younger
-        store_it--;
-        assert(store_it->valid());
-        assert(store_it->instruction()->seqNum < load_inst->seqNum);
-        int store_size = store_it->size();
-
-        // Cache maintenance instructions go down via the store
-        // path but they carry no data and they shouldn't be
-        // considered for forwarding
-        if (store_size != 0 && !store_it->instruction()->strictlyOrdered() &&
-            !(store_it->request()->mainReq() &&
-              store_it->request()->mainReq()->isCacheMaintenance())) {
-            assert(store_it->instruction()->effAddrValid());
-
-            // Check if the store data is within the lower and upper bounds of
-            // addresses that the request needs.
-            auto req_s = request->mainReq()->getVaddr();
-            auto req_e = req_s + request->mainReq()->getSize();
-            auto st_s = store_it->instruction()->effAddr;
-            auto st_e = st_s + store_size;
-
-            bool store_has_lower_limit = req_s >= st_s;
-            bool store_has_upper_limit = req_e <= st_e;
-            bool lower_load_has_store_part = req_s < st_e;
-            bool upper_load_has_store_part = req_e > st_s;
-
-            auto coverage = AddrRangeCoverage::NoAddrRangeCoverage;
-
-            // If the store entry is not atomic (atomic does not have valid
-            // data), the store has all of the data needed, and
-            // the load is not LLSC, then
-            // we can forward data from the store to the load
-            if (!store_it->instruction()->isAtomic() &&
-                store_has_lower_limit && store_has_upper_limit &&
-                !request->mainReq()->isLLSC()) {
-
-                const auto& store_req = store_it->request()->mainReq();
-                coverage = store_req->isMasked() ?
-                    AddrRangeCoverage::PartialAddrRangeCoverage :
-                    AddrRangeCoverage::FullAddrRangeCoverage;
-            } else if (
-                // This is the partial store-load forwarding case where a store
-                // has only part of the load's data and the load isn't LLSC
-                (!request->mainReq()->isLLSC() &&
-                 ((store_has_lower_limit && lower_load_has_store_part) ||
-                  (store_has_upper_limit && upper_load_has_store_part) ||
-                  (lower_load_has_store_part && upper_load_has_store_part))) ||
-                // The load is LLSC, and the store has all or part of the
-                // load's data
-                (request->mainReq()->isLLSC() &&
-                 ((store_has_lower_limit || upper_load_has_store_part) &&
-                  (store_has_upper_limit || lower_load_has_store_part))) ||
-                // The store entry is atomic and has all or part of the load's
-                // data
-                (store_it->instruction()->isAtomic() &&
-                 ((store_has_lower_limit || upper_load_has_store_part) &&
-                  (store_has_upper_limit || lower_load_has_store_part)))) {
-
-                coverage = AddrRangeCoverage::PartialAddrRangeCoverage;
-            }
+    auto coverage = AddrRangeCoverage::NoAddrRangeCoverage;
+    if (!load_inst->isDataPrefetch())
+        coverage = findForwardingStore(request, load_inst, store_it);
+
+    if (coverage == AddrRangeCoverage::FullAddrRangeCoverage) {
+        // Get shift amount for offset into the store's data.
+        int shift_amt = request->mainReq()->getVaddr() -
+            store_it->instruction()->effAddr;
+
+        // Allocate memory if this is the first time a load is issued.
+        if (!load_inst->memData) {
+            load_inst->memData =
+                new uint8_t[request->mainReq()->getSize()];
+        }
+        if (store_it->isAllZeros())
+            memset(load_inst->memData, 0,
+                    request->mainReq()->getSize());
+        else
+            memcpy(load_inst->memData,
+                store_it->data() + shift_amt,
+                request->mainReq()->getSize());
 
-            if (coverage == AddrRangeCoverage::FullAddrRangeCoverage) {
-                // Get shift amount for offset into the store's data.
-                int shift_amt = request->mainReq()->getVaddr() -
-                    store_it->instruction()->effAddr;
+        DPRINTF(LSQUnit, "Forwarding from store idx %i to load to "
+                "addr %#x\n", store_it._idx,
+                request->mainReq()->getVaddr());
 
-                // Allocate memory if this is the first time a load is issued.
-                if (!load_inst->memData) {
-                    load_inst->memData =
-                        new uint8_t[request->mainReq()->getSize()];
-                }
-                if (store_it->isAllZeros())
-                    memset(load_inst->memData, 0,
-                            request->mainReq()->getSize());
-                else
-                    memcpy(load_inst->memData,
-                        store_it->data() + shift_amt,
-                        request->mainReq()->getSize());
-
-                DPRINTF(LSQUnit, "Forwarding from store idx %i to load to "
-                        "addr %#x\n", store_it._idx,
-                        request->mainReq()->getVaddr());
-
-                PacketPtr data_pkt = new Packet(request->mainReq(),
-                        MemCmd::ReadReq);
-                data_pkt->dataStatic(load_inst->memData);
-
-                // hardware transactional memory
-                // Store to load forwarding within a transaction
-                // This should be okay because the store will be sent to
-                // the memory subsystem and subsequently get added to the
-                // write set of the transaction. The write set has a stronger
-                // property than the read set, so the load doesn't necessarily
-                // have to be there.
-                assert(!request->mainReq()->isHTMCmd());
-                if (load_inst->inHtmTransactionalState()) {
-                    assert (!storeQueue[store_it._idx].completed());
-                    assert (
-                        storeQueue[store_it._idx].instruction()->
-                          inHtmTransactionalState());
-                    assert (
-                        load_inst->getHtmTransactionUid() ==
-                        storeQueue[store_it._idx].instruction()->
-                          getHtmTransactionUid());
-                    data_pkt->setHtmTransactional(
-                        load_inst->getHtmTransactionUid());
-                    DPRINTF(HtmCpu, "HTM LD (ST2LDF) "
-                      "pc=0x%lx - vaddr=0x%lx - "
-                      "paddr=0x%lx - htmUid=%u\n",
-                      load_inst->pcState().instAddr(),
-                      data_pkt->req->hasVaddr() ?
-                        data_pkt->req->getVaddr() : 0lu,
-                      data_pkt->getAddr(),
-                      load_inst->getHtmTransactionUid());
-                }
+        PacketPtr data_pkt = new Packet(request->mainReq(),
+                MemCmd::ReadReq);
+        data_pkt->dataStatic(load_inst->memData);
 
-                if (request->isAnyOutstandingRequest()) {
-                    assert(request->_numOutstandingPackets > 0);
-                    // There are memory requests packets in flight already.
-                    // This may happen if the store was not complete the
-                    // first time this load got executed. Signal the senderSate
-                    // that response packets should be discarded.
-                    request->discard();
-                }
+        // hardware transactional memory
+        // Store to load forwarding within a transaction
+        // This should be okay because the store will be sent to
+        // the memory subsystem and subsequently get added to the
+        // write set of the transaction. The write set has a stronger
+        // property than the read set, so the load doesn't necessarily
+        // have to be there.
+        assert(!request->mainReq()->isHTMCmd());
+        if (load_inst->inHtmTransactionalState()) {
+            assert (!storeQueue[store_it._idx].completed());
+            assert (
+                storeQueue[store_it._idx].instruction()->
+                  inHtmTransactionalState());
+            assert (
+                load_inst->getHtmTransactionUid() ==
+                storeQueue[store_it._idx].instruction()->
+                  getHtmTransactionUid());
+            data_pkt->setHtmTransactional(
+                load_inst->getHtmTransactionUid());
+            DPRINTF(HtmCpu, "HTM LD (ST2LDF) "
+              "pc=0x%lx - vaddr=0x%lx - "
+              "paddr=0x%lx - htmUid=%u\n",
+              load_inst->pcState().instAddr(),
+              data_pkt->req->hasVaddr() ?
+                data_pkt->req->getVaddr() : 0lu,
+              data_pkt->getAddr(),
+              load_inst->getHtmTransactionUid());
+        }
 
-                WritebackEvent *wb = new WritebackEvent(load_inst, data_pkt,
-                        this);
-
-                // We'll say this has a 1 cycle load-store forwarding latency
-                // for now.
-                // @todo: Need to make this a parameter.
-                cpu->schedule(wb, curTick());
-
-                // Don't need to do anything special for split loads.
-                ++stats.forwLoads;
-
-                return NoFault;
-            } else if (
-                    coverage == AddrRangeCoverage::PartialAddrRangeCoverage) {
-                // If it's already been written back, then don't worry about
-                // stalling on it.
-                if (store_it->completed()) {
-                    panic("Should not check one of these");
-                    continue;
-                }
+        if (request->isAnyOutstandingRequest()) {
+            assert(request->_numOutstandingPackets > 0);
+            // There are memory requests packets in flight already.
+            // This may happen if the store was not complete the
+            // first time this load got executed. Signal the senderSate
+            // that response packets should be discarded.
+            request->discard();
+        }
 
-                // Must stall load and force it to retry, so long as it's the
-                // oldest load that needs to do so.
-                if (!stalled ||
-                    (stalled &&
-                     load_inst->seqNum <
-                     loadQueue[stallingLoadIdx].instruction()->seqNum)) {
-                    stalled = true;
-                    stallingStoreIsn = store_it->instruction()->seqNum;
-                    stallingLoadIdx = load_idx;
-                }
+        WritebackEvent *wb = new WritebackEvent(load_inst, data_pkt,
+                this);
 
-                // Tell IQ/mem dep unit that this instruction will need to be
-                // rescheduled eventually
-                iewStage->rescheduleMemInst(load_inst);
-                load_inst->clearIssued();
-                load_inst->effAddrValid(false);
-                ++stats.rescheduledLoads;
-
-                // Do not generate a writeback event as this instruction is not
-                // complete.
-                DPRINTF(LSQUnit, "Load-store forwarding mis-match. "
-                        "Store idx %i to load addr %#x\n",
-                        store_it._idx, request->mainReq()->getVaddr());
-
-                // Must discard the request.
-                request->discard();
-                load_entry.setRequest(nullptr);
-                return NoFault;
-            }
+        // We'll say this has a 1 cycle load-store forwarding latency
+        // for now.
+        // @todo: Need to make this a parameter.
+        cpu->schedule(wb, curTick());
+
+        // Don't need to do anything special for split loads.
+        ++stats.forwLoads;
+
+        return NoFault;
+    } else if (coverage == AddrRangeCoverage::PartialAddrRangeCoverage) {
+        // If it's already been written back, then don't worry about
+        // stalling on it.
+        panic_if(store_it->completed(), "Should not check one of these");
+
+        // Must stall load and force it to retry, so long as it's the
+        // oldest load that needs to do so.
+        if (!stalled ||
+            (stalled &&
+             load_inst->seqNum <
+             loadQueue[stallingLoadIdx].instruction()->seqNum)) {
+            stalled = true;
+            stallingStoreIsn = store_it->instruction()->seqNum;
+            stallingLoadIdx = load_idx;
         }
+
+        // Tell IQ/mem dep unit that this instruction will need to be
+        // rescheduled eventually
+        iewStage->rescheduleMemInst(load_inst);
+        load_inst->clearIssued();
+        load_inst->effAddrValid(false);
+        ++stats.rescheduledLoads;
+
+        // Do not generate a writeback event as this instruction is not
+        // complete.
+        DPRINTF(LSQUnit, "Load-store forwarding mis-match. "
+                "Store idx %i to load addr %#x\n",
+                store_it._idx, request->mainReq()->getVaddr());
+
+        // Must discard the request.
+        request->discard();
+        load_entry.setRequest(nullptr);
+        return NoFault;
     }
 
     // If there's no forwarding case, then go access memory
@@ -1612,6 +1728,8 @@ LSQUnit::write(LSQRequest *request, uint8_t *data, ssize_t store_idx)
     storeQueue[store_idx].setRequest(request);
     unsigned size = request->_size;
     storeQueue[store_idx].size() = size;
+    if (searchPolicy != LSQSearchPolicy::Linear)
+        indexEntry(storeIndex, storeQueue[store_idx], store_idx);
     bool store_no_data =
         request->mainReq()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
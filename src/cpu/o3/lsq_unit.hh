@@ -47,6 +47,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <vector>
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
@@ -58,9 +59,11 @@
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
 #include "cpu/o3/lsq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/HtmCpu.hh"
 #include "debug/LSQUnit.hh"
+#include "enums/LSQSearchPolicy.hh"
 #include "mem/packet.hh"
 #include "mem/port.hh"
 
@@ -104,6 +107,11 @@ class LSQUnit
         uint32_t _size = 0;
         /** Valid entry. */
         bool _valid = false;
+        /** Whether the entry is in the address index of its queue. */
+        bool _indexed = false;
+        /** Address range the entry is indexed under. */
+        Addr _indexAddr = 0;
+        unsigned _indexSize = 0;
 
       public:
         ~LSQEntry()
@@ -123,6 +131,7 @@ class LSQUnit
             }
             _request = nullptr;
             _valid = false;
+            _indexed = false;
             _size = 0;
         }
 
@@ -144,7 +153,19 @@ class LSQUnit
         uint32_t& size() { return _size; }
         const uint32_t& size() const { return _size; }
         const DynInstPtr& instruction() const { return _inst; }
+        bool indexed() const { return _indexed; }
+        Addr indexAddr() const { return _indexAddr; }
+        unsigned indexSize() const { return _indexSize; }
         /** @} */
+
+        /** Record the address range the entry is indexed under. */
+        void
+        setIndexed(bool indexed, Addr addr=0, unsigned size=0)
+        {
+            _indexed = indexed;
+            _indexAddr = addr;
+            _indexSize = size;
+        }
     };
 
     class SQEntry : public LSQEntry
@@ -254,6 +275,26 @@ class LSQUnit
     Fault checkViolations(typename LoadQueue::iterator& loadIt,
             const DynInstPtr& inst);
 
+    /** Finds the youngest store older than a load which has some of the
+     * data the load reads.
+     * @param store_it Set to the store, if one is found.
+     * @return How much of the load's data the store has.
+     */
+    AddrRangeCoverage findForwardingStore(LSQRequest *request,
+            const DynInstPtr &load_inst,
+            typename StoreQueue::iterator &store_it);
+
+    /** How much of the data of a load a store can provide. Stores which
+     * can't forward data at all are reported as not covering the load.
+     */
+    AddrRangeCoverage storeCoverage(LSQRequest *request, SQEntry &store);
+
+    /** Adds an entry to or removes it from the address index of its
+     * queue.
+     */
+    void indexEntry(LSQAddrIndex &index, LSQEntry &entry, size_t idx);
+    void unindexEntry(LSQAddrIndex &index, LSQEntry &entry, size_t idx);
+
     /** Check if an incoming invalidate hits in the lsq on a load
      * that might have issued out of order wrt another load beacuse
      * of the intermediate invalidate.
@@ -461,6 +502,20 @@ class LSQUnit
     /** Should loads be checked for dependency issues */
     bool checkLoads;
 
+    /** How the LQ and SQ are searched for forwarding and ordering
+     * violations.
+     */
+    LSQSearchPolicy searchPolicy;
+
+    /** Loads and stores of the queues which have an address, indexed by
+     * the lines they access.
+     */
+    LSQAddrIndex loadIndex;
+    LSQAddrIndex storeIndex;
+
+    /** Scratch space for the positions found in the indices. */
+    std::vector<size_t> indexMatches;
+
     /** The number of store instructions in the SQ waiting to writeback. */
     int storesToWB;
 
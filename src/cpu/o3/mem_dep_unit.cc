@@ -68,18 +68,16 @@ MemDepUnit::~MemDepUnit()
 {
     for (ThreadID tid = 0; tid < MaxThreads; tid++) {
 
-        ListIt inst_list_it = instList[tid].begin();
-
         MemDepHashIt hash_it;
 
         while (!instList[tid].empty()) {
-            hash_it = memDepHash.find((*inst_list_it)->seqNum);
+            hash_it = memDepHash.find(instList[tid].front()->seqNum);
 
             assert(hash_it != memDepHash.end());
 
             memDepHash.erase(hash_it);
 
-            instList[tid].erase(inst_list_it++);
+            instList[tid].pop_front();
         }
     }
 
@@ -99,6 +97,10 @@ MemDepUnit::init(const BaseO3CPUParams &params, ThreadID tid, CPU *cpu)
     depPred.init(params.store_set_clear_period, params.SSITSize,
             params.LFSTSize);
 
+    // Memory instructions leave the list once they complete, so there
+    // can't be more of them than there are instructions in the ROB.
+    instList[tid].reserve(params.numROBEntries);
+
     std::string stats_group_name = csprintf("MemDepUnit__%i", tid);
     cpu->addStatGroup(stats_group_name.c_str(), &stats);
 }
@@ -521,7 +523,7 @@ void
 MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
 {
     if (!instsToReplay.empty()) {
-        ListIt replay_it = instsToReplay.begin();
+        std::list<DynInstPtr>::iterator replay_it = instsToReplay.begin();
         while (replay_it != instsToReplay.end()) {
             if ((*replay_it)->threadNumber == tid &&
                 (*replay_it)->seqNum > squashed_num) {
@@ -532,13 +534,12 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         }
     }
 
-    ListIt squash_it = instList[tid].end();
-    --squash_it;
-
     MemDepHashIt hash_it;
 
     while (!instList[tid].empty() &&
-           (*squash_it)->seqNum > squashed_num) {
+           instList[tid].back()->seqNum > squashed_num) {
+
+        ListIt squash_it = --instList[tid].end();
 
         DPRINTF(MemDepUnit, "Squashing inst [sn:%lli]\n",
                 (*squash_it)->seqNum);
@@ -560,7 +561,7 @@ MemDepUnit::squash(const InstSeqNum &squashed_num, ThreadID tid)
         MemDepEntry::memdep_erase++;
 #endif
 
-        instList[tid].erase(squash_it--);
+        instList[tid].pop_back();
     }
 
     // Tell the dependency predictor to squash as well.
@@ -621,6 +622,12 @@ MemDepUnit::dumpLists()
         int num = 0;
 
         while (inst_list_it != instList[tid].end()) {
+            // Skip the holes left by completed instructions.
+            if (!*inst_list_it) {
+                inst_list_it++;
+                continue;
+            }
+
             cprintf("Instruction:%i\nPC: %s\n[sn:%llu]\n[tid:%i]\nIssued:%i\n"
                     "Squashed:%i\n\n",
                     num, (*inst_list_it)->pcState(),
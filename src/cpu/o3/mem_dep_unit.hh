@@ -50,6 +50,7 @@
 #include "base/statistics.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/o3/dyn_inst_ptr.hh"
+#include "cpu/o3/inst_ring.hh"
 #include "cpu/o3/limits.hh"
 #include "cpu/o3/store_set.hh"
 #include "debug/MemDepUnit.hh"
@@ -169,7 +170,7 @@ class MemDepUnit
     /** Wakes any dependents of a memory instruction. */
     void wakeDependents(const DynInstPtr &inst);
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename InstRing::iterator ListIt;
 
     class MemDepEntry;
 
@@ -230,8 +231,10 @@ class MemDepUnit
     /** A hash map of all memory dependence entries. */
     MemDepHash memDepHash;
 
-    /** A list of all instructions in the memory dependence unit. */
-    std::list<DynInstPtr> instList[MaxThreads];
+    /** A list of all instructions in the memory dependence unit. Completed
+     *  instructions leave null holes behind them until they reach an end.
+     */
+    InstRing instList[MaxThreads];
 
     /** A list of all instructions that are going to be replayed. */
     std::list<DynInstPtr> instsToReplay;
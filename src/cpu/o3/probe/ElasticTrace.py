@@ -59,3 +59,8 @@ class ElasticTrace(ProbeListenerObject):
     # Whether to trace virtual addresses for memory accesses
     traceVirtAddr = Param.Bool(False, "Set to true if virtual addresses are " \
                                 "to be traced.")
+    # Compress and write the traces from separate threads
+    traceBufferSize = Param.MemorySize('0', "Size of the buffers the " \
+                                       "traces are written to separate " \
+                                       "threads through (0 writes from the " \
+                                       "simulation thread)")
@@ -81,9 +81,11 @@ ElasticTrace::ElasticTrace(const ElasticTraceParams &params)
                 "trace file path to dataDepTraceFile");
     std::string filename = simout.resolve(name() + "." +
                                             params.instFetchTraceFile);
-    instTraceStream = new ProtoOutputStream(filename);
+    instTraceStream = new ProtoOutputStream(filename,
+                                            params.traceBufferSize);
     filename = simout.resolve(name() + "." + params.dataDepTraceFile);
-    dataTraceStream = new ProtoOutputStream(filename);
+    dataTraceStream = new ProtoOutputStream(filename,
+                                            params.traceBufferSize);
     // Create a protobuf message for the header and write it to the stream
     ProtoMessage::PacketHeader inst_pkt_header;
     inst_pkt_header.set_obj_id(name());
@@ -166,7 +168,9 @@ ElasticTrace::fetchReqTrace(const RequestPtr &req)
     inst_fetch_pkt.set_addr(req->getPaddr());
     inst_fetch_pkt.set_size(req->getSize());
     // Write the message to the stream.
-    instTraceStream->write(inst_fetch_pkt);
+    stats.instRecords++;
+    if (instTraceStream->write(inst_fetch_pkt))
+        stats.bufferStalls++;
 }
 
 void
@@ -867,7 +871,9 @@ ElasticTrace::writeDepTrace(uint32_t num_to_write)
                 num_filtered_nodes = 0;
             }
             // Write the message to the protobuf output stream
-            dataTraceStream->write(dep_pkt);
+            stats.dataRecords++;
+            if (dataTraceStream->write(dep_pkt))
+                stats.bufferStalls++;
         } else {
             // Don't write the node to the trace but note that we have filtered
             // out a node.
@@ -905,7 +911,13 @@ ElasticTrace::ElasticTraceStats::ElasticTraceStats(statistics::Group *parent)
       ADD_STAT(maxTempStoreSize, statistics::units::Count::get(),
                "Maximum size of the temporary store during the run"),
       ADD_STAT(maxPhysRegDepMapSize, statistics::units::Count::get(),
-               "Maximum size of register dependency map")
+               "Maximum size of register dependency map"),
+      ADD_STAT(dataRecords, statistics::units::Count::get(),
+               "Number of records written to the data dependency trace"),
+      ADD_STAT(instRecords, statistics::units::Count::get(),
+               "Number of records written to the instruction fetch trace"),
+      ADD_STAT(bufferStalls, statistics::units::Count::get(),
+               "Number of records which waited for the trace writer thread")
 {
 }
 
@@ -556,6 +556,15 @@ class ElasticTrace : public ProbeListenerObject
          * register.
          */
         statistics::Scalar maxPhysRegDepMapSize;
+
+        /** Number of records written to the data dependency trace */
+        statistics::Scalar dataRecords;
+
+        /** Number of records written to the instruction fetch trace */
+        statistics::Scalar instRecords;
+
+        /** Number of records which waited for the trace writer thread */
+        statistics::Scalar bufferStalls;
     } stats;
 
 };
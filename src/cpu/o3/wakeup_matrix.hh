@@ -0,0 +1,208 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_WAKEUP_MATRIX_HH__
+#define __CPU_O3_WAKEUP_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace o3
+{
+
+/**
+ * Bit matrix alternative to the consumer chains of the DependencyGraph.
+ * Every instruction waiting on a register gets a slot, and each physical
+ * register has a bitmask of the slots waiting on it, so registering and
+ * waking up dependents doesn't allocate anything. An instruction waiting
+ * on the same register through several of its sources only has one bit
+ * set for it, and its slot is freed once all its bits are cleared.
+ */
+template <class DynInstPtr>
+class WakeupMatrix
+{
+  public:
+    /**
+     * Size the matrix.
+     * @param num_regs Number of physical registers.
+     * @param num_slots Expected number of waiting instructions. The matrix
+     * grows if more instructions end up waiting.
+     */
+    void
+    resize(int num_regs, int num_slots)
+    {
+        numRegs = num_regs;
+        numSlots = 0;
+        consumers.clear();
+        insts.clear();
+        pending.clear();
+        freeSlots.clear();
+        grow(num_slots);
+    }
+
+    /** Clear the matrix. */
+    void reset() { resize(numRegs, numSlots); }
+
+    /** Get a slot to register the dependences of an instruction in. */
+    int
+    allocate(const DynInstPtr &inst)
+    {
+        if (freeSlots.empty())
+            grow(2 * numSlots);
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        insts[slot] = inst;
+        return slot;
+    }
+
+    /** Make the instruction of a slot wait on a register. */
+    void
+    insert(RegIndex idx, int slot)
+    {
+        uint64_t &word = consumers[idx * numWords + slot / 64];
+        const uint64_t bit = 1ULL << (slot % 64);
+        if (!(word & bit)) {
+            word |= bit;
+            pending[slot]++;
+        }
+    }
+
+    /** Stop an instruction from waiting on a register, if it does. */
+    void
+    remove(RegIndex idx, const DynInstPtr &inst)
+    {
+        uint64_t *row = &consumers[idx * numWords];
+        for (int w = 0; w < numWords; w++) {
+            for (uint64_t word = row[w]; word; word &= word - 1) {
+                const int slot = w * 64 + findLsbSet(word);
+                if (insts[slot] == inst) {
+                    clear(row, slot);
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * Remove one of the instructions waiting on a register.
+     * @return The instruction, or null if none is waiting.
+     */
+    DynInstPtr
+    pop(RegIndex idx)
+    {
+        uint64_t *row = &consumers[idx * numWords];
+        for (int w = 0; w < numWords; w++) {
+            if (row[w]) {
+                const int slot = w * 64 + findLsbSet(row[w]);
+                DynInstPtr inst = insts[slot];
+                clear(row, slot);
+                return inst;
+            }
+        }
+        return nullptr;
+    }
+
+    /** Check if no instruction is waiting on a register. */
+    bool
+    empty(RegIndex idx) const
+    {
+        const uint64_t *row = &consumers[idx * numWords];
+        for (int w = 0; w < numWords; w++) {
+            if (row[w])
+                return false;
+        }
+        return true;
+    }
+
+    /** Check if no instruction is waiting on any register. */
+    bool empty() const { return (int)freeSlots.size() == numSlots; }
+
+  private:
+    /** Clear the bit of a slot in a register row. */
+    void
+    clear(uint64_t *row, int slot)
+    {
+        row[slot / 64] &= ~(1ULL << (slot % 64));
+        assert(pending[slot] > 0);
+        if (--pending[slot] == 0) {
+            insts[slot] = nullptr;
+            freeSlots.push_back(slot);
+        }
+    }
+
+    /** Grow the matrix to have at least the given number of slots. */
+    void
+    grow(int num_slots)
+    {
+        const int new_words = std::max(1, (num_slots + 63) / 64);
+        if (numSlots && new_words <= numWords)
+            return;
+
+        std::vector<uint64_t> new_consumers((size_t)numRegs * new_words, 0);
+        for (int r = 0; r < numRegs && numSlots; r++) {
+            for (int w = 0; w < numWords; w++)
+                new_consumers[r * new_words + w] = consumers[r * numWords + w];
+        }
+        consumers.swap(new_consumers);
+
+        const int old_slots = numSlots;
+        numWords = new_words;
+        numSlots = new_words * 64;
+        insts.resize(numSlots);
+        pending.resize(numSlots, 0);
+        // Hand out the lowest slots first.
+        for (int slot = numSlots - 1; slot >= old_slots; slot--)
+            freeSlots.push_back(slot);
+    }
+
+    /** Number of physical registers. */
+    int numRegs = 0;
+    /** Number of slots, a multiple of 64. */
+    int numSlots = 0;
+    /** Number of 64 bit words in the row of a register. */
+    int numWords = 0;
+
+    /** For each register, the bitmask of the slots waiting on it. */
+    std::vector<uint64_t> consumers;
+    /** The instruction of each slot. */
+    std::vector<DynInstPtr> insts;
+    /** The number of registers the instruction of each slot waits on. */
+    std::vector<uint8_t> pending;
+    /** The slots with no instruction. */
+    std::vector<int> freeSlots;
+};
+
+} // namespace o3
+} // namespace gem5
+
+#endif // __CPU_O3_WAKEUP_MATRIX_HH__
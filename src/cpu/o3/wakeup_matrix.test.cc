@@ -0,0 +1,165 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "cpu/o3/wakeup_matrix.hh"
+
+using namespace gem5;
+using namespace gem5::o3;
+
+namespace
+{
+
+/** The wakeup matrix only compares the instructions. */
+struct Inst
+{
+    int id;
+};
+
+typedef WakeupMatrix<Inst *> Matrix;
+
+/** Pop all the instructions waiting on a register, sorted by id. */
+std::vector<int>
+wakeup(Matrix &matrix, RegIndex idx)
+{
+    std::vector<int> ids;
+    while (Inst *inst = matrix.pop(idx))
+        ids.push_back(inst->id);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+} // anonymous namespace
+
+/** A new matrix has no waiting instructions. */
+TEST(WakeupMatrixTest, Empty)
+{
+    Matrix matrix;
+    matrix.resize(8, 16);
+    ASSERT_TRUE(matrix.empty());
+    for (RegIndex idx = 0; idx < 8; idx++) {
+        ASSERT_TRUE(matrix.empty(idx));
+        ASSERT_EQ(matrix.pop(idx), nullptr);
+    }
+}
+
+/** An instruction is woken up by each of its producers, and only leaves
+ * the matrix once the last one has written back. */
+TEST(WakeupMatrixTest, LastProducer)
+{
+    Inst inst{1};
+    Matrix matrix;
+    matrix.resize(8, 16);
+    const int slot = matrix.allocate(&inst);
+    matrix.insert(3, slot);
+    matrix.insert(7, slot);
+    // waiting twice on the same register counts once
+    matrix.insert(7, slot);
+
+    ASSERT_EQ(wakeup(matrix, 3), std::vector<int>({1}));
+    ASSERT_TRUE(matrix.empty(3));
+    ASSERT_FALSE(matrix.empty(7));
+    ASSERT_FALSE(matrix.empty());
+
+    ASSERT_EQ(wakeup(matrix, 7), std::vector<int>({1}));
+    ASSERT_TRUE(matrix.empty(7));
+    ASSERT_TRUE(matrix.empty());
+
+    // the slot is free again
+    Inst other{2};
+    ASSERT_EQ(matrix.allocate(&other), slot);
+}
+
+/** A register wakes up all of its consumers, and only them. */
+TEST(WakeupMatrixTest, Consumers)
+{
+    std::vector<Inst> insts = {{0}, {1}, {2}, {3}};
+    Matrix matrix;
+    matrix.resize(8, 16);
+    for (auto &inst : insts) {
+        const int slot = matrix.allocate(&inst);
+        matrix.insert(inst.id % 2, slot);
+    }
+
+    ASSERT_EQ(wakeup(matrix, 1), std::vector<int>({1, 3}));
+    ASSERT_FALSE(matrix.empty());
+    ASSERT_EQ(wakeup(matrix, 0), std::vector<int>({0, 2}));
+    ASSERT_TRUE(matrix.empty());
+}
+
+/** Squashing an instruction clears its bit in the rows of all the
+ * registers it waits on, and frees its slot, leaving the other
+ * consumers waiting. */
+TEST(WakeupMatrixTest, Squash)
+{
+    Inst squashed{1};
+    Inst kept{2};
+    Matrix matrix;
+    matrix.resize(8, 16);
+    const int slot = matrix.allocate(&squashed);
+    matrix.insert(2, slot);
+    matrix.insert(5, slot);
+    matrix.insert(5, matrix.allocate(&kept));
+
+    matrix.remove(2, &squashed);
+    matrix.remove(5, &squashed);
+    // removing an instruction which does not wait is harmless
+    matrix.remove(6, &squashed);
+
+    ASSERT_TRUE(matrix.empty(2));
+    ASSERT_FALSE(matrix.empty(5));
+
+    // the slot of the squashed instruction is the first one reused
+    Inst next{3};
+    ASSERT_EQ(matrix.allocate(&next), slot);
+
+    ASSERT_EQ(wakeup(matrix, 5), std::vector<int>({2}));
+    ASSERT_TRUE(matrix.empty(5));
+}
+
+/** The matrix grows past its initial number of slots, keeping the
+ * instructions already waiting. */
+TEST(WakeupMatrixTest, Grow)
+{
+    std::vector<Inst> insts(200);
+    Matrix matrix;
+    matrix.resize(4, 16);
+    for (size_t i = 0; i < insts.size(); i++) {
+        insts[i].id = i;
+        matrix.insert(i % 4, matrix.allocate(&insts[i]));
+    }
+
+    for (RegIndex idx = 0; idx < 4; idx++) {
+        const std::vector<int> ids = wakeup(matrix, idx);
+        ASSERT_EQ(ids.size(), size_t(50));
+        for (size_t i = 0; i < ids.size(); i++)
+            ASSERT_EQ(ids[i], int(4 * i + idx));
+    }
+    ASSERT_TRUE(matrix.empty());
+}
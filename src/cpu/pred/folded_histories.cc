@@ -0,0 +1,95 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/folded_histories.hh"
+
+#include <algorithm>
+#include <cassert>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+void
+FoldedHistories::resize(int num_banks)
+{
+    banks = num_banks;
+    size_t size = NumKinds * banks;
+    // Unused histories have an all zero mask so they stay at zero.
+    _comp.assign(size, 0);
+    outBit.assign(size, 0);
+    topBit.assign(size, 0);
+    compMask.assign(size, 0);
+    origLen.assign(size, 0);
+    leaving.assign(size, 0);
+}
+
+void
+FoldedHistories::init(Kind kind, int bank, int original_length,
+                      int compressed_length)
+{
+    assert(compressed_length > 0 && compressed_length < 32);
+    size_t i = at(kind, bank);
+    origLen[i] = original_length;
+    outBit[i] = 1U << (original_length % compressed_length);
+    topBit[i] = 1U << compressed_length;
+    compMask[i] = topBit[i] - 1;
+}
+
+void
+FoldedHistories::update(const uint8_t *h)
+{
+    const size_t size = _comp.size();
+    const uint32_t newest = h[0];
+
+    // Gather the outcomes which drop off the end of each history first,
+    // so the loop below is plain arithmetic on parallel arrays.
+    for (size_t i = 0; i < size; i++)
+        leaving[i] = h[origLen[i]];
+
+    for (size_t i = 0; i < size; i++) {
+        uint32_t comp = (_comp[i] << 1) | newest;
+        comp ^= outBit[i] & -leaving[i];
+        comp ^= (comp & topBit[i]) != 0;
+        _comp[i] = comp & compMask[i];
+    }
+}
+
+void
+FoldedHistories::save(int *dst) const
+{
+    std::copy(_comp.begin(), _comp.end(), dst);
+}
+
+void
+FoldedHistories::restore(const int *src)
+{
+    std::copy(src, src + _comp.size(), _comp.begin());
+}
+
+} // namespace branch_prediction
+} // namespace gem5
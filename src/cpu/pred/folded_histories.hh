@@ -0,0 +1,114 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_FOLDED_HISTORIES_HH__
+#define __CPU_PRED_FOLDED_HISTORIES_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Folded (compressed) global histories of all the partially tagged
+ * tables of a TAGE predictor thread, mixed with the PC to form table
+ * indices and tags. Each table has one history for its index and two
+ * for its tag.
+ *
+ * Folding in the newest outcome is done for every history on every
+ * branch, so they are kept as parallel arrays instead of one object
+ * per history, with the variable shifts turned into precomputed bit
+ * masks. This lets the compiler vectorise update() while giving
+ * exactly the same values as folding each history on its own.
+ */
+class FoldedHistories
+{
+  public:
+    /** The histories kept for each table. */
+    enum Kind
+    {
+        Index,
+        Tag0,
+        Tag1,
+        NumKinds
+    };
+
+    /** Size the arrays for banks 0 to num_banks - 1. */
+    void resize(int num_banks);
+
+    /**
+     * Set up one history.
+     * @param original_length Number of global history bits folded.
+     * @param compressed_length Width of the folded history.
+     */
+    void init(Kind kind, int bank, int original_length,
+              int compressed_length);
+
+    /** Current folded value of a history. */
+    unsigned
+    comp(Kind kind, int bank) const
+    {
+        return _comp[at(kind, bank)];
+    }
+
+    /** Number of global history bits the index history folds. */
+    int origLength(int bank) const { return origLen[at(Index, bank)]; }
+
+    /**
+     * Fold a new outcome into every history.
+     * @param h The global history, newest outcome first.
+     */
+    void update(const uint8_t *h);
+
+    /** Copy every folded value to dst, one bank per int, kind major. */
+    void save(int *dst) const;
+
+    /** Restore the folded values from a copy made by save(). */
+    void restore(const int *src);
+
+  protected:
+    size_t at(Kind kind, int bank) const { return kind * banks + bank; }
+
+    size_t banks = 0;
+    std::vector<uint32_t> _comp;
+    /** Bit the oldest folded outcome leaves through. */
+    std::vector<uint32_t> outBit;
+    /** Bit just past the compressed width. */
+    std::vector<uint32_t> topBit;
+    std::vector<uint32_t> compMask;
+    std::vector<int> origLen;
+    /** Scratch space for the outcomes leaving each history. */
+    std::vector<uint32_t> leaving;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_FOLDED_HISTORIES_HH__
@@ -0,0 +1,216 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/folded_histories.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+/**
+ * Reference implementation folding a single history, one shift at a
+ * time, as TAGE did before the histories were kept in parallel arrays.
+ */
+struct FoldedHistory
+{
+    unsigned comp = 0;
+    int compLength;
+    int origLength;
+    int outpoint;
+
+    void
+    init(int original_length, int compressed_length)
+    {
+        origLength = original_length;
+        compLength = compressed_length;
+        outpoint = original_length % compressed_length;
+    }
+
+    void
+    update(const uint8_t *h)
+    {
+        comp = (comp << 1) | h[0];
+        comp ^= h[origLength] << outpoint;
+        comp ^= (comp >> compLength);
+        comp &= (1ULL << compLength) - 1;
+    }
+};
+
+/** Table geometry of a TAGE configuration. */
+struct Config
+{
+    int nHistoryTables;
+    int minHist;
+    int maxHist;
+    /** Tag width and log2 size of each table, starting at table 1. */
+    std::vector<int> tagWidths;
+    std::vector<int> logSizes;
+};
+
+/** Geometric history lengths, as computed by TAGEBase. */
+std::vector<int>
+historyLengths(const Config &config)
+{
+    const int n = config.nHistoryTables;
+    std::vector<int> lengths(n + 1, 0);
+    lengths[1] = config.minHist;
+    lengths[n] = config.maxHist;
+    for (int i = 2; i < n; i++) {
+        lengths[i] = (int)(((double)config.minHist *
+            std::pow((double)config.maxHist / config.minHist,
+                     (double)(i - 1) / (n - 1))) + 0.5);
+    }
+    return lengths;
+}
+
+/**
+ * Fold num_outcomes random outcomes into the histories of a
+ * configuration with both implementations and compare every folded value
+ * after each outcome.
+ */
+void
+checkConfig(const Config &config, int num_outcomes, unsigned seed)
+{
+    const int n = config.nHistoryTables;
+    const std::vector<int> lengths = historyLengths(config);
+
+    FoldedHistories folded;
+    folded.resize(n + 1);
+    std::vector<FoldedHistory> ref[FoldedHistories::NumKinds];
+    for (auto &histories : ref)
+        histories.resize(n + 1);
+
+    for (int i = 1; i <= n; i++) {
+        const int widths[FoldedHistories::NumKinds] = {
+            config.logSizes[i - 1], config.tagWidths[i - 1],
+            config.tagWidths[i - 1] - 1 };
+        for (int k = 0; k < FoldedHistories::NumKinds; k++) {
+            folded.init(FoldedHistories::Kind(k), i, lengths[i], widths[k]);
+            ref[k][i].init(lengths[i], widths[k]);
+        }
+    }
+
+    // Like the global history of TAGE, the newest outcome is written in
+    // front of the previous ones.
+    std::vector<uint8_t> history(num_outcomes + config.maxHist + 1, 0);
+    std::mt19937 rng(seed);
+    for (int pt = num_outcomes; pt-- > 0;) {
+        history[pt] = rng() & 1;
+        folded.update(&history[pt]);
+        for (int k = 0; k < FoldedHistories::NumKinds; k++) {
+            for (int i = 1; i <= n; i++) {
+                ref[k][i].update(&history[pt]);
+                ASSERT_EQ(folded.comp(FoldedHistories::Kind(k), i),
+                          ref[k][i].comp)
+                    << "kind " << k << " table " << i << " outcome "
+                    << num_outcomes - pt;
+            }
+        }
+    }
+}
+
+/** Widths growing linearly from first to last over num_tables tables. */
+std::vector<int>
+linearWidths(int num_tables, int first, int last)
+{
+    std::vector<int> widths(num_tables);
+    for (int i = 0; i < num_tables; i++)
+        widths[i] = first + (last - first) * i / (num_tables - 1);
+    return widths;
+}
+
+} // anonymous namespace
+
+/** The default TAGE configuration. */
+TEST(FoldedHistoriesTest, TAGE)
+{
+    checkConfig({7, 5, 130, {9, 9, 10, 10, 11, 11, 12},
+                 {9, 9, 9, 9, 9, 9, 9}}, 20000, 1);
+}
+
+/** The LTAGE configuration. */
+TEST(FoldedHistoriesTest, LTAGE)
+{
+    checkConfig({12, 4, 640, {7, 7, 8, 8, 9, 10, 11, 12, 12, 13, 14, 15},
+                 {10, 10, 11, 11, 11, 11, 10, 10, 10, 10, 9, 9}}, 20000, 2);
+}
+
+/** Long histories, as in the 64KB TAGE-SC-L configuration. */
+TEST(FoldedHistoriesTest, LongHistories)
+{
+    checkConfig({36, 6, 3000, linearWidths(36, 8, 15),
+                 linearWidths(36, 13, 9)}, 20000, 3);
+}
+
+/** Narrow and wide folded histories. */
+TEST(FoldedHistoriesTest, Widths)
+{
+    checkConfig({8, 2, 200, linearWidths(8, 2, 31),
+                 linearWidths(8, 31, 1)}, 20000, 4);
+}
+
+/** save() and restore() round trip every folded value. */
+TEST(FoldedHistoriesTest, SaveRestore)
+{
+    FoldedHistories folded;
+    folded.resize(4);
+    for (int i = 1; i < 4; i++) {
+        folded.init(FoldedHistories::Index, i, 10 * i, 7);
+        folded.init(FoldedHistories::Tag0, i, 10 * i, 9);
+        folded.init(FoldedHistories::Tag1, i, 10 * i, 8);
+    }
+
+    std::vector<uint8_t> history(100, 1);
+    for (int pt = 60; pt-- > 40;)
+        folded.update(&history[pt]);
+
+    std::vector<int> saved(FoldedHistories::NumKinds * 4);
+    folded.save(saved.data());
+    for (int k = 0; k < FoldedHistories::NumKinds; k++) {
+        for (int i = 0; i < 4; i++) {
+            ASSERT_EQ(unsigned(saved[k * 4 + i]),
+                      folded.comp(FoldedHistories::Kind(k), i));
+        }
+    }
+
+    for (int pt = 40; pt-- > 0;)
+        folded.update(&history[pt]);
+    folded.restore(saved.data());
+    for (int k = 0; k < FoldedHistories::NumKinds; k++) {
+        for (int i = 0; i < 4; i++) {
+            ASSERT_EQ(unsigned(saved[k * 4 + i]),
+                      folded.comp(FoldedHistories::Kind(k), i));
+        }
+    }
+}
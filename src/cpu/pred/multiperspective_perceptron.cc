@@ -332,10 +332,14 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // branch
     findBest(tid, best_preds);
 
-    // begin computation of the sum for low-confidence branch
-    int bestval = 0;
-
-    for (int i = 0; i < specs.size(); i += 1) {
+    // Gather the signed weight of every feature first. Each feature
+    // hashes its own history, but once the weights are gathered both sums
+    // below are plain reductions the compiler can vectorise. They are
+    // integer sums, so the order doesn't change the result.
+    const size_t num_specs = specs.size();
+    featureVals.resize(num_specs);
+    featureIsBest.assign(num_specs, 0);
+    for (int i = 0; i < num_specs; i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the hash to index the table
         unsigned int hashed_idx = getIndex(tid, bi, spec, i);
@@ -348,22 +352,25 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
         int weight = spec.coeff * ((spec.width == 5) ?
                                    xlat4[counter] : xlat[counter]);
         // apply the sign
-        int val = sign ? -weight : weight;
-        // add the value
-        bi.yout += val;
-        // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
+        featureVals[i] = sign ? -weight : weight;
+    }
+
+    // mark the good features, whose values also go into bestval
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j += 1) {
+            if (best_preds[j] >= 0)
+                featureIsBest[best_preds[j]] = 1;
         }
     }
+
+    // begin computation of the sum for low-confidence branch
+    int sum = 0;
+    int bestval = 0;
+    for (size_t i = 0; i < num_specs; i += 1) {
+        sum += featureVals[i];
+        bestval += featureIsBest[i] ? featureVals[i] : 0;
+    }
+    bi.yout += sum;
     // apply a fudge factor to affect when training is triggered
     bi.yout *= fudge;
     return bestval;
@@ -465,6 +465,11 @@ class MultiperspectivePerceptron : public BPredUnit
      */
     int computeOutput(ThreadID tid, MPPBranchInfo &bi);
 
+    /** Scratch space for computeOutput(): the value of each feature */
+    std::vector<int> featureVals;
+    /** Scratch space for computeOutput(): is a feature one of the best */
+    std::vector<int> featureIsBest;
+
     /**
      * Trains the branch predictor with the given branch and direction
      * @param tid Thread ID of the branch
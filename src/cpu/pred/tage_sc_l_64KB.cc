@@ -206,8 +206,9 @@ uint16_t
 TAGE_SC_L_TAGE_64KB::gtag(ThreadID tid, Addr pc, int bank) const
 {
     // very similar to the TAGE implementation, but w/o shifting the pc
-    int tag = pc ^ threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+    const FoldedHistories &folded = threadHistory[tid].folded;
+    int tag = pc ^ folded.comp(FoldedHistories::Tag0, bank) ^
+              (folded.comp(FoldedHistories::Tag1, bank) << 1);
 
     return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
 }
@@ -0,0 +1,218 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/sampling_controller.hh"
+
+#include <cmath>
+
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "debug/Sampling.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+SamplingController::SamplingController(const Params &p)
+    : SimObject(p),
+      functionalCPUs(p.functional_cpus.begin(), p.functional_cpus.end()),
+      detailedCPUs(p.detailed_cpus.begin(), p.detailed_cpus.end()),
+      functionalInsts(p.period - p.detailed_warmup - p.measurement),
+      warmupInsts(p.detailed_warmup), measureInsts(p.measurement),
+      minSamples(p.min_samples), maxSamples(p.max_samples),
+      zScore(p.z_score), targetError(p.target_error),
+      functionalEvent([this]{ functionalDone(); }, name() + ".functional"),
+      warmupEvent([this]{ warmupDone(); }, name() + ".warmup"),
+      measureEvent([this]{ measureDone(); }, name() + ".measure"),
+      stats(*this)
+{
+    fatal_if(detailedCPUs.empty(), "%s: No detailed CPUs given.", name());
+    fatal_if(p.measurement == 0, "%s: The measurement window is empty.",
+             name());
+    fatal_if(p.period < p.detailed_warmup + p.measurement,
+             "%s: The period is shorter than its detailed windows.", name());
+    fatal_if(functionalInsts && functionalCPUs.size() != detailedCPUs.size(),
+             "%s: Need one functional CPU per detailed CPU.", name());
+}
+
+void
+SamplingController::startup()
+{
+    // With no functional warming the detailed CPUs run the whole time
+    // and no switching is needed.
+    const auto &first = functionalInsts ? functionalCPUs : detailedCPUs;
+    fatal_if(first.front()->switchedOut(),
+             "%s: %s must be active when simulation starts.", name(),
+             first.front()->name());
+
+    if (functionalInsts)
+        startFunctional();
+    else
+        startDetailed();
+}
+
+void
+SamplingController::scheduleAfter(const std::vector<BaseCPU *> &cpus,
+                                  Event &event, Counter insts)
+{
+    ThreadContext *tc = cpus.front()->getContext(0);
+    tc->scheduleInstCountEvent(&event, tc->getCurrentInstCount() + insts);
+}
+
+Counter
+SamplingController::detailedInsts() const
+{
+    Counter insts = 0;
+    for (auto *cpu: detailedCPUs)
+        insts += cpu->totalInsts();
+    return insts;
+}
+
+void
+SamplingController::startFunctional()
+{
+    panic_if(phase == Phase::Done, "%s: Sampling has already finished.",
+             name());
+    DPRINTF(Sampling, "Functional warming for %d instructions.\n",
+            functionalInsts);
+    phase = Phase::Functional;
+    scheduleAfter(functionalCPUs, functionalEvent, functionalInsts);
+}
+
+void
+SamplingController::functionalDone()
+{
+    stats.switches++;
+    exitSimLoop(switchToDetailedCause);
+}
+
+void
+SamplingController::startDetailed()
+{
+    panic_if(phase == Phase::Done, "%s: Sampling has already finished.",
+             name());
+    if (warmupInsts) {
+        DPRINTF(Sampling, "Detailed warming for %d instructions.\n",
+                warmupInsts);
+        phase = Phase::DetailedWarming;
+        scheduleAfter(detailedCPUs, warmupEvent, warmupInsts);
+    } else {
+        warmupDone();
+    }
+}
+
+void
+SamplingController::warmupDone()
+{
+    DPRINTF(Sampling, "Measuring sample %d for %d instructions.\n",
+            count, measureInsts);
+    phase = Phase::Measurement;
+    windowTick = curTick();
+    windowInsts = detailedInsts();
+    scheduleAfter(detailedCPUs, measureEvent, measureInsts);
+}
+
+void
+SamplingController::measureDone()
+{
+    Counter insts = detailedInsts() - windowInsts;
+    Cycles cycles = detailedCPUs.front()->ticksToCycles(
+            curTick() - windowTick);
+    double ipc = cycles ? double(insts) / cycles : 0.0;
+
+    count++;
+    double delta = ipc - mean;
+    mean += delta / count;
+    m2 += delta * (ipc - mean);
+
+    stats.samples++;
+    stats.measuredInsts += insts;
+    stats.measuredCycles += cycles;
+    stats.sampleIpc.sample(ipc);
+
+    DPRINTF(Sampling, "Sample %d: IPC %f, mean %f +/- %f.\n",
+            count, ipc, mean, confidence());
+
+    bool converged = count >= minSamples && targetError > 0 &&
+        mean > 0 && confidence() / mean <= targetError;
+    if (converged || (maxSamples && count >= maxSamples)) {
+        phase = Phase::Done;
+        exitSimLoop(doneCause);
+    } else if (functionalInsts) {
+        stats.switches++;
+        exitSimLoop(switchToFunctionalCause);
+    } else {
+        startDetailed();
+    }
+}
+
+double
+SamplingController::confidence() const
+{
+    if (count < 2)
+        return 0.0;
+    return zScore * std::sqrt(m2 / (count - 1) / count);
+}
+
+SamplingController::SamplingStats::SamplingStats(SamplingController &sc)
+    : statistics::Group(&sc),
+      ADD_STAT(samples, statistics::units::Count::get(),
+               "Number of measurement windows completed"),
+      ADD_STAT(measuredInsts, statistics::units::Count::get(),
+               "Instructions committed in measurement windows"),
+      ADD_STAT(measuredCycles, statistics::units::Cycle::get(),
+               "Cycles spent in measurement windows"),
+      ADD_STAT(switches, statistics::units::Count::get(),
+               "Number of CPU switches requested"),
+      ADD_STAT(sampleIpc, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Cycle>::get(),
+               "Distribution of the IPC of each sample"),
+      ADD_STAT(ipcMean, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Cycle>::get(),
+               "Mean IPC over all samples"),
+      ADD_STAT(ipcStdev, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Cycle>::get(),
+               "Standard deviation of the per sample IPC"),
+      ADD_STAT(ipcConfidence, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Cycle>::get(),
+               "Half width of the confidence interval of the mean IPC"),
+      ADD_STAT(ipcRelativeError, statistics::units::Ratio::get(),
+               "Confidence interval half width relative to the mean IPC")
+{
+    sampleIpc.init(20);
+
+    ipcMean.functor([&sc]() { return sc.mean; });
+    ipcStdev.functor([&sc]() {
+        return sc.count < 2 ? 0.0 : std::sqrt(sc.m2 / (sc.count - 1));
+    });
+    ipcConfidence.functor([&sc]() { return sc.confidence(); });
+    ipcRelativeError.functor([&sc]() {
+        return sc.mean > 0 ? sc.confidence() / sc.mean : 0.0;
+    });
+}
+
+} // namespace gem5
@@ -0,0 +1,160 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SAMPLING_CONTROLLER_HH__
+#define __CPU_SAMPLING_CONTROLLER_HH__
+
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "params/SamplingController.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+class BaseCPU;
+
+/**
+ * Drives SMARTS style sampled simulation. Execution is split into
+ * periods of a fixed number of instructions. Each period starts with
+ * functional warming on the fast CPUs, which keeps caches and predictors
+ * warm, and ends with a detailed warming window followed by a
+ * measurement window on the detailed CPUs.
+ *
+ * Window boundaries are instruction count events on thread 0 of the
+ * active CPUs. The boundary between detailed warming and measurement
+ * doesn't need a CPU switch, so it is handled without leaving the
+ * simulation loop. The other boundaries exit the loop with one of the
+ * causes below so that the Python side can switch CPUs and then call
+ * startDetailed() or startFunctional(). Switching is skipped altogether
+ * when a period has no functional warming.
+ *
+ * Every measurement window yields one IPC sample. The running mean and
+ * its confidence interval are kept as stats, and the controller stops
+ * the run once the interval is tight enough.
+ */
+class SamplingController : public SimObject
+{
+  public:
+    PARAMS(SamplingController);
+    SamplingController(const Params &p);
+
+    /** Exit causes used to hand control back to the Python script. */
+    static constexpr const char *switchToDetailedCause =
+        "sampling: switch to detailed";
+    static constexpr const char *switchToFunctionalCause =
+        "sampling: switch to functional";
+    static constexpr const char *doneCause = "sampling: done";
+
+    void startup() override;
+
+    /** The detailed CPUs have taken over; start detailed warming. */
+    void startDetailed();
+
+    /** The functional CPUs have taken over; start functional warming. */
+    void startFunctional();
+
+    /** Have enough samples been taken? */
+    bool done() const { return phase == Phase::Done; }
+
+    /** Number of measurement windows completed so far. */
+    Counter numSamples() const { return count; }
+
+  protected:
+    enum class Phase
+    {
+        Functional,
+        DetailedWarming,
+        Measurement,
+        Done
+    };
+
+    const std::vector<BaseCPU *> functionalCPUs;
+    const std::vector<BaseCPU *> detailedCPUs;
+
+    /** Instructions of functional warming at the start of a period. */
+    const Counter functionalInsts;
+    const Counter warmupInsts;
+    const Counter measureInsts;
+
+    const Counter minSamples;
+    const Counter maxSamples;
+    const double zScore;
+    const double targetError;
+
+    Phase phase = Phase::Functional;
+
+    /** Tick and instruction count at the start of the current window. */
+    Tick windowTick = 0;
+    Counter windowInsts = 0;
+
+    /** Running moments of the IPC samples (Welford's method). */
+    Counter count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    EventFunctionWrapper functionalEvent;
+    EventFunctionWrapper warmupEvent;
+    EventFunctionWrapper measureEvent;
+
+    /**
+     * Schedule an instruction count event on thread 0 of the first of the
+     * given CPUs.
+     */
+    void scheduleAfter(const std::vector<BaseCPU *> &cpus, Event &event,
+                       Counter insts);
+
+    /** Instructions committed so far by all the detailed CPUs. */
+    Counter detailedInsts() const;
+
+    void functionalDone();
+    void warmupDone();
+    void measureDone();
+
+    /** Half width of the confidence interval of the mean IPC. */
+    double confidence() const;
+
+    struct SamplingStats : public statistics::Group
+    {
+        SamplingStats(SamplingController &sc);
+
+        statistics::Scalar samples;
+        statistics::Scalar measuredInsts;
+        statistics::Scalar measuredCycles;
+        statistics::Scalar switches;
+        statistics::Histogram sampleIpc;
+        statistics::Value ipcMean;
+        statistics::Value ipcStdev;
+        statistics::Value ipcConfidence;
+        statistics::Value ipcRelativeError;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SAMPLING_CONTROLLER_HH__
@@ -61,6 +61,15 @@ class BaseAtomicSimpleCPU(BaseSimpleCPU):
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
 
+    # Decoded straight-line blocks of instructions are replayed without
+    # fetching, translating or decoding them again, which speeds up
+    # functional fast-forwarding. Cached instructions do not access the
+    # instruction cache.
+    block_cache_size = Param.Unsigned(0, "Number of decoded basic blocks "
+        "cached to skip instruction fetch and decode, 0 to disable")
+    block_cache_max_insts = Param.Unsigned(64, "Maximum number of "
+        "instructions in a cached basic block")
+
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
         simpoint.interval = interval
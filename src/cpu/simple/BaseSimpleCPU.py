@@ -38,3 +38,11 @@ class BaseSimpleCPU(BaseCPU):
     cxx_class = 'gem5::BaseSimpleCPU'
 
     branchPred = Param.BranchPredictor(NULL, "Branch Predictor")
+
+    def warmBranchPredictorFor(self, cpu):
+        """Drive the branch predictor of `cpu`, a detailed CPU this one
+        will be switched with, while fast-forwarding. Every control
+        instruction this CPU executes then trains the predictor the
+        detailed CPU uses, so it takes over with warm tables instead of
+        needing a long detailed warmup window."""
+        self.branchPred = cpu.branchPred
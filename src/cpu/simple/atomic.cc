@@ -81,6 +81,9 @@ AtomicSimpleCPU::AtomicSimpleCPU(const BaseAtomicSimpleCPUParams &p)
       simulate_inst_stalls(p.simulate_inst_stalls),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
+      blockCache(this, p.block_cache_size, p.block_cache_max_insts),
+      curBlock(nullptr), curBlockInst(0), curBlockGen(0), curBlockThread(0),
+      recordingBlock(false),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
@@ -149,6 +152,10 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // Memory may have been changed behind our back while drained
+    leaveBlock();
+    blockCache.flush();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -301,6 +308,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
             t_info->thread->getIsaPtr()->handleLockedSnoop(pkt,
                     cacheBlockMask);
         }
+        cpu->blockCache.invalidate(pkt->getAddr(), pkt->getSize());
     }
 
     return 0;
@@ -329,6 +337,9 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
                     cacheBlockMask);
         }
     }
+
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->blockCache.invalidate(pkt->getAddr(), pkt->getSize());
 }
 
 bool
@@ -507,6 +518,11 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+
+                    // Drop the cached code this write may have modified
+                    blockCache.invalidate(req->getPaddr(), req->getSize());
+                    thread->decoder->invalidate(req->getVaddr(),
+                                                req->getSize());
                 }
                 dcache_access = true;
                 panic_if(pkt.isError(), "Data write (%s) failed: %s",
@@ -594,6 +610,8 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         } else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            blockCache.invalidate(req->getPaddr(), req->getSize());
+            thread->decoder->invalidate(req->getVaddr(), req->getSize());
         }
 
         dcache_access = true;
@@ -656,11 +674,25 @@ AtomicSimpleCPU::tick()
         const PCStateBase &pc = thread->pcState();
 
         bool needToFetch = !isRomMicroPC(pc.microPC()) && !curMacroStaticInst;
+        bool newInst = needToFetch && t_info.fetchOffset == 0;
+        if (newInst && blockCache.enabled() && fetchFromBlock(pc))
+            needToFetch = false;
+
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
             fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
                                                  BaseMMU::Execute);
+            if (blockCache.enabled() && fault == NoFault) {
+                if (newInst) {
+                    needToFetch = !lookupBlock(pc);
+                } else if (recordingBlock && (!inBlock() ||
+                        !BasicBlockCache::sameRegion(curBlock->paddr,
+                            ifetch_req->getPaddr()))) {
+                    // The rest of the instruction is in another region
+                    leaveBlock();
+                }
+            }
         }
 
         if (fault == NoFault) {
@@ -683,6 +715,9 @@ AtomicSimpleCPU::tick()
 
             preExecute();
 
+            if (recordingBlock && needToFetch && !t_info.stayAtPC)
+                recordBlockInst();
+
             Tick stall_ticks = 0;
             if (curStaticInst) {
                 fault = curStaticInst->execute(&t_info, traceData);
@@ -704,6 +739,16 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                // The decoding context may change with instructions that
+                // need to be serialized, and syscalls may map new code
+                if (blockCache.enabled() &&
+                        (curStaticInst->isSerializeAfter() ||
+                         curStaticInst->isSquashAfter() ||
+                         curStaticInst->isSyscall())) {
+                    leaveBlock();
+                    blockCache.flush();
+                }
             }
 
             // @todo remove me after debugging with legion done
@@ -727,6 +772,12 @@ AtomicSimpleCPU::tick()
             }
 
         }
+        if (fault != NoFault && blockCache.enabled()) {
+            // Faults may change the decoding context, and syscalls are
+            // emulated as faults on some ISAs
+            leaveBlock();
+            blockCache.flush();
+        }
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
     }
@@ -742,6 +793,80 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+bool
+AtomicSimpleCPU::fetchFromBlock(const PCStateBase &pc)
+{
+    if (!inBlock() || recordingBlock)
+        return false;
+
+    if (curBlockInst == curBlock->insts.size() ||
+            !(*curBlock->insts[curBlockInst].pc == pc)) {
+        leaveBlock();
+        return false;
+    }
+
+    const auto &inst = curBlock->insts[curBlockInst++];
+    threadInfo[curThread]->thread->pcState(*inst.decodedPC);
+    predecodedInst = inst.staticInst;
+    blockCache.countInst();
+    return true;
+}
+
+bool
+AtomicSimpleCPU::lookupBlock(const PCStateBase &pc)
+{
+    const Addr vaddr = pc.instAddr();
+    const Addr paddr =
+        ifetch_req->getPaddr() + (vaddr - ifetch_req->getVaddr());
+
+    if (recordingBlock && inBlock() &&
+            blockCache.canExtend(*curBlock, vaddr, paddr)) {
+        set(recordPC, pc);
+        return false;
+    }
+    leaveBlock();
+
+    BasicBlockCache::Block *block = blockCache.lookup(paddr, pc);
+    if (block) {
+        DPRINTF(SimpleCPU, "Replaying block at %#x (%d insts)\n",
+                paddr, block->insts.size());
+        curBlock = block;
+        curBlockInst = 0;
+        curBlockGen = blockCache.generation();
+        curBlockThread = curThread;
+        return fetchFromBlock(pc);
+    }
+
+    curBlock = blockCache.allocate(vaddr, paddr);
+    curBlockGen = blockCache.generation();
+    curBlockThread = curThread;
+    recordingBlock = true;
+    set(recordPC, pc);
+    return false;
+}
+
+void
+AtomicSimpleCPU::recordBlockInst()
+{
+    // A write may have dropped the block while recording
+    if (!inBlock()) {
+        leaveBlock();
+        return;
+    }
+
+    const StaticInstPtr &inst =
+        curMacroStaticInst ? curMacroStaticInst : curStaticInst;
+    if (!inst)
+        return;
+
+    blockCache.append(*curBlock, *recordPC,
+                      threadInfo[curThread]->thread->pcState(), inst);
+    if (inst->isControl() || !blockCache.canExtend(*curBlock,
+                curBlock->vaddr, curBlock->paddr)) {
+        leaveBlock();
+    }
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
@@ -42,6 +42,7 @@
 #define __CPU_SIMPLE_ATOMIC_HH__
 
 #include "cpu/simple/base.hh"
+#include "cpu/simple/block_cache.hh"
 #include "cpu/simple/exec_context.hh"
 #include "mem/request.hh"
 #include "params/BaseAtomicSimpleCPU.hh"
@@ -106,6 +107,64 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /** Decoded basic blocks used to skip fetch and decode. */
+    BasicBlockCache blockCache;
+
+    /** The block being replayed or recorded, if any. */
+    BasicBlockCache::Block *curBlock;
+
+    /** Index of the next instruction to replay from curBlock. */
+    size_t curBlockInst;
+
+    /** Cache generation curBlock is valid for. */
+    uint64_t curBlockGen;
+
+    /** Thread curBlock is replayed or recorded for. */
+    ThreadID curBlockThread;
+
+    /** True if the decoded instructions are appended to curBlock. */
+    bool recordingBlock;
+
+    /** PC of the instruction being recorded. */
+    std::unique_ptr<PCStateBase> recordPC;
+
+    /** Stop replaying or recording the current block. */
+    void
+    leaveBlock()
+    {
+        curBlock = nullptr;
+        recordingBlock = false;
+    }
+
+    /** Check if curBlock can still be used by the current thread. */
+    bool
+    inBlock() const
+    {
+        return curBlock && curBlockGen == blockCache.generation() &&
+            curBlockThread == curThread;
+    }
+
+    /**
+     * Use the next instruction of the block being replayed if the thread
+     * is at its PC, installing the decoded instruction and the PC the
+     * decoder would have produced.
+     *
+     * @return true if the instruction needs neither fetch nor decode
+     */
+    bool fetchFromBlock(const PCStateBase &pc);
+
+    /**
+     * Called after the translation of the first fetch of an instruction,
+     * either continue recording the current block, start replaying a
+     * cached block or start recording a new one.
+     *
+     * @return true if the instruction needs neither fetch nor decode
+     */
+    bool lookupBlock(const PCStateBase &pc);
+
+    /** Append the instruction that was just decoded to curBlock. */
+    void recordBlockInst();
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
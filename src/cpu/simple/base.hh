@@ -132,6 +132,13 @@ class BaseSimpleCPU : public BaseCPU
 
     std::unique_ptr<PCStateBase> preExecuteTempPC;
 
+    /**
+     * Instruction decoded ahead of time by the CPU model, with the thread's
+     * PC already updated as the decoder would, used by preExecute() instead
+     * of the decoder for the next instruction fetched from memory.
+     */
+    StaticInstPtr predecodedInst;
+
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
@@ -142,6 +149,13 @@ class BaseSimpleCPU : public BaseCPU
 
     void haltContext(ThreadID thread_num) override;
 
+    /**
+     * The branch predictor may be shared with a detailed CPU which takes
+     * over from this one (see warmBranchPredictorFor() in
+     * BaseSimpleCPU.py), so check that no predictions are outstanding.
+     */
+    void switchOut() override;
+
     // statistics
     void resetStats() override;
 
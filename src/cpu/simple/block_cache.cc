@@ -0,0 +1,128 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/block_cache.hh"
+
+#include <algorithm>
+
+namespace gem5
+{
+
+BasicBlockCache::BasicBlockCache(statistics::Group *parent,
+                                 size_t max_blocks, size_t max_insts)
+    : maxBlocks(max_blocks), maxInsts(std::max<size_t>(max_insts, 1)),
+      _generation(0), stats(parent)
+{
+}
+
+BasicBlockCache::Block *
+BasicBlockCache::lookup(Addr paddr, const PCStateBase &pc)
+{
+    auto it = blocks.find(paddr);
+    if (it == blocks.end() || it->second.insts.empty() ||
+            !(*it->second.insts.front().pc == pc)) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+BasicBlockCache::Block *
+BasicBlockCache::allocate(Addr vaddr, Addr paddr)
+{
+    auto it = blocks.find(paddr);
+    if (it != blocks.end()) {
+        // Recycle the block in place, its region is unchanged
+        ++_generation;
+        it->second.vaddr = vaddr;
+        it->second.insts.clear();
+        ++stats.blocks;
+        return &it->second;
+    }
+
+    if (blocks.size() >= maxBlocks)
+        flush();
+
+    Block &block = blocks[paddr];
+    block.vaddr = vaddr;
+    block.paddr = paddr;
+    regions[paddr & ~(regionBytes - 1)].push_back(paddr);
+    ++stats.blocks;
+    return &block;
+}
+
+void
+BasicBlockCache::append(Block &block, const PCStateBase &pc,
+                        const PCStateBase &decoded_pc,
+                        const StaticInstPtr &inst)
+{
+    assert(block.insts.size() < maxInsts);
+    block.insts.push_back(Inst{std::unique_ptr<PCStateBase>(pc.clone()),
+            std::unique_ptr<PCStateBase>(decoded_pc.clone()), inst});
+}
+
+void
+BasicBlockCache::doInvalidate(Addr paddr, Addr size)
+{
+    const Addr end = paddr + std::max<Addr>(size, 1);
+    for (Addr region = paddr & ~(regionBytes - 1); region < end;
+            region += regionBytes) {
+        auto it = regions.find(region);
+        if (it == regions.end())
+            continue;
+
+        for (Addr start : it->second)
+            blocks.erase(start);
+        stats.invalidations += it->second.size();
+        regions.erase(it);
+        ++_generation;
+    }
+}
+
+void
+BasicBlockCache::flush()
+{
+    if (blocks.empty())
+        return;
+
+    blocks.clear();
+    regions.clear();
+    ++_generation;
+    ++stats.flushes;
+}
+
+BasicBlockCache::BlockCacheStats::BlockCacheStats(statistics::Group *parent)
+    : statistics::Group(parent, "blockCache"),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions executed from cached blocks"),
+      ADD_STAT(blocks, statistics::units::Count::get(),
+               "Number of blocks recorded"),
+      ADD_STAT(invalidations, statistics::units::Count::get(),
+               "Number of blocks dropped because their memory was written"),
+      ADD_STAT(flushes, statistics::units::Count::get(),
+               "Number of times the whole cache was flushed")
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,173 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_BLOCK_CACHE_HH__
+#define __CPU_SIMPLE_BLOCK_CACHE_HH__
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/generic/pcstate.hh"
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/static_inst.hh"
+
+namespace gem5
+{
+
+/**
+ * Cache of decoded straight-line blocks of instructions used by the
+ * AtomicSimpleCPU to skip the fetch, translation and decode of
+ * instructions it has already seen.
+ *
+ * A block is keyed by the physical address of its first instruction and
+ * records, for every instruction, the PC state before decode, the PC state
+ * the decoder produced and the decoded instruction. A block only covers a
+ * single aligned region no larger than the smallest page of any ISA, so a
+ * translation of its first instruction is valid for all of them, and ends
+ * at the first control instruction.
+ *
+ * Blocks are dropped when the memory holding them is written and the
+ * whole cache is flushed when it is full or when the CPU state they were
+ * decoded in may have changed. Every removal bumps a generation number so
+ * that users can tell if a block they point to is still alive.
+ */
+class BasicBlockCache
+{
+  public:
+    /** Size of the aligned region a block may span. */
+    static constexpr Addr regionBytes = 4096;
+
+    struct Inst
+    {
+        /** PC state the instruction was fetched at */
+        std::unique_ptr<PCStateBase> pc;
+
+        /** PC state after decoding the instruction */
+        std::unique_ptr<PCStateBase> decodedPC;
+
+        /** The decoded (macro) instruction */
+        StaticInstPtr staticInst;
+    };
+
+    struct Block
+    {
+        /** Virtual and physical address of the first instruction */
+        Addr vaddr;
+        Addr paddr;
+
+        std::vector<Inst> insts;
+    };
+
+    /**
+     * @param parent the CPU owning the cache
+     * @param max_blocks number of blocks held, 0 disables the cache
+     * @param max_insts maximum number of instructions in a block
+     */
+    BasicBlockCache(statistics::Group *parent, size_t max_blocks,
+                    size_t max_insts);
+
+    bool enabled() const { return maxBlocks != 0; }
+
+    /** Generation number, bumped whenever blocks are removed. */
+    uint64_t generation() const { return _generation; }
+
+    /**
+     * Find the block starting at a physical address for a given PC state.
+     *
+     * @return the block, or nullptr if there is no matching block
+     */
+    Block *lookup(Addr paddr, const PCStateBase &pc);
+
+    /**
+     * Start a new empty block at an address, replacing any block already
+     * there. This may flush the cache if it is full.
+     */
+    Block *allocate(Addr vaddr, Addr paddr);
+
+    /** Check if an instruction at the given addresses may join a block. */
+    bool
+    canExtend(const Block &block, Addr vaddr, Addr paddr) const
+    {
+        return block.insts.size() < maxInsts &&
+            sameRegion(block.vaddr, vaddr) && sameRegion(block.paddr, paddr);
+    }
+
+    /** Check if two addresses are in the same region. */
+    static bool
+    sameRegion(Addr a, Addr b)
+    {
+        return (a & ~(regionBytes - 1)) == (b & ~(regionBytes - 1));
+    }
+
+    /** Append a decoded instruction to a block. */
+    void append(Block &block, const PCStateBase &pc,
+                const PCStateBase &decoded_pc, const StaticInstPtr &inst);
+
+    /** Drop the blocks overlapping a range of physical memory. */
+    void
+    invalidate(Addr paddr, Addr size)
+    {
+        // Nothing to do for the writes made before any code was cached
+        if (!regions.empty())
+            doInvalidate(paddr, size);
+    }
+
+    /** Drop all blocks. */
+    void flush();
+
+    /** Count an instruction executed from a block. */
+    void countInst() { ++stats.insts; }
+
+  private:
+    void doInvalidate(Addr paddr, Addr size);
+
+    const size_t maxBlocks;
+    const size_t maxInsts;
+
+    uint64_t _generation;
+
+    /** Blocks by the physical address of their first instruction. */
+    std::unordered_map<Addr, Block> blocks;
+
+    /** Start addresses of the blocks in each physical region. */
+    std::unordered_map<Addr, std::vector<Addr>> regions;
+
+    struct BlockCacheStats : public statistics::Group
+    {
+        BlockCacheStats(statistics::Group *parent);
+
+        statistics::Scalar insts;
+        statistics::Scalar blocks;
+        statistics::Scalar invalidations;
+        statistics::Scalar flushes;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_SIMPLE_BLOCK_CACHE_HH__
@@ -0,0 +1,235 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/branch_trace/branch_trace_tester.hh"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "arch/generic/pcstate.hh"
+#include "base/logging.hh"
+#include "cpu/static_inst.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Length of every instruction in the trace. */
+constexpr int InstWidth = 4;
+using TracePCState = GenericISA::SimplePCState<InstWidth>;
+
+/**
+ * Just enough of a static instruction for the predictor to tell what
+ * kind of branch it is looking at.
+ */
+class TraceBranchInst : public StaticInst
+{
+  public:
+    TraceBranchInst(const char *mnem, bool cond, bool direct, bool call,
+                    bool ret)
+        : StaticInst(mnem, No_OpClass)
+    {
+        flags[IsControl] = true;
+        flags[IsCondControl] = cond;
+        flags[IsUncondControl] = !cond;
+        flags[IsDirectControl] = direct;
+        flags[IsIndirectControl] = !direct;
+        flags[IsCall] = call;
+        flags[IsReturn] = ret;
+    }
+
+    Fault
+    execute(ExecContext *xc, Trace::InstRecord *traceData) const override
+    {
+        panic("Trace branches can't be executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        pc.advance();
+    }
+
+    std::unique_ptr<PCStateBase>
+    buildRetPC(const PCStateBase &cur_pc,
+               const PCStateBase &call_pc) const override
+    {
+        std::unique_ptr<PCStateBase> ret(call_pc.clone());
+        ret->advance();
+        return ret;
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceTester::BranchTraceTester(const Params &p)
+    : SimObject(p), predictor(p.predictor), repeat(p.repeat),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+    // In the same order as Kind.
+    insts.push_back(new TraceBranchInst("cond", true, true, false, false));
+    insts.push_back(new TraceBranchInst("uncond", false, true, false,
+                                        false));
+    insts.push_back(new TraceBranchInst("indirect", false, false, false,
+                                        false));
+    insts.push_back(new TraceBranchInst("call", false, true, true, false));
+    insts.push_back(new TraceBranchInst("icall", false, false, true,
+                                        false));
+    insts.push_back(new TraceBranchInst("ret", false, false, false, true));
+
+    readTrace(p.trace_file, p.max_branches);
+}
+
+void
+BranchTraceTester::readTrace(const std::string &path, Counter max_branches)
+{
+    std::ifstream in(path);
+    fatal_if(!in, "%s: Can't open branch trace %s.", name(), path);
+
+    std::string line;
+    int line_num = 0;
+    while (std::getline(in, line)) {
+        line_num++;
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream fields(line);
+        Branch branch;
+        int taken;
+        std::string kind;
+        fields >> std::hex >> branch.pc >> branch.target >> std::dec >>
+            taken >> kind;
+        fatal_if(fields.fail(), "%s: Malformed branch at %s:%d.", name(),
+                 path, line_num);
+        branch.taken = taken;
+
+        int k = 0;
+        for (; k < (int)Kind::NumKinds; k++) {
+            if (kind == insts[k]->getName())
+                break;
+        }
+        fatal_if(k == (int)Kind::NumKinds,
+                 "%s: Unknown branch kind '%s' at %s:%d.", name(), kind,
+                 path, line_num);
+        branch.kind = Kind(k);
+        // Only conditional branches can fall through.
+        branch.taken |= branch.kind != Kind::Cond;
+
+        trace.push_back(branch);
+        if (max_branches && trace.size() == max_branches)
+            break;
+    }
+
+    inform("%s: Read %d branches from %s.", name(), trace.size(), path);
+}
+
+void
+BranchTraceTester::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+void
+BranchTraceTester::replayOnce()
+{
+    const ThreadID tid = 0;
+    TracePCState pc;
+    TracePCState resolved;
+
+    for (const Branch &branch: trace) {
+        const StaticInstPtr &inst = insts[(int)branch.kind];
+        const InstSeqNum seq_num = nextSeqNum++;
+
+        pc.set(branch.pc);
+        predictor->predict(inst, seq_num, pc, tid);
+
+        resolved.set(branch.taken ? branch.target : branch.pc + InstWidth);
+        if (pc != resolved) {
+            predictor->squash(seq_num, resolved, branch.taken, tid);
+            stats.mispredicts++;
+            if (branch.kind == Kind::Cond)
+                stats.condMispredicts++;
+        }
+        predictor->update(seq_num, tid);
+    }
+
+    stats.branches += trace.size();
+    for (const Branch &branch: trace)
+        stats.condBranches += branch.kind == Kind::Cond;
+}
+
+void
+BranchTraceTester::replay()
+{
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < repeat; i++)
+        replayOnce();
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    stats.hostSeconds += elapsed.count();
+
+    exitSimLoop("branch trace replayed");
+}
+
+BranchTraceTester::BranchTraceStats::BranchTraceStats(
+        statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(condBranches, statistics::units::Count::get(),
+               "Number of conditional branches replayed"),
+      ADD_STAT(mispredicts, statistics::units::Count::get(),
+               "Number of branches whose target was mispredicted"),
+      ADD_STAT(condMispredicts, statistics::units::Count::get(),
+               "Number of mispredicted conditional branches"),
+      ADD_STAT(hostSeconds, statistics::units::Second::get(),
+               "Host time spent replaying the trace"),
+      ADD_STAT(mispredictRate, statistics::units::Ratio::get(),
+               "Fraction of branches mispredicted",
+               mispredicts / branches),
+      ADD_STAT(condMispredictRate, statistics::units::Ratio::get(),
+               "Fraction of conditional branches mispredicted",
+               condMispredicts / condBranches),
+      ADD_STAT(branchRate, statistics::units::Rate<
+                    statistics::units::Count,
+                    statistics::units::Second>::get(),
+               "Branches replayed per host second",
+               branches / hostSeconds)
+{
+}
+
+} // namespace gem5
@@ -0,0 +1,126 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_TESTER_HH__
+#define __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_TESTER_HH__
+
+#include <string>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "base/types.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "params/BranchTraceTester.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Replays a branch trace through a branch predictor, outside of any CPU
+ * model, to measure its accuracy and how much host time it takes per
+ * branch. The whole trace is read into memory before replay starts so
+ * that parsing doesn't show up in the timing.
+ *
+ * The trace is a text file with one branch per line:
+ *
+ *     <pc> <target> <taken> <kind>
+ *
+ * where pc and target are hex addresses, taken is 0 or 1 and kind is one
+ * of cond, uncond, indirect, call, icall (indirect call) or ret. Blank
+ * lines and lines starting with '#' are skipped. Instructions are taken
+ * to be 4 bytes long, so a branch which isn't taken falls through to
+ * pc + 4.
+ *
+ * Each branch is predicted, resolved and committed before the next one,
+ * the same way the simple CPUs drive their predictor.
+ */
+class BranchTraceTester : public SimObject
+{
+  public:
+    PARAMS(BranchTraceTester);
+    BranchTraceTester(const Params &p);
+
+    void startup() override;
+
+  protected:
+    enum class Kind : uint8_t
+    {
+        Cond,
+        Uncond,
+        Indirect,
+        Call,
+        IndirectCall,
+        Return,
+        NumKinds
+    };
+
+    struct Branch
+    {
+        Addr pc;
+        Addr target;
+        bool taken;
+        Kind kind;
+    };
+
+    branch_prediction::BPredUnit *const predictor;
+    const unsigned repeat;
+
+    std::vector<Branch> trace;
+
+    /** A stand in static instruction for each kind of branch. */
+    std::vector<StaticInstPtr> insts;
+
+    /** Sequence number of the next branch sent to the predictor. */
+    InstSeqNum nextSeqNum = 1;
+
+    EventFunctionWrapper replayEvent;
+
+    void readTrace(const std::string &path, Counter max_branches);
+
+    /** Send every branch of the trace through the predictor once. */
+    void replayOnce();
+
+    void replay();
+
+    struct BranchTraceStats : public statistics::Group
+    {
+        BranchTraceStats(statistics::Group *parent);
+
+        statistics::Scalar branches;
+        statistics::Scalar condBranches;
+        statistics::Scalar mispredicts;
+        statistics::Scalar condMispredicts;
+        statistics::Scalar hostSeconds;
+        statistics::Formula mispredictRate;
+        statistics::Formula condMispredictRate;
+        statistics::Formula branchRate;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TESTERS_BRANCH_TRACE_BRANCH_TRACE_TESTER_HH__
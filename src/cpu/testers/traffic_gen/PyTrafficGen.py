@@ -65,10 +65,14 @@ class PyTrafficGen(BaseTrafficGen):
     ]
 
     @cxxMethod(override=True)
-    def createTrace(self, duration, trace_file, addr_offset=0):
+    def createTrace(self, duration, trace_file, addr_offset=0,
+                    start_tick=0, part=0, num_parts=1):
         if buildEnv['HAVE_PROTOBUF']:
             return self.getCCObject().createTrace(duration, trace_file,
-                                                  addr_offset=addr_offset)
+                                                  addr_offset=addr_offset,
+                                                  start_tick=start_tick,
+                                                  part=part,
+                                                  num_parts=num_parts)
         else:
             raise NotImplementedError("Trace playback requires that gem5 "
                                       "was built with protobuf support.")
@@ -327,7 +327,8 @@ class BaseTrafficGen : public ClockedObject
 
     std::shared_ptr<BaseGen> createTrace(
         Tick duration,
-        const std::string& trace_file, Addr addr_offset);
+        const std::string& trace_file, Addr addr_offset,
+        Tick start_tick = 0, unsigned part = 0, unsigned num_parts = 1);
 
   protected:
     void start();
@@ -0,0 +1,136 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/testers/traffic_gen/mapped_trace.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+constexpr char MappedPacketTrace::magic[8];
+
+bool
+MappedPacketTrace::isMapped(const std::string &filename)
+{
+    std::ifstream file(filename, std::ios::in | std::ios::binary);
+    char bytes[sizeof(magic)];
+    return file.read(bytes, sizeof(bytes)) &&
+        std::memcmp(bytes, magic, sizeof(magic)) == 0;
+}
+
+MappedPacketTrace::MappedPacketTrace(const std::string &filename)
+    : fileName(filename), mapping(nullptr), mappingSize(0),
+      records(nullptr), numRecords(0), tickFreq(0)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Could not open trace %s: %s\n", filename,
+             strerror(errno));
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) < 0, "Could not stat trace %s: %s\n", filename,
+             strerror(errno));
+    mappingSize = st.st_size;
+    fatal_if(mappingSize < sizeof(Header), "Trace %s is too short\n",
+             filename);
+
+    mapping = mmap(nullptr, mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    fatal_if(mapping == MAP_FAILED, "Could not map trace %s: %s\n",
+             filename, strerror(errno));
+
+    // Playback is mostly sequential, let the kernel read ahead
+    madvise(mapping, mappingSize, MADV_SEQUENTIAL);
+
+    const Header *header = static_cast<const Header *>(mapping);
+    fatal_if(std::memcmp(header->magic, magic, sizeof(magic)) != 0,
+             "%s is not a mapped packet trace\n", filename);
+    fatal_if(letoh(header->version) != version,
+             "Trace %s has version %d, expected %d\n", filename,
+             letoh(header->version), version);
+    fatal_if(letoh(header->recordSize) != sizeof(Record),
+             "Trace %s has records of %d bytes, expected %d\n", filename,
+             letoh(header->recordSize), sizeof(Record));
+
+    numRecords = letoh(header->numRecords);
+    tickFreq = letoh(header->tickFreq);
+    fatal_if(sizeof(Header) + numRecords * sizeof(Record) > mappingSize,
+             "Trace %s is truncated, expected %d records\n", filename,
+             numRecords);
+
+    records = reinterpret_cast<const Record *>(
+        static_cast<const char *>(mapping) + sizeof(Header));
+}
+
+MappedPacketTrace::~MappedPacketTrace()
+{
+    if (mapping)
+        munmap(mapping, mappingSize);
+}
+
+MappedPacketTrace::Record
+MappedPacketTrace::get(size_t index) const
+{
+    assert(index < numRecords);
+    const Record &raw = records[index];
+
+    Record record;
+    record.tick = letoh(raw.tick);
+    record.addr = letoh(raw.addr);
+    record.size = letoh(raw.size);
+    record.flags = letoh(raw.flags);
+    record.cmd = letoh(raw.cmd);
+    record.reserved = 0;
+    return record;
+}
+
+size_t
+MappedPacketTrace::findTick(Tick tick) const
+{
+    // The records are sorted by tick
+    size_t first = 0;
+    size_t count = numRecords;
+    while (count > 0) {
+        const size_t half = count / 2;
+        if (letoh(records[first + half].tick) < tick) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+} // namespace gem5
@@ -0,0 +1,163 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Declaration of a memory mapped packet trace, which can be replayed
+ * from any tick without reading what comes before.
+ */
+
+#ifndef __CPU_TRAFFIC_GEN_MAPPED_TRACE_HH__
+#define __CPU_TRAFFIC_GEN_MAPPED_TRACE_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+/**
+ * A packet trace in a flat binary format, made of a header followed by
+ * fixed size records sorted by tick. All the fields are little endian.
+ * The file is mapped in memory rather than read, so the records can be
+ * accessed in any order, and as every record has the same size, the
+ * record for a given tick is found by a binary search, without an
+ * index. Different ranges of records can be played by different
+ * generators, each mapping the same file.
+ *
+ * Traces in this format are produced from packet.proto traces by
+ * util/encode_mapped_packet_trace.py.
+ */
+class MappedPacketTrace
+{
+  public:
+    /** Layout of the file header. */
+    struct Header
+    {
+        /** Identifies the format, see magic */
+        char magic[8];
+        /** Version of the format, see version */
+        uint32_t version;
+        /** Size of a record, in bytes */
+        uint32_t recordSize;
+        /** Number of ticks per second the trace was recorded at */
+        uint64_t tickFreq;
+        /** Number of records following the header */
+        uint64_t numRecords;
+        uint64_t reserved[4];
+    };
+
+    /** Layout of a record. */
+    struct Record
+    {
+        /** The time at which the request should be sent */
+        uint64_t tick;
+        /** The address for the request */
+        uint64_t addr;
+        /** The size of the access for the request */
+        uint32_t size;
+        /** Request flags */
+        uint32_t flags;
+        /** Memory command, as MemCmd::Command */
+        uint32_t cmd;
+        uint32_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 64, "Unexpected trace header size");
+    static_assert(sizeof(Record) == 32, "Unexpected trace record size");
+
+    /** Characters identifying the format at the start of the file. */
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 'p', 'k', 't',
+                                      'm'};
+
+    /** Version of the format. */
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Check whether a file is a trace in this format.
+     *
+     * @param filename Path to the file
+     * @return True if the file starts with the magic characters
+     */
+    static bool isMapped(const std::string &filename);
+
+    /**
+     * Map a trace file in memory, checking its header.
+     *
+     * @param filename Path to the file to map
+     */
+    MappedPacketTrace(const std::string &filename);
+
+    ~MappedPacketTrace();
+
+    MappedPacketTrace(const MappedPacketTrace &) = delete;
+    MappedPacketTrace &operator=(const MappedPacketTrace &) = delete;
+
+    /** Number of records in the trace. */
+    size_t size() const { return numRecords; }
+
+    /** Number of ticks per second the trace was recorded at. */
+    uint64_t tickFrequency() const { return tickFreq; }
+
+    /**
+     * Get a record, converted to the host endianness.
+     *
+     * @param index Index of the record, smaller than size()
+     * @return The record
+     */
+    Record get(size_t index) const;
+
+    /**
+     * Find the first record at or after a tick.
+     *
+     * @param tick The tick to look for
+     * @return Index of the record, size() if there is none
+     */
+    size_t findTick(Tick tick) const;
+
+  private:
+    /** Path to the file, for error messages */
+    const std::string fileName;
+
+    /** Start and size of the mapping of the whole file */
+    void *mapping;
+    size_t mappingSize;
+
+    /** The records, following the header */
+    const Record *records;
+
+    /** Number of records in the trace */
+    size_t numRecords;
+
+    /** Number of ticks per second the trace was recorded at */
+    uint64_t tickFreq;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRAFFIC_GEN_MAPPED_TRACE_HH__
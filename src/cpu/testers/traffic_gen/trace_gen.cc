@@ -49,18 +49,48 @@
 namespace gem5
 {
 
-TraceGen::InputStream::InputStream(const std::string& filename)
-    : trace(filename)
+TraceGen::InputStream::InputStream(const std::string& filename,
+                                   Tick start_tick, unsigned part,
+                                   unsigned num_parts)
+    : startTick(start_tick), begin(0), end(0), position(0)
 {
-    init();
+    fatal_if(part >= num_parts, "Invalid part %d of %d for trace %s\n",
+             part, num_parts, filename);
+
+    if (MappedPacketTrace::isMapped(filename)) {
+        mappedTrace.reset(new MappedPacketTrace(filename));
+        init();
+
+        // Split the records from the start tick onwards, every part
+        // keeps the original timing as the ticks are all relative to
+        // the same start tick
+        const size_t first = mappedTrace->findTick(startTick);
+        const size_t count = mappedTrace->size() - first;
+        begin = first + count * part / num_parts;
+        end = first + count * (part + 1) / num_parts;
+        position = begin;
+    } else {
+        fatal_if(num_parts > 1, "Trace %s can only be split in parts "
+                 "in the mapped format\n", filename);
+        protoTrace.reset(new ProtoInputStream(filename));
+        init();
+    }
 }
 
 void
 TraceGen::InputStream::init()
 {
+    if (mappedTrace) {
+        if (mappedTrace->tickFrequency() != sim_clock::Frequency) {
+            panic("Trace was recorded with a different tick frequency %d\n",
+                  mappedTrace->tickFrequency());
+        }
+        return;
+    }
+
     // Create a protobuf message for the header and read it from the stream
     ProtoMessage::PacketHeader header_msg;
-    if (!trace.read(header_msg)) {
+    if (!protoTrace->read(header_msg)) {
         panic("Failed to read packet header from trace\n");
     } else if (header_msg.tick_freq() != sim_clock::Frequency) {
         panic("Trace was recorded with a different tick frequency %d\n",
@@ -71,19 +101,44 @@ TraceGen::InputStream::init()
 void
 TraceGen::InputStream::reset()
 {
-    trace.reset();
+    if (mappedTrace) {
+        // Nothing to reopen, simply go back to the start of the range
+        position = begin;
+        return;
+    }
+
+    protoTrace->reset();
     init();
 }
 
 bool
 TraceGen::InputStream::read(TraceElement& element)
 {
+    if (mappedTrace) {
+        if (position == end)
+            return false;
+
+        const MappedPacketTrace::Record record =
+            mappedTrace->get(position++);
+        element.cmd = MemCmd(record.cmd);
+        element.addr = record.addr;
+        element.blocksize = record.size;
+        element.tick = record.tick - startTick;
+        element.flags = record.flags;
+        return true;
+    }
+
     ProtoMessage::Packet pkt_msg;
-    if (trace.read(pkt_msg)) {
+    while (protoTrace->read(pkt_msg)) {
+        // A protobuf trace can only be read sequentially, so skip
+        // everything before the start tick
+        if (pkt_msg.tick() < startTick)
+            continue;
+
         element.cmd = pkt_msg.cmd();
         element.addr = pkt_msg.addr();
         element.blocksize = pkt_msg.size();
-        element.tick = pkt_msg.tick();
+        element.tick = pkt_msg.tick() - startTick;
         element.flags = pkt_msg.has_flags() ? pkt_msg.flags() : 0;
         return true;
     }
@@ -44,9 +44,12 @@
 #ifndef __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 #define __CPU_TRAFFIC_GEN_TRACE_GEN_HH__
 
+#include <memory>
+
 #include "base/bitfield.hh"
 #include "base/intmath.hh"
 #include "base_gen.hh"
+#include "cpu/testers/traffic_gen/mapped_trace.hh"
 #include "mem/packet.hh"
 #include "proto/protoio.hh"
 
@@ -104,24 +107,46 @@ class TraceGen : public BaseGen
     /**
      * The InputStream encapsulates a trace file and the
      * internal buffers and populates TraceElements based on
-     * the input.
+     * the input. The trace is either a protobuf packet trace, read
+     * sequentially, or a memory mapped packet trace, which can be
+     * started at any tick and split in parts.
      */
     class InputStream
     {
 
       private:
 
-        /// Input file stream for the protobuf trace
-        ProtoInputStream trace;
+        /// Input file stream for a protobuf trace
+        std::unique_ptr<ProtoInputStream> protoTrace;
+
+        /// Mapped trace, used instead of protoTrace if set
+        std::unique_ptr<MappedPacketTrace> mappedTrace;
+
+        /// Tick in the trace the playback starts at
+        const Tick startTick;
+
+        /// Range of mapped trace records to play
+        size_t begin;
+        size_t end;
+
+        /// Index of the next mapped trace record to read
+        size_t position;
 
       public:
 
         /**
-         * Create a trace input stream for a given file name.
+         * Create a trace input stream for a given file name. A
+         * mapped trace is split in num_parts parts with the same
+         * number of packets, of which only the given part is played,
+         * so that a set of generators can replay a trace in parallel.
          *
          * @param filename Path to the file to read from
+         * @param start_tick Tick in the trace to start playing at
+         * @param part Index of the part of the trace to play
+         * @param num_parts Number of parts the trace is split in
          */
-        InputStream(const std::string& filename);
+        InputStream(const std::string& filename, Tick start_tick = 0,
+                    unsigned part = 0, unsigned num_parts = 1);
 
         /**
          * Reset the stream such that it can be played once
@@ -138,7 +163,8 @@ class TraceGen : public BaseGen
         /**
          * Attempt to read a trace element from the stream,
          * and also notify the caller if the end of the file
-         * was reached.
+         * was reached. The tick of the element is relative to the
+         * start tick.
          *
          * @param element Trace element to populate
          * @return True if an element could be read successfully
@@ -156,11 +182,16 @@ class TraceGen : public BaseGen
      * @param _duration duration of this state before transitioning
      * @param trace_file File to read the transactions from
      * @param addr_offset Positive offset to add to trace address
+     * @param start_tick Tick in the trace to start playing at
+     * @param part Index of the part of the trace to play
+     * @param num_parts Number of parts the trace is split in
      */
     TraceGen(SimObject &obj, RequestorID requestor_id, Tick _duration,
-             const std::string& trace_file, Addr addr_offset)
+             const std::string& trace_file, Addr addr_offset,
+             Tick start_tick = 0, unsigned part = 0,
+             unsigned num_parts = 1)
         : BaseGen(obj, requestor_id, _duration),
-          trace(trace_file),
+          trace(trace_file, start_tick, part, num_parts),
           tickOffset(0),
           addrOffset(addr_offset),
           traceComplete(false)
@@ -165,11 +165,22 @@ TrafficGen::parseConfig()
                 if (mode == "TRACE") {
                     std::string traceFile;
                     Addr addrOffset;
+                    Tick startTick = 0;
+                    unsigned part = 0;
+                    unsigned numParts = 1;
 
                     is >> traceFile >> addrOffset;
                     traceFile = resolveFile(traceFile);
 
-                    states[id] = createTrace(duration, traceFile, addrOffset);
+                    // optionally followed by the tick to start at, and
+                    // the part of a mapped trace to play
+                    if ((is >> startTick) && !(is >> part >> numParts)) {
+                        part = 0;
+                        numParts = 1;
+                    }
+
+                    states[id] = createTrace(duration, traceFile, addrOffset,
+                                             startTick, part, numParts);
                     DPRINTF(TrafficGen, "State: %d TraceGen\n", id);
                 } else if (mode == "IDLE") {
                     states[id] = createIdle(duration);
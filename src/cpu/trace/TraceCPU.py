@@ -60,7 +60,11 @@ class TraceCPU(BaseCPU):
         return True
 
     instTraceFile = Param.String("", "Instruction trace file")
-    dataTraceFile = Param.String("", "Data dependency trace file")
+    # The data trace is either the protobuf elastic trace or the dependency
+    # graph precomputed from it by util/elastic_trace_to_graph.py, which is
+    # replayed in place without parsing the trace.
+    dataTraceFile = Param.String("", "Data dependency trace file or "\
+                                 "precomputed dependency graph")
     sizeStoreBuffer = Param.Unsigned(16, "Number of entries in the store "\
         "buffer")
     sizeLoadBuffer = Param.Unsigned(16, "Number of entries in the load buffer")
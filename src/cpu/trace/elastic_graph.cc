@@ -0,0 +1,106 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/trace/elastic_graph.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+bool
+ElasticGraph::isGraph(const std::string &filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    char buf[sizeof(graphMagic)];
+    bool match = read(fd, buf, sizeof(buf)) == sizeof(buf) &&
+        std::memcmp(buf, graphMagic, sizeof(graphMagic)) == 0;
+    close(fd);
+    return match;
+}
+
+ElasticGraph::ElasticGraph(const std::string &_filename)
+    : filename(_filename)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Failed to open elastic graph %s.\n", filename);
+
+    off_t off = lseek(fd, 0, SEEK_END);
+    fatal_if(off < 0, "Failed to determine size of %s.\n", filename);
+    len = static_cast<size_t>(off);
+    fatal_if(len < sizeof(Header), "Elastic graph %s is truncated.\n",
+             filename);
+
+    data = (const uint8_t *)mmap(NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    panic_if(data == MAP_FAILED, "Failed to mmap elastic graph %s.\n",
+             filename);
+
+    header = reinterpret_cast<const Header *>(data);
+    fatal_if(std::memcmp(header->magic, graphMagic,
+                         sizeof(graphMagic)) != 0,
+             "%s is not an elastic graph.\n", filename);
+    fatal_if(header->version != version,
+             "Elastic graph %s has version %d, expected %d.\n",
+             filename, header->version, version);
+
+    const uint64_t n = header->numNodes;
+    const uint64_t e = header->numEdges;
+    const size_t expected = sizeof(Header) + n * sizeof(Node) +
+        2 * (n + 1) * sizeof(uint64_t) + 2 * e * sizeof(uint32_t);
+    fatal_if(len != expected, "Elastic graph %s has %d bytes, expected "
+             "%d for %d nodes and %d edges.\n", filename, len, expected,
+             n, e);
+
+    const uint8_t *p = data + sizeof(Header);
+    nodes = reinterpret_cast<const Node *>(p);
+    p += n * sizeof(Node);
+    depBegin = reinterpret_cast<const uint64_t *>(p);
+    p += (n + 1) * sizeof(uint64_t);
+    childBegin = reinterpret_cast<const uint64_t *>(p);
+    p += (n + 1) * sizeof(uint64_t);
+    deps = reinterpret_cast<const uint32_t *>(p);
+    p += e * sizeof(uint32_t);
+    children = reinterpret_cast<const uint32_t *>(p);
+
+    fatal_if(depBegin[n] != e || childBegin[n] != e,
+             "Elastic graph %s has inconsistent edge offsets.\n", filename);
+}
+
+ElasticGraph::~ElasticGraph()
+{
+    munmap((void *)data, len);
+}
+
+} // namespace gem5
@@ -0,0 +1,144 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_TRACE_ELASTIC_GRAPH_HH__
+#define __CPU_TRACE_ELASTIC_GRAPH_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace gem5
+{
+
+/**
+ * Read-only view of an elastic trace whose dependency graph has been
+ * precomputed offline by util/elastic_trace_to_graph.py. The file is
+ * mapped into memory and used in place: a fixed size header, an array of
+ * fixed size node records and the incoming and outgoing edges of every
+ * node in compressed sparse row form. Nodes are stored in trace order and
+ * edges are encoded as the distance to the other node shifted left by one
+ * with the lowest bit set for order (ROB) dependencies, so the replay
+ * never has to look up a sequence number.
+ */
+class ElasticGraph
+{
+  public:
+    /** Magic identifying a graph file. */
+    static constexpr char graphMagic[8] =
+        {'g', 'e', 'm', '5', 'e', 'g', 'r', 'f'};
+
+    /** Version of the file layout understood by this reader. */
+    static constexpr uint32_t version = 1;
+
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t windowSize;
+        uint64_t tickFreq;
+        uint64_t numNodes;
+        uint64_t numEdges;
+        uint64_t reserved[3];
+    };
+    static_assert(sizeof(Header) == 64, "Unexpected graph header size");
+
+    struct Node
+    {
+        uint64_t seqNum;
+        /** ROB occupancy number, i.e. the running micro-op count. */
+        uint64_t robNum;
+        uint64_t physAddr;
+        uint64_t virtAddr;
+        uint64_t pc;
+        /** Computational delay as recorded, before frequency scaling. */
+        uint64_t compDelay;
+        uint32_t size;
+        uint32_t flags;
+        /** Record type, as in ProtoMessage::InstDepRecord::RecordType. */
+        uint8_t type;
+        uint8_t reserved[7];
+    };
+    static_assert(sizeof(Node) == 64, "Unexpected graph node size");
+
+    /** Decode the node index distance of an edge. */
+    static uint64_t edgeDistance(uint32_t edge) { return edge >> 1; }
+
+    /** True if the edge is an order (ROB) rather than register dependency. */
+    static bool edgeIsRob(uint32_t edge) { return edge & 1; }
+
+    /**
+     * Check whether a file starts with the graph magic. Returns false for
+     * files that cannot be opened, leaving the error to the regular trace
+     * reader.
+     */
+    static bool isGraph(const std::string &filename);
+
+    /** Map the graph file and validate its layout. */
+    ElasticGraph(const std::string &filename);
+    ~ElasticGraph();
+
+    ElasticGraph(const ElasticGraph &) = delete;
+    ElasticGraph &operator=(const ElasticGraph &) = delete;
+
+    uint64_t numNodes() const { return header->numNodes; }
+    uint32_t windowSize() const { return header->windowSize; }
+    uint64_t tickFreq() const { return header->tickFreq; }
+
+    const Node &node(uint64_t idx) const { return nodes[idx]; }
+
+    /** @{ */
+    /** Incoming edges of a node, i.e. its dependencies on older nodes. */
+    const uint32_t *depsBegin(uint64_t idx) const
+    { return deps + depBegin[idx]; }
+    const uint32_t *depsEnd(uint64_t idx) const
+    { return deps + depBegin[idx + 1]; }
+    /** @} */
+
+    /** @{ */
+    /** Outgoing edges of a node sorted by the index of the dependent. */
+    const uint32_t *childrenBegin(uint64_t idx) const
+    { return children + childBegin[idx]; }
+    const uint32_t *childrenEnd(uint64_t idx) const
+    { return children + childBegin[idx + 1]; }
+    /** @} */
+
+  private:
+    std::string filename;
+
+    const uint8_t *data;
+    size_t len;
+
+    const Header *header;
+    const Node *nodes;
+    const uint64_t *depBegin;
+    const uint64_t *childBegin;
+    const uint32_t *deps;
+    const uint32_t *children;
+};
+
+} // namespace gem5
+
+#endif // __CPU_TRACE_ELASTIC_GRAPH_HH__
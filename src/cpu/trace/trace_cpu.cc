@@ -37,6 +37,8 @@
 
 #include "cpu/trace/trace_cpu.hh"
 
+#include <algorithm>
+
 #include "base/compiler.hh"
 #include "sim/sim_exit.hh"
 
@@ -55,8 +57,6 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
         instTraceFile(params.instTraceFile),
         dataTraceFile(params.dataTraceFile),
         icacheGen(*this, ".iside", icachePort, instRequestorID, instTraceFile),
-        dcacheGen(*this, ".dside", dcachePort, dataRequestorID, dataTraceFile,
-                  params),
         icacheNextEvent([this]{ schedIcacheNext(); }, name()),
         dcacheNextEvent([this]{ schedDcacheNext(); }, name()),
         oneTraceComplete(false),
@@ -69,6 +69,17 @@ TraceCPU::TraceCPU(const TraceCPUParams &params)
     // Increment static counter for number of Trace CPUs.
     ++TraceCPU::numTraceCPUs;
 
+    // Replay the data trace from its precomputed dependency graph if it
+    // has been converted, otherwise build the graph from the protobuf trace
+    // on the fly.
+    if (ElasticGraph::isGraph(dataTraceFile)) {
+        dcacheGen = std::make_unique<ElasticGraphGen>(*this, ".dside",
+            dcachePort, dataRequestorID, dataTraceFile, params);
+    } else {
+        dcacheGen = std::make_unique<ElasticDataGen>(*this, ".dside",
+            dcachePort, dataRequestorID, dataTraceFile, params);
+    }
+
     // Check that the python parameters for sizes of ROB, store buffer and
     // load buffer do not overflow the corresponding C++ variables.
     fatal_if(params.sizeROB > UINT16_MAX,
@@ -115,7 +126,7 @@ TraceCPU::init()
     Tick first_icache_tick = icacheGen.init();
 
     // Get the send tick of the first data read/write request
-    Tick first_dcache_tick = dcacheGen.init();
+    Tick first_dcache_tick = dcacheGen->init();
 
     // Set the trace offset as the minimum of that in both traces
     traceOffset = std::min(first_icache_tick, first_dcache_tick);
@@ -130,7 +141,7 @@ TraceCPU::init()
     // We don't need to do this for the icache generator as it will
     // send its first request at the first event and schedule subsequent
     // events using a relative tick delta
-    dcacheGen.adjustInitTraceOffset(traceOffset);
+    dcacheGen->adjustInitTraceOffset(traceOffset);
 
     // If the Trace CPU simulation is configured to exit on any one trace
     // completion then we don't need a counted event to count down all Trace
@@ -178,8 +189,8 @@ TraceCPU::schedDcacheNext()
     // Update stat for numCycles
     baseStats.numCycles = clockEdge() / clockPeriod();
 
-    dcacheGen.execute();
-    if (dcacheGen.isExecComplete()) {
+    dcacheGen->execute();
+    if (dcacheGen->isExecComplete()) {
         checkAndSchedExitEvent();
     }
 }
@@ -221,9 +232,8 @@ TraceCPU::checkAndSchedExitEvent()
     cpi.precision(6);
 }
 
-TraceCPU::ElasticDataGen::
-ElasticDataGenStatGroup::ElasticDataGenStatGroup(statistics::Group *parent,
-                                                 const std::string& _name) :
+TraceCPU::ElasticDataGenStatGroup::ElasticDataGenStatGroup(
+        statistics::Group *parent, const std::string& _name) :
     statistics::Group(parent, _name.c_str()),
     ADD_STAT(maxDependents, statistics::units::Count::get(),
              "Max number of dependents observed on a node"),
@@ -504,7 +514,8 @@ TraceCPU::ElasticDataGen::execute()
         // marked complete so it is safe to delete it.
         if (!node_ptr->isLoad() || node_ptr->isStrictlyOrdered()) {
             // Release all resources occupied by the completed node
-            hwResource.release(node_ptr);
+            hwResource.release(node_ptr->seqNum, node_ptr->type,
+                               node_ptr->isStrictlyOrdered());
             // clear the dynamically allocated set of dependents
             (node_ptr->dependents).clear();
             // Update the stat for numOps simulated
@@ -551,7 +562,9 @@ TraceCPU::ElasticDataGen::execute()
                 next_event_tick);
         owner.schedDcacheNextEvent(next_event_tick);
     } else if (readyList.empty() && !depFreeQueue.empty() &&
-                hwResource.isAvailable(depFreeQueue.front())) {
+                hwResource.isAvailable(depFreeQueue.front()->seqNum,
+                                       depFreeQueue.front()->robNum,
+                                       depFreeQueue.front()->type)) {
         DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
                 owner.clockEdge(Cycles(1)));
         owner.schedDcacheNextEvent(owner.clockEdge(Cycles(1)));
@@ -657,7 +670,8 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
     }
 
     // Check if resources are available to issue the specific node
-    if (hwResource.isAvailable(node_ptr)) {
+    if (hwResource.isAvailable(node_ptr->seqNum, node_ptr->robNum,
+                               node_ptr->type)) {
         // If resources are free only then add to readyList
         DPRINTFR(TraceCPUData, "\t\tResources available for seq. num %lli. "
                 "Adding to readyList, occupying resources.\n",
@@ -667,7 +681,8 @@ TraceCPU::ElasticDataGen::checkAndIssue(const GraphNode* node_ptr, bool first)
         addToSortedReadyList(node_ptr->seqNum,
                              owner.clockEdge() + node_ptr->compDelay);
         // Account for the resources taken up by this issued node.
-        hwResource.occupy(node_ptr);
+        hwResource.occupy(node_ptr->seqNum, node_ptr->robNum,
+                          node_ptr->type);
         return true;
     } else {
         if (first) {
@@ -702,7 +717,8 @@ TraceCPU::ElasticDataGen::completeMemAccess(PacketPtr pkt)
         GraphNode* node_ptr = graph_itr->second;
 
         // Release resources occupied by the load
-        hwResource.release(node_ptr);
+        hwResource.release(node_ptr->seqNum, node_ptr->type,
+                           node_ptr->isStrictlyOrdered());
 
         DPRINTF(TraceCPUData, "Load seq. num %lli response received. Waking up"
                 " dependents..\n", node_ptr->seqNum);
@@ -828,7 +844,442 @@ TraceCPU::ElasticDataGen::printReadyList()
     }
 }
 
-TraceCPU::ElasticDataGen::HardwareResource::HardwareResource(
+TraceCPU::ElasticGraphGen::ElasticGraphGen(TraceCPU& _owner,
+        const std::string& _name, RequestPort& _port,
+        RequestorID requestor_id, const std::string& trace_file,
+        const TraceCPUParams &params) :
+    owner(_owner),
+    port(_port),
+    requestorId(requestor_id),
+    graph(trace_file),
+    timeMultiplier(1.0 / params.freqMultiplier),
+    genName(owner.name() + ".elastic." + _name),
+    retryPkt(nullptr),
+    traceComplete(false),
+    nextRead(false),
+    execComplete(false),
+    windowSize(graph.windowSize()),
+    hwResource(params.sizeROB, params.sizeStoreBuffer,
+               params.sizeLoadBuffer),
+    numRead(0),
+    base(0),
+    numLive(0),
+    elasticStats(&_owner, _name)
+{
+    DPRINTF(TraceCPUData, "Replaying dependency graph with %d nodes, "
+            "window size %d.\n", graph.numNodes(), windowSize);
+}
+
+Tick
+TraceCPU::ElasticGraphGen::init()
+{
+    DPRINTF(TraceCPUData, "Initializing data memory request generator "
+            "DcacheGen: elastic issue with retry from dependency graph.\n");
+
+    panic_if(!readNextWindow(),
+            "Trace has %d elements. It must have at least %d elements.",
+            numLive, 2 * windowSize);
+    panic_if(!readNextWindow(),
+            "Trace has %d elements. It must have at least %d elements.",
+            numLive, 2 * windowSize);
+
+    if (debug::TraceCPUData) {
+        printReadyList();
+    }
+    const ReadyNode &first = readyList.front();
+    DPRINTF(TraceCPUData,
+            "Execute tick of the first dependency free node %lli is %d.\n",
+            first.seqNum, first.execTick);
+    return first.execTick;
+}
+
+void
+TraceCPU::ElasticGraphGen::adjustInitTraceOffset(Tick& offset)
+{
+    // Shifting every tick by the same amount keeps the heap ordered
+    for (auto& ready_node : readyList) {
+        ready_node.execTick -= offset;
+    }
+}
+
+void
+TraceCPU::ElasticGraphGen::exit()
+{
+}
+
+bool
+TraceCPU::ElasticGraphGen::readNextWindow()
+{
+    DPRINTF(TraceCPUData, "Reading next window from graph.\n");
+
+    if (traceComplete) {
+        return false;
+    }
+
+    uint32_t num_read = 0;
+    while (num_read != windowSize) {
+        if (numRead == graph.numNodes()) {
+            DPRINTF(TraceCPUData, "\tTrace complete!\n");
+            traceComplete = true;
+            return false;
+        }
+
+        // Only the parents that are still in flight hold the new node back,
+        // the others completed before it was read.
+        const uint64_t idx = numRead;
+        NodeState new_state{0, 0, false};
+        for (auto it = graph.depsBegin(idx); it != graph.depsEnd(idx); ++it) {
+            const uint64_t parent = idx - ElasticGraph::edgeDistance(*it);
+            if (isLive(parent)) {
+                ++new_state.pending;
+                auto num_depts = ++state(parent).numDependents;
+                elasticStats.maxDependents = std::max<double>(num_depts,
+                                        elasticStats.maxDependents.value());
+            }
+        }
+
+        states.push_back(new_state);
+        ++numRead;
+        ++numLive;
+        num_read++;
+        if (new_state.pending == 0) {
+            checkAndIssue(idx);
+        }
+    }
+
+    DPRINTF(TraceCPUData, "End read: %d nodes in flight.\n", numLive);
+    return true;
+}
+
+void
+TraceCPU::ElasticGraphGen::execute()
+{
+    DPRINTF(TraceCPUData, "Execute start occupancy:\n");
+    DPRINTFR(TraceCPUData, "\tnodes = %d, readyList = %d, "
+            "depFreeQueue = %d ,", numLive, readyList.size(),
+            depFreeQueue.size());
+    hwResource.printOccupancy();
+
+    if (nextRead) {
+        readNextWindow();
+        nextRead = false;
+    }
+
+    while (!depFreeQueue.empty()) {
+        if (checkAndIssue(depFreeQueue.front(), false)) {
+            depFreeQueue.pop();
+        } else {
+            break;
+        }
+    }
+
+    // A node that failed to send stays ahead of all others until its retry
+    // succeeds, exactly as at the head of ElasticDataGen's readyList.
+    while (retryPkt ||
+           (!readyList.empty() && readyList.front().execTick <= curTick())) {
+        ReadyNode ready;
+        if (retryPkt) {
+            ready = retryNode;
+            panic_if(retryPkt->req->getReqInstSeqNum() != ready.seqNum,
+                     "Retry packet's seqence number does not match "
+                     "the node that created it.\n");
+            if (!port.sendTimingReq(retryPkt)) {
+                break;
+            }
+            ++elasticStats.numRetrySucceeded;
+            retryPkt = nullptr;
+        } else {
+            std::pop_heap(readyList.begin(), readyList.end(), LaterReady());
+            ready = readyList.back();
+            readyList.pop_back();
+            const auto &node = graph.node(ready.idx);
+            if (node.type == Record::LOAD || node.type == Record::STORE) {
+                retryPkt = executeMemReq(ready.idx);
+                if (retryPkt) {
+                    retryNode = ready;
+                    break;
+                }
+            }
+        }
+
+        const uint64_t idx = ready.idx;
+        const auto &node = graph.node(idx);
+        const bool strictly_ordered =
+            Request::Flags(node.flags).isSet(Request::STRICT_ORDER);
+        if (node.type == Record::LOAD && !strictly_ordered) {
+            // Sending the load completes the order dependencies of the
+            // nodes read so far, except those of stores. The remaining
+            // dependencies complete with the response.
+            DPRINTF(TraceCPUData,
+                    "Node seq. num %lli sent. Waking up dependents..\n",
+                    node.seqNum);
+            for (auto it = graph.childrenBegin(idx);
+                 it != graph.childrenEnd(idx); ++it) {
+                const uint64_t child = idx + ElasticGraph::edgeDistance(*it);
+                if (child >= numRead)
+                    break;
+                if (ElasticGraph::edgeIsRob(*it) &&
+                    graph.node(child).type != Record::STORE) {
+                    --state(idx).numDependents;
+                    releaseDep(child);
+                }
+            }
+            sentLoads[node.seqNum] = SentLoad{idx, numRead};
+        } else {
+            DPRINTF(TraceCPUData, "Node seq. num %lli done. Waking"
+                    " up dependents..\n", node.seqNum);
+            for (auto it = graph.childrenBegin(idx);
+                 it != graph.childrenEnd(idx); ++it) {
+                const uint64_t child = idx + ElasticGraph::edgeDistance(*it);
+                if (child >= numRead)
+                    break;
+                releaseDep(child);
+            }
+            retire(idx);
+        }
+    }
+
+    if (debug::TraceCPUData) {
+        printReadyList();
+        DPRINTF(TraceCPUData, "Execute end occupancy:\n");
+        DPRINTFR(TraceCPUData, "\tnodes = %d, readyList = %d, "
+                "depFreeQueue = %d ,", numLive, readyList.size(),
+                depFreeQueue.size());
+        hwResource.printOccupancy();
+    }
+
+    if (retryPkt) {
+        DPRINTF(TraceCPUData, "Not scheduling an event as expecting a retry"
+                "event from the cache for seq. num %lli.\n",
+                retryPkt->req->getReqInstSeqNum());
+        return;
+    }
+
+    if (numLive < windowSize && !traceComplete)
+        nextRead = true;
+
+    if (!readyList.empty()) {
+        Tick next_event_tick = std::max(readyList.front().execTick,
+                                        curTick());
+        DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
+                next_event_tick);
+        owner.schedDcacheNextEvent(next_event_tick);
+    } else if (!depFreeQueue.empty()) {
+        const auto &pending = graph.node(depFreeQueue.front());
+        if (hwResource.isAvailable(pending.seqNum, pending.robNum,
+                                   RecordType(pending.type))) {
+            DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
+                    owner.clockEdge(Cycles(1)));
+            owner.schedDcacheNextEvent(owner.clockEdge(Cycles(1)));
+        }
+    }
+
+    if (numLive == 0 && readyList.empty() && traceComplete &&
+        !hwResource.awaitingResponse()) {
+        DPRINTF(TraceCPUData, "\tExecution Complete!\n");
+        execComplete = true;
+        elasticStats.dataLastTick = curTick();
+    }
+}
+
+PacketPtr
+TraceCPU::ElasticGraphGen::executeMemReq(uint64_t idx)
+{
+    const auto &node = graph.node(idx);
+    const Request::Flags flags = node.flags;
+    DPRINTF(TraceCPUData, "Executing memory request %lli (phys addr %d, "
+            "virt addr %d, pc %#x, size %d, flags %d).\n",
+            node.seqNum, node.physAddr, node.virtAddr, node.pc, node.size,
+            node.flags);
+
+    if (flags.isSet(Request::STRICT_ORDER)) {
+        node.type == Record::LOAD ? ++elasticStats.numSOLoads :
+             ++elasticStats.numSOStores;
+        DPRINTF(TraceCPUData, "Skipping strictly ordered request %lli.\n",
+                node.seqNum);
+        return nullptr;
+    }
+
+    // Truncate requests spanning two cache lines, see ElasticDataGen
+    unsigned size = node.size;
+    unsigned blk_size = owner.cacheLineSize();
+    Addr blk_offset = (node.physAddr & (Addr)(blk_size - 1));
+    if (!(blk_offset + size <= blk_size)) {
+        size = blk_size - blk_offset;
+        ++elasticStats.numSplitReqs;
+    }
+
+    auto req = std::make_shared<Request>(
+        node.physAddr, size, flags, requestorId);
+    req->setReqInstSeqNum(node.seqNum);
+    req->setContext(ContextID(0));
+    req->setPC(node.pc);
+    if (node.virtAddr != 0) {
+        req->setVirt(node.virtAddr, size, flags, requestorId, node.pc);
+        req->setPaddr(node.physAddr);
+        req->setReqInstSeqNum(node.seqNum);
+    }
+
+    PacketPtr pkt;
+    uint8_t* pkt_data = new uint8_t[req->getSize()];
+    if (node.type == Record::LOAD) {
+        pkt = Packet::createRead(req);
+    } else {
+        pkt = Packet::createWrite(req);
+        memset(pkt_data, 0xA, req->getSize());
+    }
+    pkt->dataDynamic(pkt_data);
+
+    bool success = port.sendTimingReq(pkt);
+    ++elasticStats.numSendAttempted;
+
+    if (!success) {
+        ++elasticStats.numSendFailed;
+        DPRINTF(TraceCPUData, "Send failed. Saving packet for retry.\n");
+        return pkt;
+    } else {
+        ++elasticStats.numSendSucceeded;
+        return nullptr;
+    }
+}
+
+bool
+TraceCPU::ElasticGraphGen::checkAndIssue(uint64_t idx, bool first)
+{
+    assert(state(idx).pending == 0);
+    const auto &node = graph.node(idx);
+    const RecordType type = RecordType(node.type);
+
+    if (first) {
+        DPRINTFR(TraceCPUData, "\t\tseq. num %lli(%s) with rob num %lli is now"
+                " dependency free.\n", node.seqNum,
+                Record::RecordType_Name(type), node.robNum);
+    }
+
+    if (hwResource.isAvailable(node.seqNum, node.robNum, type)) {
+        DPRINTFR(TraceCPUData, "\t\tResources available for seq. num %lli. "
+                "Adding to readyList, occupying resources.\n", node.seqNum);
+        // Scale the compute delay the same way the protobuf reader does
+        uint64_t comp_delay = node.compDelay * timeMultiplier;
+        addToReadyList(idx, owner.clockEdge() + comp_delay);
+        hwResource.occupy(node.seqNum, node.robNum, type);
+        return true;
+    } else {
+        if (first) {
+            DPRINTFR(TraceCPUData, "\t\tResources unavailable for seq. num "
+                    "%lli. Adding to depFreeQueue.\n", node.seqNum);
+            depFreeQueue.push(idx);
+        } else {
+            DPRINTFR(TraceCPUData, "\t\tResources unavailable for seq. num "
+                    "%lli. Still pending issue.\n", node.seqNum);
+        }
+        return false;
+    }
+}
+
+void
+TraceCPU::ElasticGraphGen::completeMemAccess(PacketPtr pkt)
+{
+    if (pkt->isWrite()) {
+        hwResource.releaseStoreBuffer();
+    } else {
+        auto load_itr = sentLoads.find(pkt->req->getReqInstSeqNum());
+        assert(load_itr != sentLoads.end());
+        const SentLoad load = load_itr->second;
+        sentLoads.erase(load_itr);
+
+        DPRINTF(TraceCPUData, "Load seq. num %lli response received. Waking up"
+                " dependents..\n", graph.node(load.idx).seqNum);
+
+        // Skip the order dependencies already released when the load was
+        // sent.
+        for (auto it = graph.childrenBegin(load.idx);
+             it != graph.childrenEnd(load.idx); ++it) {
+            const uint64_t child =
+                load.idx + ElasticGraph::edgeDistance(*it);
+            if (child >= numRead)
+                break;
+            if (child < load.numReadAtSend && ElasticGraph::edgeIsRob(*it) &&
+                graph.node(child).type != Record::STORE) {
+                continue;
+            }
+            releaseDep(child);
+        }
+        retire(load.idx);
+    }
+
+    if (debug::TraceCPUData) {
+        printReadyList();
+    }
+
+    if (numLive < windowSize && !traceComplete)
+        nextRead = true;
+
+    if (!retryPkt) {
+        Tick next_event_tick = readyList.empty() ? owner.clockEdge(Cycles(1)) :
+            std::max(readyList.front().execTick, owner.clockEdge(Cycles(1)));
+        DPRINTF(TraceCPUData, "Attempting to schedule @%lli.\n",
+                next_event_tick);
+        owner.schedDcacheNextEvent(next_event_tick);
+    }
+}
+
+void
+TraceCPU::ElasticGraphGen::addToReadyList(uint64_t idx, Tick exec_tick)
+{
+    readyList.push_back(ReadyNode{idx, graph.node(idx).seqNum, exec_tick});
+    std::push_heap(readyList.begin(), readyList.end(), LaterReady());
+    // The node waiting for a retry counts towards the ready list size
+    elasticStats.maxReadyListSize = std::max<double>(
+        readyList.size() + (retryPkt ? 1 : 0),
+        elasticStats.maxReadyListSize.value());
+}
+
+void
+TraceCPU::ElasticGraphGen::releaseDep(uint64_t child)
+{
+    NodeState &child_state = state(child);
+    assert(child_state.pending != 0);
+    if (--child_state.pending == 0) {
+        checkAndIssue(child);
+    }
+}
+
+void
+TraceCPU::ElasticGraphGen::retire(uint64_t idx)
+{
+    const auto &node = graph.node(idx);
+    hwResource.release(node.seqNum, RecordType(node.type),
+                       Request::Flags(node.flags).isSet(
+                           Request::STRICT_ORDER));
+    owner.updateNumOps(node.robNum);
+
+    state(idx).done = true;
+    --numLive;
+    while (!states.empty() && states.front().done) {
+        states.pop_front();
+        ++base;
+    }
+}
+
+void
+TraceCPU::ElasticGraphGen::printReadyList()
+{
+    if (readyList.empty()) {
+        DPRINTF(TraceCPUData, "readyList is empty.\n");
+        return;
+    }
+    DPRINTF(TraceCPUData, "Printing readyList:\n");
+    auto sorted = readyList;
+    std::sort_heap(sorted.begin(), sorted.end(), LaterReady());
+    for (auto itr = sorted.rbegin(); itr != sorted.rend(); ++itr) {
+        DPRINTFR(TraceCPUData, "\t%lld(%s), %lld\n", itr->seqNum,
+            Record::RecordType_Name(RecordType(graph.node(itr->idx).type)),
+            itr->execTick);
+    }
+}
+
+TraceCPU::HardwareResource::HardwareResource(
         uint16_t max_rob, uint16_t max_stores, uint16_t max_loads) :
     sizeROB(max_rob),
     sizeStoreBuffer(max_stores),
@@ -839,18 +1290,19 @@ TraceCPU::ElasticDataGen::HardwareResource::HardwareResource(
 {}
 
 void
-TraceCPU::ElasticDataGen::HardwareResource::occupy(const GraphNode* new_node)
+TraceCPU::HardwareResource::occupy(NodeSeqNum seq_num, NodeRobNum rob_num,
+                                   RecordType type)
 {
     // Occupy ROB entry for the issued node
     // Merely maintain the oldest node, i.e. numerically least robNum by saving
     // it in the variable oldestInFLightRobNum.
-    inFlightNodes[new_node->seqNum] = new_node->robNum;
+    inFlightNodes[seq_num] = rob_num;
     oldestInFlightRobNum = inFlightNodes.begin()->second;
 
     // Occupy Load/Store Buffer entry for the issued node if applicable
-    if (new_node->isLoad()) {
+    if (type == Record::LOAD) {
         ++numInFlightLoads;
-    } else if (new_node->isStore()) {
+    } else if (type == Record::STORE) {
         ++numInFlightStores;
     } // else if it is a non load/store node, no buffer entry is occupied
 
@@ -858,15 +1310,16 @@ TraceCPU::ElasticDataGen::HardwareResource::occupy(const GraphNode* new_node)
 }
 
 void
-TraceCPU::ElasticDataGen::HardwareResource::release(const GraphNode* done_node)
+TraceCPU::HardwareResource::release(NodeSeqNum seq_num, RecordType type,
+                                    bool strictly_ordered)
 {
     assert(!inFlightNodes.empty());
     DPRINTFR(TraceCPUData,
             "\tClearing done seq. num %d from inFlightNodes..\n",
-            done_node->seqNum);
+            seq_num);
 
-    assert(inFlightNodes.find(done_node->seqNum) != inFlightNodes.end());
-    inFlightNodes.erase(done_node->seqNum);
+    assert(inFlightNodes.find(seq_num) != inFlightNodes.end());
+    inFlightNodes.erase(seq_num);
 
     if (inFlightNodes.empty()) {
         // If we delete the only in-flight node and then the
@@ -887,7 +1340,7 @@ TraceCPU::ElasticDataGen::HardwareResource::release(const GraphNode* done_node)
     // freed. But it occupies an entry in the Store Buffer until its response
     // is received. A load is considered complete when a response is received,
     // thus both ROB and Load Buffer entries can be released.
-    if (done_node->isLoad()) {
+    if (type == Record::LOAD) {
         assert(numInFlightLoads != 0);
         --numInFlightLoads;
     }
@@ -895,35 +1348,35 @@ TraceCPU::ElasticDataGen::HardwareResource::release(const GraphNode* done_node)
     // entry on response. For writes which are strictly ordered, for e.g.
     // writes to device registers, we do that within release() which is called
     // when node is executed and taken off from readyList.
-    if (done_node->isStore() && done_node->isStrictlyOrdered()) {
+    if (type == Record::STORE && strictly_ordered) {
         releaseStoreBuffer();
     }
 }
 
 void
-TraceCPU::ElasticDataGen::HardwareResource::releaseStoreBuffer()
+TraceCPU::HardwareResource::releaseStoreBuffer()
 {
     assert(numInFlightStores != 0);
     --numInFlightStores;
 }
 
 bool
-TraceCPU::ElasticDataGen::HardwareResource::isAvailable(
-        const GraphNode* new_node) const
+TraceCPU::HardwareResource::isAvailable(
+        NodeSeqNum seq_num, NodeRobNum rob_num, RecordType type) const
 {
     uint16_t num_in_flight_nodes;
     if (inFlightNodes.empty()) {
         num_in_flight_nodes = 0;
         DPRINTFR(TraceCPUData, "\t\tChecking resources to issue seq. num %lli:"
-                " #in-flight nodes = 0", new_node->seqNum);
-    } else if (new_node->robNum > oldestInFlightRobNum) {
+                " #in-flight nodes = 0", seq_num);
+    } else if (rob_num > oldestInFlightRobNum) {
         // This is the intuitive case where new dep-free node is younger
         // instruction than the oldest instruction in-flight. Thus we make sure
         // in_flight_nodes does not overflow.
-        num_in_flight_nodes = new_node->robNum - oldestInFlightRobNum;
+        num_in_flight_nodes = rob_num - oldestInFlightRobNum;
         DPRINTFR(TraceCPUData, "\t\tChecking resources to issue seq. num %lli:"
-                " #in-flight nodes = %d - %d =  %d", new_node->seqNum,
-                new_node->robNum, oldestInFlightRobNum, num_in_flight_nodes);
+                " #in-flight nodes = %d - %d =  %d", seq_num,
+                rob_num, oldestInFlightRobNum, num_in_flight_nodes);
     } else {
         // This is the case where an instruction older than the oldest in-
         // flight instruction becomes dep-free. Thus we must have already
@@ -933,7 +1386,7 @@ TraceCPU::ElasticDataGen::HardwareResource::isAvailable(
         num_in_flight_nodes = 0;
         DPRINTFR(TraceCPUData, "\t\tChecking resources to issue seq. num %lli:"
                 " new oldestInFlightRobNum = %d, #in-flight nodes ignored",
-                new_node->seqNum, new_node->robNum);
+                seq_num, rob_num);
     }
     DPRINTFR(TraceCPUData, ", LQ = %d/%d, SQ  = %d/%d.\n",
             numInFlightLoads, sizeLoadBuffer,
@@ -942,24 +1395,24 @@ TraceCPU::ElasticDataGen::HardwareResource::isAvailable(
     if (num_in_flight_nodes >= sizeROB) {
         return false;
     }
-    if (new_node->isLoad() && numInFlightLoads >= sizeLoadBuffer) {
+    if (type == Record::LOAD && numInFlightLoads >= sizeLoadBuffer) {
         return false;
     }
-    if (new_node->isStore() && numInFlightStores >= sizeStoreBuffer) {
+    if (type == Record::STORE && numInFlightStores >= sizeStoreBuffer) {
         return false;
     }
     return true;
 }
 
 bool
-TraceCPU::ElasticDataGen::HardwareResource::awaitingResponse() const
+TraceCPU::HardwareResource::awaitingResponse() const
 {
     // Return true if there is at least one read or write request in flight
     return (numInFlightStores != 0 || numInFlightLoads != 0);
 }
 
 void
-TraceCPU::ElasticDataGen::HardwareResource::printOccupancy()
+TraceCPU::HardwareResource::printOccupancy()
 {
     DPRINTFR(TraceCPUData, "oldestInFlightRobNum = %d, "
             "LQ = %d/%d, SQ  = %d/%d.\n",
@@ -1172,7 +1625,7 @@ void
 TraceCPU::dcacheRecvTimingResp(PacketPtr pkt)
 {
     DPRINTF(TraceCPUData, "Received timing response from Dcache.\n");
-    dcacheGen.completeMemAccess(pkt);
+    dcacheGen->completeMemAccess(pkt);
 }
 
 bool
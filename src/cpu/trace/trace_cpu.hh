@@ -39,13 +39,17 @@
 #define __CPU_TRACE_TRACE_CPU_HH__
 
 #include <cstdint>
+#include <deque>
 #include <list>
+#include <memory>
 #include <queue>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "base/statistics.hh"
 #include "cpu/base.hh"
+#include "cpu/trace/elastic_graph.hh"
 #include "debug/TraceCPUData.hh"
 #include "debug/TraceCPUInst.hh"
 #include "params/TraceCPU.hh"
@@ -78,7 +82,10 @@ namespace gem5
  * dependency is not found when adding a new node, it is assumed complete.
  * Thus, if this node is found to be completely dependency-free its issue time
  * is calculated and it is added to the ready list immediately. This is
- * encapsulated in the subclass ElasticDataGen.
+ * encapsulated in the subclass ElasticDataGen. Alternatively the data trace
+ * can be converted offline into a precomputed dependency graph which
+ * ElasticGraphGen replays with the same semantics, avoiding the cost of
+ * parsing the trace and building the graph during simulation.
  *
  * If ready nodes are issued in an unconstrained way there can be more nodes
  * outstanding which results in divergence in timing compared to the O3CPU.
@@ -525,6 +532,191 @@ class TraceCPU : public BaseCPU
 
     };
 
+    /** Node sequence number type. */
+    typedef uint64_t NodeSeqNum;
+
+    /** Node ROB number type. */
+    typedef uint64_t NodeRobNum;
+
+    typedef ProtoMessage::InstDepRecord::RecordType RecordType;
+    typedef ProtoMessage::InstDepRecord Record;
+
+    /**
+     * The HardwareResource class models structures that hold the in-flight
+     * nodes. When a node becomes dependency free, first check if resources
+     * are available to issue it.
+     */
+    class HardwareResource
+    {
+      public:
+        /**
+         * Constructor that initializes the sizes of the structures.
+         *
+         * @param max_rob size of the Reorder Buffer
+         * @param max_stores size of Store Buffer
+         * @param max_loads size of Load Buffer
+         */
+        HardwareResource(uint16_t max_rob, uint16_t max_stores,
+                            uint16_t max_loads);
+
+        /**
+         * Occupy appropriate structures for an issued node.
+         *
+         * @param seq_num sequence number of the issued node
+         * @param rob_num ROB number of the issued node
+         * @param type type of the issued node
+         */
+        void occupy(NodeSeqNum seq_num, NodeRobNum rob_num,
+                    RecordType type);
+
+        /**
+         * Release appropriate structures for a completed node.
+         *
+         * @param seq_num sequence number of the completed node
+         * @param type type of the completed node
+         * @param strictly_ordered if the node's request is strictly
+         *      ordered
+         */
+        void release(NodeSeqNum seq_num, RecordType type,
+                     bool strictly_ordered);
+
+        /** Release store buffer entry for a completed store */
+        void releaseStoreBuffer();
+
+        /**
+         * Check if structures required to issue a node are free.
+         *
+         * @param seq_num sequence number of the node ready to issue
+         * @param rob_num ROB number of the node ready to issue
+         * @param type type of the node ready to issue
+         * @return true if resources are available
+         */
+        bool isAvailable(NodeSeqNum seq_num, NodeRobNum rob_num,
+                         RecordType type) const;
+
+        /**
+         * Check if there are any outstanding requests, i.e. requests for
+         * which we are yet to receive a response.
+         *
+         * @return true if there is at least one read or write request
+         *      outstanding
+         */
+        bool awaitingResponse() const;
+
+        /** Print resource occupancy for debugging. */
+        void printOccupancy();
+
+      private:
+        /**
+         * The size of the ROB used to throttle the max. number of
+         * in-flight nodes.
+         */
+        const uint16_t sizeROB;
+
+        /**
+         * The size of store buffer. This is used to throttle the max.
+         * number of in-flight stores.
+         */
+        const uint16_t sizeStoreBuffer;
+
+        /**
+         * The size of load buffer. This is used to throttle the max.
+         * number of in-flight loads.
+         */
+        const uint16_t sizeLoadBuffer;
+
+        /**
+         * A map from the sequence number to the ROB number of the in-
+         * flight nodes. This includes all nodes that are in the readyList
+         * plus the loads for which a request has been sent which are not
+         * present in the readyList. But such loads are not yet complete
+         * and thus occupy resources. We need to query the oldest in-flight
+         * node and since a map container keeps all its keys sorted using
+         * the less than criterion, the first element is the in-flight node
+         * with the least sequence number, i.e. the oldest in-flight node.
+         */
+        std::map<NodeSeqNum, NodeRobNum> inFlightNodes;
+
+        /** The ROB number of the oldest in-flight node */
+        NodeRobNum oldestInFlightRobNum;
+
+        /** Number of ready loads for which request may or may not be
+         * sent.
+         */
+        uint16_t numInFlightLoads;
+
+        /** Number of ready stores for which request may or may not be
+         * sent.
+         */
+        uint16_t numInFlightStores;
+    };
+
+    // Defining the a stat group
+    struct ElasticDataGenStatGroup : public statistics::Group
+    {
+        /** name is the extension to the name for these stats */
+        ElasticDataGenStatGroup(statistics::Group *parent,
+                                const std::string& _name);
+        /** Stats for data memory accesses replayed. */
+        statistics::Scalar maxDependents;
+        statistics::Scalar maxReadyListSize;
+        statistics::Scalar numSendAttempted;
+        statistics::Scalar numSendSucceeded;
+        statistics::Scalar numSendFailed;
+        statistics::Scalar numRetrySucceeded;
+        statistics::Scalar numSplitReqs;
+        statistics::Scalar numSOLoads;
+        statistics::Scalar numSOStores;
+        /** Tick when ElasticDataGen completes execution */
+        statistics::Scalar dataLastTick;
+    };
+
+    /**
+     * Interface of the generators replaying the data side of an elastic
+     * trace, either straight from the protobuf trace or from the dependency
+     * graph precomputed from it.
+     */
+    class ElasticGen
+    {
+      public:
+        virtual ~ElasticGen() = default;
+
+        /**
+         * Called from TraceCPU init(). Reads the first nodes of the trace
+         * and returns the execute tick of the first one.
+         *
+         * @return Tick when first packet must be sent
+         */
+        virtual Tick init() = 0;
+
+        /**
+         * Adjust the execute ticks of the ready nodes based on what TraceCPU
+         * init() determines on comparing the offsets in the fetch request
+         * and elastic traces.
+         *
+         * @param trace_offset trace offset set by comparing both traces
+         */
+        virtual void adjustInitTraceOffset(Tick& offset) = 0;
+
+        /** Exit the generator. */
+        virtual void exit() = 0;
+
+        /** Execute the nodes which are ready and wake up their dependents. */
+        virtual void execute() = 0;
+
+        /**
+         * When a load writeback is received, that is when the load
+         * completes, release the dependents on it.
+         */
+        virtual void completeMemAccess(PacketPtr pkt) = 0;
+
+        /** Returns true when the last node is executed. */
+        virtual bool isExecComplete() const = 0;
+
+        /** Get number of micro-ops modelled in the TraceCPU replay */
+        virtual uint64_t getMicroOpCount() const = 0;
+    };
+
     /**
      * The elastic data memory request generator to read protobuf trace
      * containing execution trace annotated with data and ordering
@@ -536,18 +728,9 @@ class TraceCPU : public BaseCPU
      * accordingly. If it fails to send the packet, it waits for a retry from
      * the cache.
      */
-    class ElasticDataGen
+    class ElasticDataGen : public ElasticGen
     {
       private:
-        /** Node sequence number type. */
-        typedef uint64_t NodeSeqNum;
-
-        /** Node ROB number type. */
-        typedef uint64_t NodeRobNum;
-
-        typedef ProtoMessage::InstDepRecord::RecordType RecordType;
-        typedef ProtoMessage::InstDepRecord Record;
-
         /**
          * The struct GraphNode stores an instruction in the trace file. The
          * format of the trace file favours constructing a dependency graph of
@@ -653,106 +836,6 @@ class TraceCPU : public BaseCPU
             Tick execTick;
         };
 
-        /**
-         * The HardwareResource class models structures that hold the in-flight
-         * nodes. When a node becomes dependency free, first check if resources
-         * are available to issue it.
-         */
-        class HardwareResource
-        {
-          public:
-            /**
-             * Constructor that initializes the sizes of the structures.
-             *
-             * @param max_rob size of the Reorder Buffer
-             * @param max_stores size of Store Buffer
-             * @param max_loads size of Load Buffer
-             */
-            HardwareResource(uint16_t max_rob, uint16_t max_stores,
-                                uint16_t max_loads);
-
-            /**
-             * Occupy appropriate structures for an issued node.
-             *
-             * @param node_ptr pointer to the issued node
-             */
-            void occupy(const GraphNode* new_node);
-
-            /**
-             * Release appropriate structures for a completed node.
-             *
-             * @param node_ptr pointer to the completed node
-             */
-            void release(const GraphNode* done_node);
-
-            /** Release store buffer entry for a completed store */
-            void releaseStoreBuffer();
-
-            /**
-             * Check if structures required to issue a node are free.
-             *
-             * @param node_ptr pointer to the node ready to issue
-             * @return true if resources are available
-             */
-            bool isAvailable(const GraphNode* new_node) const;
-
-            /**
-             * Check if there are any outstanding requests, i.e. requests for
-             * which we are yet to receive a response.
-             *
-             * @return true if there is at least one read or write request
-             *      outstanding
-             */
-            bool awaitingResponse() const;
-
-            /** Print resource occupancy for debugging. */
-            void printOccupancy();
-
-          private:
-            /**
-             * The size of the ROB used to throttle the max. number of
-             * in-flight nodes.
-             */
-            const uint16_t sizeROB;
-
-            /**
-             * The size of store buffer. This is used to throttle the max.
-             * number of in-flight stores.
-             */
-            const uint16_t sizeStoreBuffer;
-
-            /**
-             * The size of load buffer. This is used to throttle the max.
-             * number of in-flight loads.
-             */
-            const uint16_t sizeLoadBuffer;
-
-            /**
-             * A map from the sequence number to the ROB number of the in-
-             * flight nodes. This includes all nodes that are in the readyList
-             * plus the loads for which a request has been sent which are not
-             * present in the readyList. But such loads are not yet complete
-             * and thus occupy resources. We need to query the oldest in-flight
-             * node and since a map container keeps all its keys sorted using
-             * the less than criterion, the first element is the in-flight node
-             * with the least sequence number, i.e. the oldest in-flight node.
-             */
-            std::map<NodeSeqNum, NodeRobNum> inFlightNodes;
-
-            /** The ROB number of the oldest in-flight node */
-            NodeRobNum oldestInFlightRobNum;
-
-            /** Number of ready loads for which request may or may not be
-             * sent.
-             */
-            uint16_t numInFlightLoads;
-
-            /** Number of ready stores for which request may or may not be
-             * sent.
-             */
-            uint16_t numInFlightStores;
-        };
-
         /**
          * The InputStream encapsulates a trace file and the
          * internal buffers and populates GraphNodes based on
@@ -844,7 +927,7 @@ class TraceCPU : public BaseCPU
          *
          * @return Tick when first packet must be sent
          */
-        Tick init();
+        Tick init() override;
 
         /**
          * Adjust traceOffset based on what TraceCPU init() determines on
@@ -852,13 +935,13 @@ class TraceCPU : public BaseCPU
          *
          * @param trace_offset trace offset set by comparing both traces
          */
-        void adjustInitTraceOffset(Tick& offset);
+        void adjustInitTraceOffset(Tick& offset) override;
 
         /** Returns name of the ElasticDataGen instance. */
         const std::string& name() const { return genName; }
 
         /** Exit the ElasticDataGen. */
-        void exit();
+        void exit() override;
 
         /**
          * Reads a line of the trace file. Returns the tick when the next
@@ -889,7 +972,7 @@ class TraceCPU : public BaseCPU
          * a load or a store call executeMemReq() and if it is neither, simply
          * mark it complete.
          */
-        void execute();
+        void execute() override;
 
         /**
          * Creates a new request for a load or store assigning the request
@@ -920,7 +1003,7 @@ class TraceCPU : public BaseCPU
          * release the dependents on it. This is called from the dcache port
          * recvTimingResp().
          */
-        void completeMemAccess(PacketPtr pkt);
+        void completeMemAccess(PacketPtr pkt) override;
 
         /**
          * Returns the execComplete variable which is set when the last
@@ -928,7 +1011,7 @@ class TraceCPU : public BaseCPU
          *
          * @return bool true if execComplete is set, false otherwise.
          */
-        bool isExecComplete() const { return execComplete; }
+        bool isExecComplete() const override { return execComplete; }
 
         /**
          * Attempts to issue a node once the node's source dependencies are
@@ -943,7 +1026,11 @@ class TraceCPU : public BaseCPU
         bool checkAndIssue(const GraphNode* node_ptr, bool first=true);
 
         /** Get number of micro-ops modelled in the TraceCPU replay */
-        uint64_t getMicroOpCount() const { return trace.getMicroOpCount(); }
+        uint64_t
+        getMicroOpCount() const override
+        {
+            return trace.getMicroOpCount();
+        }
 
       private:
         /** Reference of the TraceCPU. */
@@ -1005,33 +1092,235 @@ class TraceCPU : public BaseCPU
         /** List of nodes that are ready to execute */
         std::list<ReadyNode> readyList;
 
-      protected:
-        // Defining the a stat group
-        struct ElasticDataGenStatGroup : public statistics::Group
+        ElasticDataGenStatGroup elasticStats;
+    };
+
+    /**
+     * Replays the data side of an elastic trace from a dependency graph
+     * that was precomputed offline (see ElasticGraph). The issue, resource
+     * and release rules are those of ElasticDataGen, so both generators
+     * produce the same request stream for the same trace, but nothing is
+     * parsed, allocated or hashed per node: the graph is used in place
+     * from the mapped file, a node is tracked by its index in the trace
+     * and only a small state record is kept for the nodes read so far.
+     * The window of nodes read ahead is kept identical to ElasticDataGen
+     * as it determines which dependencies are still live when a node is
+     * read.
+     */
+    class ElasticGraphGen : public ElasticGen
+    {
+      private:
+        /** Replay state of a node read from the graph. */
+        struct NodeState
         {
-            /** name is the extension to the name for these stats */
-            ElasticDataGenStatGroup(statistics::Group *parent,
-                                    const std::string& _name);
-            /** Stats for data memory accesses replayed. */
-            statistics::Scalar maxDependents;
-            statistics::Scalar maxReadyListSize;
-            statistics::Scalar numSendAttempted;
-            statistics::Scalar numSendSucceeded;
-            statistics::Scalar numSendFailed;
-            statistics::Scalar numRetrySucceeded;
-            statistics::Scalar numSplitReqs;
-            statistics::Scalar numSOLoads;
-            statistics::Scalar numSOStores;
-            /** Tick when ElasticDataGen completes execution */
-            statistics::Scalar dataLastTick;
-        } elasticStats;
+            /** Number of live parents the node is waiting for */
+            uint32_t pending;
+
+            /** Number of dependents waiting on the node */
+            uint32_t numDependents;
+
+            /** Set once the node has completed and released its deps */
+            bool done;
+        };
+
+        /** A ready-to-execute node and its execution tick. */
+        struct ReadyNode
+        {
+            /** Index of the node in the graph */
+            uint64_t idx;
+
+            /** The sequence number of the ready node */
+            NodeSeqNum seqNum;
+
+            /** The tick at which the ready node must be executed */
+            Tick execTick;
+        };
+
+        /**
+         * Heap ordering that keeps the ready node with the least execute
+         * tick, and then the least sequence number, at the front.
+         */
+        struct LaterReady
+        {
+            bool
+            operator()(const ReadyNode &a, const ReadyNode &b) const
+            {
+                return a.execTick != b.execTick ? a.execTick > b.execTick :
+                    a.seqNum > b.seqNum;
+            }
+        };
+
+        /** A load for which a request was sent but no response received. */
+        struct SentLoad
+        {
+            /** Index of the load in the graph */
+            uint64_t idx;
+
+            /** Number of nodes that had been read when the load was sent */
+            uint64_t numReadAtSend;
+        };
+
+      public:
+        /* Constructor */
+        ElasticGraphGen(TraceCPU& _owner, const std::string& _name,
+                        RequestPort& _port, RequestorID requestor_id,
+                        const std::string& trace_file,
+                        const TraceCPUParams &params);
+
+        Tick init() override;
+
+        void adjustInitTraceOffset(Tick& offset) override;
+
+        /** Returns name of the ElasticGraphGen instance. */
+        const std::string& name() const { return genName; }
+
+        void exit() override;
+
+        void execute() override;
+
+        void completeMemAccess(PacketPtr pkt) override;
+
+        bool isExecComplete() const override { return execComplete; }
+
+        uint64_t
+        getMicroOpCount() const override
+        {
+            return numRead ? graph.node(numRead - 1).robNum : 0;
+        }
+
+      private:
+        /**
+         * Read the next window of nodes, counting the live parents of each
+         * and issuing the ones that are already dependency free.
+         *
+         * @return false if the end of the graph has been reached
+         */
+        bool readNextWindow();
+
+        /** Get the replay state of a node that has been read. */
+        NodeState &
+        state(uint64_t idx)
+        {
+            assert(idx >= base && idx < numRead);
+            return states[idx - base];
+        }
+
+        /** True if a node has been read and is yet to complete. */
+        bool
+        isLive(uint64_t idx) const
+        {
+            return idx >= base && idx < numRead && !states[idx - base].done;
+        }
+
+        /**
+         * Attempt to issue a dependency-free node, adding it to the ready
+         * list if resources are available and to the depFreeQueue if not.
+         *
+         * @param idx index of the node to be issued
+         * @param first true if this is the first attempt to issue this node
+         * @return true if node was added to the ready list
+         */
+        bool checkAndIssue(uint64_t idx, bool first=true);
+
+        /** Add a node to the ready list heap. */
+        void addToReadyList(uint64_t idx, Tick exec_tick);
+
+        /**
+         * Creates and sends the request for a load or store node.
+         *
+         * @param idx index of the load or store node to be executed
+         * @return packet pointer if the request failed and nullptr if it was
+         *          sent successfully
+         */
+        PacketPtr executeMemReq(uint64_t idx);
+
+        /**
+         * Release a dependency of a child on a completed parent and issue
+         * the child if it has become dependency free.
+         */
+        void releaseDep(uint64_t child);
+
+        /**
+         * Mark a node complete, releasing the resources it occupies and
+         * dropping the state of the completed nodes at the head.
+         */
+        void retire(uint64_t idx);
+
+        /** Print the ready list for debugging using TraceCPUData. */
+        void printReadyList();
+
+        /** Reference of the TraceCPU. */
+        TraceCPU& owner;
+
+        /** Reference of the port to be used to issue memory requests. */
+        RequestPort& port;
+
+        /** RequestorID used for the requests being sent. */
+        const RequestorID requestorId;
+
+        /** The mapped dependency graph. */
+        const ElasticGraph graph;
+
+        /** Multiplier for the compute delays, see ElasticDataGen. */
+        const double timeMultiplier;
+
+        /** String to store the name of the ElasticGraphGen. */
+        std::string genName;
+
+        /** PacketPtr used to store the packet to retry. */
+        PacketPtr retryPkt;
+
+        /** The node that created retryPkt, valid while it is set. */
+        ReadyNode retryNode;
+
+        /** Set to true when end of trace is reached. */
+        bool traceComplete;
+
+        /** Set to true when the next window of nodes need to be read */
+        bool nextRead;
+
+        /** Set true when execution of trace is complete */
+        bool execComplete;
+
+        /** Window size recorded in the graph, see ElasticDataGen. */
+        const uint32_t windowSize;
+
+        /** Hardware resources that throttle issuing of new nodes. */
+        HardwareResource hwResource;
+
+        /** Number of nodes read from the graph. */
+        uint64_t numRead;
+
+        /** Index of the node whose state is at the front of states. */
+        uint64_t base;
+
+        /** Number of nodes read and yet to complete. */
+        uint64_t numLive;
+
+        /** State of the nodes in [base, numRead). */
+        std::deque<NodeState> states;
+
+        /** Loads with a request in flight, by sequence number. */
+        std::unordered_map<NodeSeqNum, SentLoad> sentLoads;
+
+        /** Indices of dependency-free nodes pending issue. */
+        std::queue<uint64_t> depFreeQueue;
+
+        /** Heap of nodes that are ready to execute. */
+        std::vector<ReadyNode> readyList;
+
+        ElasticDataGenStatGroup elasticStats;
     };
 
     /** Instance of FixedRetryGen to replay instruction read requests. */
     FixedRetryGen icacheGen;
 
-    /** Instance of ElasticDataGen to replay data read and write requests. */
-    ElasticDataGen dcacheGen;
+    /**
+     * Generator replaying data read and write requests, an ElasticGraphGen
+     * if the data trace is a precomputed graph and an ElasticDataGen
+     * otherwise.
+     */
+    std::unique_ptr<ElasticGen> dcacheGen;
 
     /**
      * This is the control flow that uses the functionality of the icacheGen to
@@ -70,6 +70,22 @@ class DRAMInterface(MemInterface):
     # For power modelling we need to know if the DRAM has a DLL or not
     dll = Param.Bool(True, "DRAM has DLL or not")
 
+    # Row buffer locality instrumentation. The row hits, misses and
+    # conflicts are always counted per bank, the per address region
+    # histograms are sampled, and the per bank timeline is written to a
+    # binary file, see util/plot_dram/row_buffer_heatmap.py
+    row_stats_sample_period = Param.Unsigned(0, "Sample one in every N "
+                                             "bursts into the address "
+                                             "region histograms, 0 to "
+                                             "disable them")
+    row_stats_region_size = Param.MemorySize('4KiB', "Address region size "
+                                             "of the row buffer histograms")
+    row_trace_interval = Param.Latency('0ns', "Interval of the per bank "
+                                       "row buffer timeline, 0 to disable "
+                                       "it")
+    row_trace_file = Param.String("", "Row buffer timeline file, "
+                                  "<name>.rowtrace if empty")
+
     # DRAMPower provides in addition to the core power, the possibility to
     # include RD/WR termination and IO power. This calculation assumes some
     # default values. The integration of DRAMPower with gem5 does not include
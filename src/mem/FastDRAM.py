@@ -0,0 +1,114 @@
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+from m5.params import *
+from m5.proxy import *
+from m5.objects.AbstractMemory import *
+from m5.objects.DRAMInterface import PageManage
+from m5.objects.MemInterface import AddrMap
+
+# The parameters shared with a DRAMInterface
+_interface_params = ['range', 'null', 'in_addr_map', 'kvm_map',
+                    'conf_table_reported', 'write_buffer_size',
+                    'read_buffer_size', 'addr_mapping', 'bank_xor_masks',
+                    'rank_xor_masks', 'page_policy',
+                    'device_bus_width', 'burst_length',
+                    'device_rowbuffer_size', 'devices_per_rank',
+                    'ranks_per_channel', 'banks_per_rank', 'tRCD',
+                    'tRCD_WR', 'tCL', 'tCWL', 'tRP', 'tBURST', 'tRAS',
+                    'tWR', 'tRTP', 'tRFC', 'tREFI', 'tWTR', 'tRTW', 'tCS']
+
+# FastDRAM is an analytical model of a DRAM channel and its controller,
+# tracking the state of the banks and using a table of latencies derived
+# from the DRAM timings, along with the queueing on the data bus. The
+# parameters use the names of the MemCtrl and DRAMInterface ones, see
+# from_interface() to derive a model from a DRAMInterface.
+class FastDRAM(AbstractMemory):
+    type = 'FastDRAM'
+    cxx_header = "mem/fast_dram.hh"
+    cxx_class = 'gem5::memory::FastDRAM'
+
+    port = ResponsePort("This port sends responses and receives requests")
+
+    # capacity of the controller queues, in bursts
+    write_buffer_size = Param.Unsigned(64, "Number of write queue entries")
+    read_buffer_size = Param.Unsigned(32, "Number of read queue entries")
+
+    addr_mapping = Param.AddrMap('RoRaBaCoCh', "Address mapping policy")
+    bank_xor_masks = VectorParam.Addr([], "Address masks hashed into "
+                                      "the bank index, one per bit")
+    rank_xor_masks = VectorParam.Addr([], "Address masks hashed into "
+                                      "the rank index, one per bit")
+    page_policy = Param.PageManage('open_adaptive', "Page management policy")
+
+    # the physical organisation of the memory
+    device_bus_width = Param.Unsigned("data bus width in bits for each "\
+                                      "memory device/chip")
+    burst_length = Param.Unsigned("Burst lenght (BL) in beats")
+    device_rowbuffer_size = Param.MemorySize("Page (row buffer) size per "\
+                                             "device/chip")
+    devices_per_rank = Param.Unsigned("Number of devices/chips per rank")
+    ranks_per_channel = Param.Unsigned("Number of ranks per channel")
+    banks_per_rank = Param.Unsigned("Number of banks per rank")
+
+    # the timings building the latency table
+    tRCD = Param.Latency("RAS to Read CAS delay")
+    tRCD_WR = Param.Latency(Self.tRCD, "RAS to Write CAS delay")
+    tCL = Param.Latency("Read CAS latency")
+    tCWL = Param.Latency(Self.tCL, "Write CAS latency")
+    tRP = Param.Latency("Row precharge time")
+    tBURST = Param.Latency("Burst duration")
+
+    # the timings constraining the banks and the data bus
+    tRAS = Param.Latency("ACT to PRE delay")
+    tWR = Param.Latency("Write recovery time")
+    tRTP = Param.Latency("Read to precharge")
+    tRFC = Param.Latency("Refresh cycle time")
+    tREFI = Param.Latency("Refresh command interval")
+    tWTR = Param.Latency("Write to read, same rank switching time")
+    tRTW = Param.Latency("Read to write, same rank switching time")
+    tCS = Param.Latency("Rank to rank switching time")
+
+    # the pipeline latencies of the controller
+    static_frontend_latency = Param.Latency("10ns", "Static frontend latency")
+    static_backend_latency = Param.Latency("10ns", "Static backend latency")
+
+    # calibration of the latency table against the detailed controller
+    row_hit_scale = Param.Float(1.0, "Scale of the row hit latency")
+    row_miss_scale = Param.Float(1.0, "Scale of the closed bank latency")
+    row_conflict_scale = Param.Float(1.0, "Scale of the row conflict latency")
+
+    @classmethod
+    def from_interface(cls, intf, **kwargs):
+        """
+        Create a fast model of a DRAM interface, with the organisation,
+        timings and address range of the interface. The interface itself
+        is not used, and the controller is replaced by the model.
+        """
+        for name in _interface_params:
+            kwargs.setdefault(name, getattr(intf, name))
+        return cls(**kwargs)
+
+    def controller(self):
+        # The fast DRAM models the controller as well
+        return self
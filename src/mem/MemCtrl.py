@@ -89,6 +89,14 @@ class MemCtrl(QoSMemCtrl):
     # frontend part and a backend part, with reads and writes serviced
     # by the queues only seeing the frontend contribution, and reads
     # serviced by the memory seeing the sum of the two
+    #
+    # When the controller uses an event queue of its own, requests from
+    # another queue arrive no earlier than a simulation quantum after
+    # they are sent, instead of after their header delay. Responses to
+    # them leave no earlier than a quantum after the access, instead of
+    # after the static latency. Keep the quantum below the crossbar and
+    # static latencies to leave the timing unchanged, each crossing adds
+    # up to a quantum otherwise.
     static_frontend_latency = Param.Latency("10ns", "Static frontend latency")
     static_backend_latency = Param.Latency("10ns", "Static backend latency")
 
@@ -67,6 +67,19 @@ class MemInterface(AbstractMemory):
     # scheduler, address map
     addr_mapping = Param.AddrMap('RoRaBaCoCh', "Address mapping policy")
 
+    # XOR hashing on top of the address mapping, with one mask per bit
+    # of the bank (rank) index, starting from the least significant
+    # one. The bit is flipped by the parity of the address bits in its
+    # mask. The masks apply to the address within the interface, with
+    # the channel interleaving bits removed, and should not include the
+    # bank (rank) bits of the mapping, so that the hashed mapping is
+    # still a permutation. Channels are hashed by the masks of their
+    # address ranges. util/dram_addr_mapping.py evaluates mappings.
+    bank_xor_masks = VectorParam.Addr([], "Address masks hashed into "
+                                      "the bank index, one per bit")
+    rank_xor_masks = VectorParam.Addr([], "Address masks hashed into "
+                                      "the rank index, one per bit")
+
     # size of memory device in Bytes
     device_size = Param.MemorySize("Size of memory device")
     # the physical organisation of the memory
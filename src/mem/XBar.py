@@ -80,6 +80,18 @@ class BaseXBar(ClockedObject):
     # width cycles
     header_latency = Param.Cycles(1, "Header latency")
 
+    # In burst mode, a busy Layer keeps on accepting back-to-back packets
+    # from the port it is forwarding for, as long as no other port is
+    # waiting and they would wait at most half a microsecond. The
+    # packets are forwarded straight away, delayed by the time they
+    # would have waited for the Layer, and the occupancy is accumulated,
+    # so the bandwidth is the same but the Layer is only released, and
+    # the next port retried, once per burst
+    max_burst_packets = Param.Unsigned(1, "Maximum number of packets "
+                                       "from the same port forwarded in "
+                                       "one occupancy of a layer, 1 to "
+                                       "disable burst mode")
+
     # Width governing the throughput of the crossbar
     width = Param.Unsigned("Datapath width per port (bytes)")
 
@@ -113,21 +113,27 @@ Base::setCache(BaseCache *_cache)
 
 std::vector<Base::Chunk>
 Base::toChunks(const uint64_t* data) const
+{
+    std::vector<Chunk> chunks;
+    toChunks(data, chunks);
+    return chunks;
+}
+
+void
+Base::toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const
 {
     // Number of chunks in a 64-bit value
     const unsigned num_chunks_per_64 =
         (sizeof(uint64_t) * CHAR_BIT) / chunkSizeBits;
 
     // Turn a 64-bit array into a chunkSizeBits-array
-    std::vector<Chunk> chunks((blkSize * CHAR_BIT) / chunkSizeBits, 0);
+    chunks.resize((blkSize * CHAR_BIT) / chunkSizeBits);
     for (int i = 0; i < chunks.size(); i++) {
-        const int index_64 = std::floor(i / (double)num_chunks_per_64);
+        const unsigned index_64 = i / num_chunks_per_64;
         const unsigned start = i % num_chunks_per_64;
         chunks[i] = bits(data[index_64],
             (start + 1) * chunkSizeBits - 1, start * chunkSizeBits);
     }
-
-    return chunks;
 }
 
 void
@@ -151,8 +157,9 @@ std::unique_ptr<Base::CompressionData>
 Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
 {
     // Apply compression
+    toChunks(data, chunkBuffer);
     std::unique_ptr<CompressionData> comp_data =
-        compress(toChunks(data), comp_lat, decomp_lat);
+        compress(chunkBuffer, comp_lat, decomp_lat);
 
     // If we are in debug mode apply decompression just after the compression.
     // If the results do not match, we've got an error
@@ -167,12 +174,47 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
              "Decompressed line does not match original line.");
     #endif
 
+    comp_data->setSizeBits(recordCompression(comp_data->getSizeBits(),
+        comp_lat, decomp_lat));
+
+    return comp_data;
+}
+
+std::size_t
+Base::compressSizeBits(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    return compress(chunks, comp_lat, decomp_lat)->getSizeBits();
+}
+
+std::size_t
+Base::compressSizeBits(const uint64_t* data, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    toChunks(data, chunkBuffer);
+    const std::size_t comp_size_bits =
+        compressSizeBits(chunkBuffer, comp_lat, decomp_lat);
+
+    // If we are in debug mode check that the size matches the one of the
+    // full compression
+    #ifdef DEBUG_COMPRESSION
+    Cycles check_comp_lat, check_decomp_lat;
+    fatal_if(compress(chunkBuffer, check_comp_lat,
+        check_decomp_lat)->getSizeBits() != comp_size_bits,
+        "Compressed size does not match the size of the compressed line.");
+    #endif
+
+    return recordCompression(comp_size_bits, comp_lat, decomp_lat);
+}
+
+std::size_t
+Base::recordCompression(std::size_t comp_size_bits, Cycles comp_lat,
+    Cycles decomp_lat)
+{
     // Get compression size. If compressed size is greater than the size
     // threshold, the compression is seen as unsuccessful
-    std::size_t comp_size_bits = comp_data->getSizeBits();
     if (comp_size_bits > sizeThreshold * CHAR_BIT) {
         comp_size_bits = blkSize * CHAR_BIT;
-        comp_data->setSizeBits(comp_size_bits);
         stats.failedCompressions++;
     }
 
@@ -190,7 +232,7 @@ Base::compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat)
             "Compression latency: %llu, decompression latency: %llu\n",
             blkSize*8, comp_size_bits, comp_lat, decomp_lat);
 
-    return comp_data;
+    return comp_size_bits;
 }
 
 Cycles
@@ -37,6 +37,8 @@
 #define __MEM_CACHE_COMPRESSORS_BASE_HH__
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/statistics.hh"
@@ -129,6 +131,12 @@ class Base : public SimObject
     /** Pointer to the parent cache. */
     BaseCache* cache;
 
+    /**
+     * Chunks of the line being compressed. Kept here so that they are not
+     * reallocated for every block.
+     */
+    std::vector<Chunk> chunkBuffer;
+
     struct BaseStats : public statistics::Group
     {
         const Base& compressor;
@@ -165,6 +173,15 @@ class Base : public SimObject
      */
     std::vector<Chunk> toChunks(const uint64_t* data) const;
 
+    /**
+     * This function splits the raw data into chunks, reusing the storage
+     * of the given vector.
+     *
+     * @param data The raw pointer to the data being compressed.
+     * @param chunks Vector to be filled with the sequential chunks.
+     */
+    void toChunks(const uint64_t* data, std::vector<Chunk>& chunks) const;
+
     /**
      * This function re-joins the chunks to recreate the original data.
      *
@@ -198,6 +215,33 @@ class Base : public SimObject
     virtual void decompress(const CompressionData* comp_data,
                               uint64_t* cache_line) = 0;
 
+    /**
+     * Apply the compression process to the cache line, keeping only the
+     * size of the result. This is all the cache needs to place the block,
+     * so compressors can implement it without building the compressed
+     * data, which would then be thrown away. By default the line is
+     * compressed and its size returned.
+     *
+     * @param chunks The cache line to be compressed, divided into chunks.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return Size of the cache line after compression, in bits.
+     */
+    virtual std::size_t compressSizeBits(const std::vector<Chunk>& chunks,
+        Cycles& comp_lat, Cycles& decomp_lat);
+
+    /**
+     * Check the size of a compressed line against the size threshold, and
+     * account for the compression in the stats.
+     *
+     * @param comp_size_bits Size of the compressed line, in bits.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return The size of the line, uncompressed if it is too large.
+     */
+    std::size_t recordCompression(std::size_t comp_size_bits,
+        Cycles comp_lat, Cycles decomp_lat);
+
   public:
     typedef BaseCacheCompressorParams Params;
     Base(const Params &p);
@@ -218,6 +262,18 @@ class Base : public SimObject
     std::unique_ptr<CompressionData>
     compress(const uint64_t* data, Cycles& comp_lat, Cycles& decomp_lat);
 
+    /**
+     * Get the size the cache line compresses to, as compress() would,
+     * without producing the compressed data. Ignores compression cycles.
+     *
+     * @param data The cache line to be compressed.
+     * @param comp_lat Compression latency in number of cycles.
+     * @param decomp_lat Decompression latency in number of cycles.
+     * @return Size of the cache line after compression, in bits.
+     */
+    std::size_t compressSizeBits(const uint64_t* data, Cycles& comp_lat,
+                                 Cycles& decomp_lat);
+
     /**
      * Get the decompression latency if the block is compressed. Latency is 0
      * otherwise.
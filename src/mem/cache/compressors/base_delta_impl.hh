@@ -98,6 +98,28 @@ BaseDelta<BaseType, DeltaSizeBits>::compress(
     return comp_data;
 }
 
+template <class BaseType, std::size_t DeltaSizeBits>
+std::size_t
+BaseDelta<BaseType, DeltaSizeBits>::compressSizeBits(
+    const std::vector<Base::Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    std::size_t size_bits =
+        DictionaryCompressor<BaseType>::compressSizeBits(chunks, comp_lat,
+                                                         decomp_lat);
+
+    // Account for the bases as in compress()
+    const int diff = DEFAULT_MAX_NUM_BASES -
+        DictionaryCompressor<BaseType>::numEntries;
+    if (diff < 0) {
+        size_bits = DictionaryCompressor<BaseType>::blkSize * 8;
+    } else if (diff > 0) {
+        size_bits += 8 * sizeof(BaseType) * diff;
+    }
+
+    return size_bits;
+}
+
 } // namespace compression
 } // namespace gem5
 
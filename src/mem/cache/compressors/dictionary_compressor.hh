@@ -143,6 +143,22 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     template <unsigned N>
     class SignExtendedPattern;
 
+    /**
+     * What the compression of a value needs to know about the pattern it
+     * matches, without instantiating the pattern.
+     */
+    struct PatternInfo
+    {
+        /** Pattern enum number. */
+        int number;
+        /** Index representing the the match location. */
+        int matchLocation;
+        /** Size, in bits, of the pattern. */
+        std::size_t sizeBits;
+        /** Wether the pattern allocates a dictionary entry or not. */
+        bool allocate;
+    };
+
     /**
      * Create a factory to determine if input matches a pattern. The if else
      * chains are constructed by recursion. The patterns should be explored
@@ -168,6 +184,22 @@ class DictionaryCompressor : public BaseDictionaryCompressor
                                                     match_location);
             }
         }
+
+        /**
+         * Same as getPattern(), but the pattern is only built on the stack
+         * to describe it.
+         */
+        static PatternInfo
+        getPatternInfo(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            if (Head::isPattern(bytes, dict_bytes, match_location)) {
+                return Head(bytes, match_location).getInfo();
+            } else {
+                return Factory<Tail...>::getPatternInfo(bytes, dict_bytes,
+                                                        match_location);
+            }
+        }
     };
 
     /**
@@ -189,6 +221,13 @@ class DictionaryCompressor : public BaseDictionaryCompressor
         {
             return std::unique_ptr<Pattern>(new Head(bytes, match_location));
         }
+
+        static PatternInfo
+        getPatternInfo(const DictionaryEntry& bytes,
+            const DictionaryEntry& dict_bytes, const int match_location)
+        {
+            return Head(bytes, match_location).getInfo();
+        }
     };
 
     /** The dictionary. */
@@ -203,6 +242,23 @@ class DictionaryCompressor : public BaseDictionaryCompressor
     getPattern(const DictionaryEntry& bytes, const DictionaryEntry& dict_bytes,
         const int match_location) const = 0;
 
+    /**
+     * Same as getPattern(), but only describes the matching pattern. This
+     * is implemented with the factory's getPatternInfo.
+     */
+    virtual PatternInfo
+    getPatternInfo(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes, const int match_location) const = 0;
+
+    /**
+     * Find the smallest pattern the data matches, either on its own or
+     * against one of the dictionary entries.
+     *
+     * @param bytes Data to be compressed.
+     * @return The best pattern this data matches.
+     */
+    PatternInfo findPattern(const DictionaryEntry& bytes) const;
+
     /**
      * Compress data.
      *
@@ -211,6 +267,16 @@ class DictionaryCompressor : public BaseDictionaryCompressor
      */
     std::unique_ptr<Pattern> compressValue(const T data);
 
+    /**
+     * Compress data, only keeping what is needed to know the compressed
+     * size. The stats and the dictionary are updated as by
+     * compressValue().
+     *
+     * @param data Data to be compressed.
+     * @return The pattern this data matches.
+     */
+    PatternInfo compressValueInfo(const T data);
+
     /**
      * Decompress a pattern into a value that fits in a dictionary entry.
      *
@@ -252,6 +318,17 @@ class DictionaryCompressor : public BaseDictionaryCompressor
 
     using BaseDictionaryCompressor::compress;
 
+    /**
+     * Apply compression, only computing the compressed size.
+     *
+     * @param chunks The cache line to be compressed.
+     * @return Size of the cache line after compression, in bits.
+     */
+    virtual std::size_t compressSizeBits(const std::vector<Chunk>& chunks);
+    std::size_t compressSizeBits(const std::vector<Chunk>& chunks,
+        Cycles& comp_lat, Cycles& decomp_lat) override;
+    using BaseDictionaryCompressor::compressSizeBits;
+
     void decompress(const CompressionData* comp_data, uint64_t* data) override;
 
     /**
@@ -366,6 +443,18 @@ class DictionaryCompressor<T>::Pattern
      */
     bool shouldAllocate() const { return allocate; }
 
+    /**
+     * Describe the pattern.
+     *
+     * @return The information needed to compute a compressed size.
+     */
+    PatternInfo
+    getInfo() const
+    {
+        return PatternInfo{patternNumber, matchLocation, getSizeBits(),
+                           allocate};
+    }
+
     /**
      * Extract pattern's information to a string.
      *
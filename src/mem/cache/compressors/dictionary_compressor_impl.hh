@@ -92,29 +92,42 @@ DictionaryCompressor<T>::instantiateDictionaryCompData() const
 }
 
 template <typename T>
-std::unique_ptr<typename DictionaryCompressor<T>::Pattern>
-DictionaryCompressor<T>::compressValue(const T data)
+typename DictionaryCompressor<T>::PatternInfo
+DictionaryCompressor<T>::findPattern(const DictionaryEntry& bytes) const
 {
-    // Split data in bytes
-    const DictionaryEntry bytes = toDictionaryEntry(data);
-
     // Start as a no-match pattern. A negative match location is used so that
     // patterns that depend on the dictionary entry don't match
-    std::unique_ptr<Pattern> pattern =
-        getPattern(bytes, toDictionaryEntry(0), -1);
+    PatternInfo pattern = getPatternInfo(bytes, toDictionaryEntry(0), -1);
 
-    // Search for word on dictionary
+    // Search for word on dictionary. The candidate patterns are only
+    // described, so that nothing is allocated while searching
     for (std::size_t i = 0; i < numEntries; i++) {
         // Try matching input with possible patterns
-        std::unique_ptr<Pattern> temp_pattern =
-            getPattern(bytes, dictionary[i], i);
+        const PatternInfo temp_pattern =
+            getPatternInfo(bytes, dictionary[i], i);
 
         // Check if found pattern is better than previous
-        if (temp_pattern->getSizeBits() < pattern->getSizeBits()) {
-            pattern = std::move(temp_pattern);
+        if (temp_pattern.sizeBits < pattern.sizeBits) {
+            pattern = temp_pattern;
         }
     }
 
+    return pattern;
+}
+
+template <typename T>
+std::unique_ptr<typename DictionaryCompressor<T>::Pattern>
+DictionaryCompressor<T>::compressValue(const T data)
+{
+    // Split data in bytes
+    const DictionaryEntry bytes = toDictionaryEntry(data);
+
+    // Instantiate the best pattern only
+    const PatternInfo info = findPattern(bytes);
+    std::unique_ptr<Pattern> pattern = getPattern(bytes,
+        (info.matchLocation < 0) ? toDictionaryEntry(0) :
+        dictionary[info.matchLocation], info.matchLocation);
+
     // Update stats
     dictionaryStats.patterns[pattern->getPatternNumber()]++;
 
@@ -126,6 +139,26 @@ DictionaryCompressor<T>::compressValue(const T data)
     return pattern;
 }
 
+template <typename T>
+typename DictionaryCompressor<T>::PatternInfo
+DictionaryCompressor<T>::compressValueInfo(const T data)
+{
+    // Split data in bytes
+    const DictionaryEntry bytes = toDictionaryEntry(data);
+
+    const PatternInfo pattern = findPattern(bytes);
+
+    // Update stats
+    dictionaryStats.patterns[pattern.number]++;
+
+    // Push into dictionary
+    if (pattern.allocate) {
+        addToDictionary(bytes);
+    }
+
+    return pattern;
+}
+
 template <class T>
 std::unique_ptr<Base::CompressionData>
 DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks)
@@ -164,6 +197,37 @@ DictionaryCompressor<T>::compress(const std::vector<Chunk>& chunks,
     return compress(chunks);
 }
 
+template <class T>
+std::size_t
+DictionaryCompressor<T>::compressSizeBits(const std::vector<Chunk>& chunks)
+{
+    // Reset dictionary
+    resetDictionary();
+
+    // Compress every value sequentially
+    std::size_t size_bits = 0;
+    for (const auto& value : chunks) {
+        size_bits += compressValueInfo(value).sizeBits;
+    }
+
+    return size_bits;
+}
+
+template <class T>
+std::size_t
+DictionaryCompressor<T>::compressSizeBits(const std::vector<Chunk>& chunks,
+    Cycles& comp_lat, Cycles& decomp_lat)
+{
+    // Set latencies based on the degree of parallelization, and any extra
+    // latencies due to shifting or packaging
+    comp_lat = Cycles(compExtraLatency +
+        (chunks.size() / compChunksPerCycle));
+    decomp_lat = Cycles(decompExtraLatency +
+        (chunks.size() / decompChunksPerCycle));
+
+    return compressSizeBits(chunks);
+}
+
 template <class T>
 T
 DictionaryCompressor<T>::decompressValue(const Pattern* pattern)
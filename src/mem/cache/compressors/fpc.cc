@@ -81,6 +81,36 @@ FPC::FPCCompData::addEntry(std::unique_ptr<Pattern> pattern)
 FPC::FPC(const Params &p)
   : DictionaryCompressor<uint32_t>(p), zeroRunSizeBits(p.zero_run_bits)
 {
+    ZeroRun zero_run(toDictionaryEntry(0), -1);
+    zero_run.setRealSize(zeroRunSizeBits);
+    zeroRunStartSizeBits = zero_run.getSizeBits();
+}
+
+std::size_t
+FPC::compressSizeBits(const std::vector<Chunk>& chunks)
+{
+    resetDictionary();
+
+    std::size_t size_bits = 0;
+    // Length of the current zero run, negative when not in a run
+    int run_length = -1;
+    for (const auto& value : chunks) {
+        const PatternInfo pattern = compressValueInfo(value);
+        if (pattern.number != ZERO_RUN) {
+            size_bits += pattern.sizeBits;
+            run_length = -1;
+        } else if (run_length < 0 || run_length == mask(zeroRunSizeBits)) {
+            // Either a new run, or the limit for the current run has been
+            // reached, so a new run must be started, with a sized pattern
+            size_bits += zeroRunStartSizeBits;
+            run_length = 0;
+        } else {
+            // The following zeros of the run are not sized
+            run_length++;
+        }
+    }
+
+    return size_bits;
 }
 
 void
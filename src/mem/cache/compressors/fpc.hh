@@ -94,6 +94,9 @@ class FPC : public DictionaryCompressor<uint32_t>
      */
     const int zeroRunSizeBits;
 
+    /** Size, in bits, of the pattern starting a zero run. */
+    std::size_t zeroRunStartSizeBits;
+
     uint64_t getNumPatterns() const override { return NUM_PATTERNS; }
 
     std::string
@@ -113,17 +116,38 @@ class FPC : public DictionaryCompressor<uint32_t>
         return patternNames[number];
     };
 
+    /**
+     * Convenience factory declaration. The templates must be organized by
+     * size, with the smallest first, and "no-match" last.
+     */
+    using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
+        SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
+        SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
+
     std::unique_ptr<Pattern> getPattern(
         const DictionaryEntry& bytes,
         const DictionaryEntry& dict_bytes,
         const int match_location) const override
     {
-        using PatternFactory = Factory<ZeroRun, SignExtended4Bits,
-            SignExtended1Byte, SignExtendedHalfword, ZeroPaddedHalfword,
-            SignExtendedTwoHalfwords, RepBytes, Uncompressed>;
         return PatternFactory::getPattern(bytes, dict_bytes, match_location);
     }
 
+    PatternInfo
+    getPatternInfo(const DictionaryEntry& bytes,
+        const DictionaryEntry& dict_bytes,
+        const int match_location) const override
+    {
+        return PatternFactory::getPatternInfo(bytes, dict_bytes,
+                                              match_location);
+    }
+
+    /**
+     * The zero runs are accounted for as in FPCCompData::addEntry(): only
+     * the first zero of a run, and of every split of a run, has a size.
+     */
+    std::size_t compressSizeBits(const std::vector<Chunk>& chunks) override;
+    using DictionaryCompressor<uint32_t>::compressSizeBits;
+
     void addToDictionary(const DictionaryEntry data) override;
 
     std::unique_ptr<DictionaryCompressor::CompData>
@@ -33,8 +33,10 @@
 
 #include "mem/cache/compressors/multi.hh"
 
+#include <algorithm>
+#include <climits>
 #include <cmath>
-#include <queue>
+#include <cstring>
 
 #include "base/bitfield.hh"
 #include "base/logging.hh"
@@ -87,100 +89,108 @@ Multi::setCache(BaseCache *_cache)
     }
 }
 
-std::unique_ptr<Base::CompressionData>
-Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
-    Cycles& decomp_lat)
+const Multi::Results&
+Multi::rankCompressors(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    std::vector<std::unique_ptr<CompressionData>>* comp_data)
 {
-    struct Results
-    {
-        unsigned index;
-        std::unique_ptr<Base::CompressionData> compData;
-        Cycles decompLat;
-        uint8_t compressionFactor;
-
-        Results(unsigned index,
-            std::unique_ptr<Base::CompressionData> comp_data,
-            Cycles decomp_lat, std::size_t blk_size)
-            : index(index), compData(std::move(comp_data)),
-              decompLat(decomp_lat)
-        {
-            const std::size_t size = compData->getSize();
-            // If the compressed size is worse than the uncompressed size,
-            // we assume the size is the uncompressed size, and thus the
-            // compression factor is 1.
-            //
-            // Some compressors (notably the zero compressor) may rely on
-            // extra information being stored in the tags, or added in
-            // another compression layer. Their size can be 0, so it is
-            // assigned the highest possible compression factor (the original
-            // block's size).
-            compressionFactor = (size > blk_size) ? 1 :
-                ((size == 0) ? blk_size :
-                alignToPowerOfTwo(std::floor(blk_size / (double) size)));
-        }
-    };
-    struct ResultsComparator
-    {
-        bool
-        operator()(const std::shared_ptr<Results>& lhs,
-            const std::shared_ptr<Results>& rhs) const
-        {
-            const std::size_t lhs_cf = lhs->compressionFactor;
-            const std::size_t rhs_cf = rhs->compressionFactor;
-
-            if (lhs_cf == rhs_cf) {
-                // When they have similar compressed sizes, give the one
-                // with fastest decompression privilege
-                return lhs->decompLat > rhs->decompLat;
-            }
-            return lhs_cf < rhs_cf;
-        }
-    };
-
     // Each sub-compressor can have its own chunk size; therefore, revert
     // the chunks to raw data, so that they handle the conversion internally
     uint64_t data[blkSize / sizeof(uint64_t)];
     std::memset(data, 0, blkSize);
     fromChunks(chunks, data);
 
-    // Find the ranking of the compressor outputs
-    std::priority_queue<std::shared_ptr<Results>,
-        std::vector<std::shared_ptr<Results>>, ResultsComparator> results;
+    results.resize(compressors.size());
     Cycles max_comp_lat;
     for (unsigned i = 0; i < compressors.size(); i++) {
         Cycles temp_decomp_lat;
-        auto temp_comp_data =
-            compressors[i]->compress(data, comp_lat, temp_decomp_lat);
-        temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
-            numEncodingBits);
-        results.push(std::make_shared<Results>(i, std::move(temp_comp_data),
-            temp_decomp_lat, blkSize));
+        std::size_t size_bits;
+        if (comp_data) {
+            auto temp_comp_data =
+                compressors[i]->compress(data, comp_lat, temp_decomp_lat);
+            temp_comp_data->setSizeBits(temp_comp_data->getSizeBits() +
+                numEncodingBits);
+            size_bits = temp_comp_data->getSizeBits();
+            (*comp_data)[i] = std::move(temp_comp_data);
+        } else {
+            size_bits = compressors[i]->compressSizeBits(data, comp_lat,
+                temp_decomp_lat) + numEncodingBits;
+        }
         max_comp_lat = std::max(max_comp_lat, comp_lat);
-    }
 
-    // Assign best compressor to compression data
-    const unsigned best_index = results.top()->index;
-    std::unique_ptr<CompressionData> multi_comp_data =
-        std::unique_ptr<MultiCompData>(
-            new MultiCompData(best_index, std::move(results.top()->compData)));
-    DPRINTF(CacheComp, "Best compressor: %d\n", best_index);
+        // If the compressed size is worse than the uncompressed size,
+        // we assume the size is the uncompressed size, and thus the
+        // compression factor is 1.
+        //
+        // Some compressors (notably the zero compressor) may rely on
+        // extra information being stored in the tags, or added in
+        // another compression layer. Their size can be 0, so it is
+        // assigned the highest possible compression factor (the original
+        // block's size).
+        const std::size_t size = size_bits / CHAR_BIT;
+        results[i].index = i;
+        results[i].sizeBits = size_bits;
+        results[i].decompLat = temp_decomp_lat;
+        results[i].compressionFactor = (size > blkSize) ? 1 :
+            ((size == 0) ? blkSize :
+            alignToPowerOfTwo(std::floor(blkSize / (double) size)));
+    }
 
-    // Set decompression latency of the best compressor
-    decomp_lat = results.top()->decompLat + decompExtraLatency;
+    // Find the ranking of the compressor outputs. When they have similar
+    // compressed sizes, give the one with fastest decompression privilege,
+    // and then the first one
+    std::stable_sort(results.begin(), results.end(),
+        [](const Results& lhs, const Results& rhs)
+        {
+            if (lhs.compressionFactor == rhs.compressionFactor) {
+                return lhs.decompLat < rhs.decompLat;
+            }
+            return lhs.compressionFactor > rhs.compressionFactor;
+        });
+    DPRINTF(CacheComp, "Best compressor: %d\n", results.front().index);
 
     // Update compressor ranking stats
     for (int rank = 0; rank < compressors.size(); rank++) {
-        multiStats.ranks[results.top()->index][rank]++;
-        results.pop();
+        multiStats.ranks[results[rank].index][rank]++;
     }
 
     // Set compression latency (compression latency of the slowest compressor
     // and 1 cycle to pack)
     comp_lat = Cycles(max_comp_lat + compExtraLatency);
 
+    return results.front();
+}
+
+std::unique_ptr<Base::CompressionData>
+Multi::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    std::vector<std::unique_ptr<CompressionData>> comp_data(
+        compressors.size());
+    const Results& best = rankCompressors(chunks, comp_lat, &comp_data);
+
+    // Assign best compressor to compression data
+    std::unique_ptr<CompressionData> multi_comp_data =
+        std::unique_ptr<MultiCompData>(
+            new MultiCompData(best.index, std::move(comp_data[best.index])));
+
+    // Set decompression latency of the best compressor
+    decomp_lat = best.decompLat + decompExtraLatency;
+
     return multi_comp_data;
 }
 
+std::size_t
+Multi::compressSizeBits(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    const Results& best = rankCompressors(chunks, comp_lat, nullptr);
+
+    // Set decompression latency of the best compressor
+    decomp_lat = best.decompLat + decompExtraLatency;
+
+    return best.sizeBits;
+}
+
 void
 Multi::decompress(const CompressionData* comp_data,
     uint64_t* cache_line)
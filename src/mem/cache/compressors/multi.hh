@@ -101,6 +101,45 @@ class Multi : public Base
         statistics::Vector2d ranks;
     } multiStats;
 
+    /** Outcome of the compression of a line by a sub-compressor. */
+    struct Results
+    {
+        /** Index of the sub-compressor. */
+        unsigned index;
+        /** Compressed size, including the encoding bits. */
+        std::size_t sizeBits;
+        /** Decompression latency of the sub-compressor. */
+        Cycles decompLat;
+        /** Compression factor, rounded to a power of two. */
+        uint8_t compressionFactor;
+    };
+
+    /**
+     * Results of the sub-compressors for the line being compressed. Kept
+     * here so that they are not reallocated for every block.
+     */
+    std::vector<Results> results;
+
+    /**
+     * Compress the line with every sub-compressor, rank their results from
+     * best to worst, and update the ranking stats. Both the full and the
+     * size only compressions use it, so that they choose the same
+     * sub-compressor.
+     *
+     * @param chunks The cache line to be compressed, divided into chunks.
+     * @param comp_lat Latency of the slowest sub-compressor.
+     * @param comp_data If not null, the compression data of each
+     *        sub-compressor is stored there. Otherwise the sub-compressors
+     *        only compute the compressed sizes.
+     * @return The results of the best sub-compressor.
+     */
+    const Results& rankCompressors(const std::vector<Chunk>& chunks,
+        Cycles& comp_lat,
+        std::vector<std::unique_ptr<CompressionData>>* comp_data);
+
+    std::size_t compressSizeBits(const std::vector<Base::Chunk>& chunks,
+        Cycles& comp_lat, Cycles& decomp_lat) override;
+
   public:
     typedef MultiCompressorParams Params;
     Multi(const Params &p);
@@ -82,5 +82,23 @@ RepeatedQwords::compress(const std::vector<Chunk>& chunks,
     return comp_data;
 }
 
+std::size_t
+RepeatedQwords::compressSizeBits(const std::vector<Chunk>& chunks,
+    Cycles& comp_lat, Cycles& decomp_lat)
+{
+    std::size_t size_bits = DictionaryCompressor::compressSizeBits(chunks);
+
+    // If there is more than one value, the compressor failed
+    assert(numEntries >= 1);
+    if (numEntries > 1) {
+        size_bits = blkSize * 8;
+    }
+
+    comp_lat = Cycles(1);
+    decomp_lat = Cycles(1);
+
+    return size_bits;
+}
+
 } // namespace compression
 } // namespace gem5
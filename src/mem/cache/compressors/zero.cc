@@ -80,5 +80,22 @@ Zero::compress(const std::vector<Chunk>& chunks, Cycles& comp_lat,
     return comp_data;
 }
 
+std::size_t
+Zero::compressSizeBits(const std::vector<Chunk>& chunks, Cycles& comp_lat,
+    Cycles& decomp_lat)
+{
+    std::size_t size_bits = DictionaryCompressor::compressSizeBits(chunks);
+
+    // If there is any non-zero entry, the compressor failed
+    if (numEntries > 0) {
+        size_bits = blkSize * 8;
+    }
+
+    comp_lat = Cycles(1);
+    decomp_lat = Cycles(1);
+
+    return size_bits;
+}
+
 } // namespace compression
 } // namespace gem5
@@ -40,6 +40,81 @@ GEM5_DEPRECATED_NAMESPACE(Prefetcher, prefetch);
 namespace prefetch
 {
 
+namespace
+{
+
+/** Place a word in a bit vector, starting at bit pos. */
+void
+orWord(std::vector<uint64_t> &dst, size_t pos, uint64_t word)
+{
+    const size_t idx = pos / 64;
+    const size_t shift = pos % 64;
+    dst[idx] |= word << shift;
+    if (shift && idx + 1 < dst.size())
+        dst[idx + 1] |= word >> (64 - shift);
+}
+
+/** Copy bits [0, count) of src to dst starting at bit at. */
+void
+insertBits(std::vector<uint64_t> &dst, size_t at,
+           const std::vector<uint64_t> &src, size_t count)
+{
+    for (size_t i = 0; i < count; i += 64) {
+        const size_t n = std::min<size_t>(64, count - i);
+        orWord(dst, at + i, src[i / 64] & mask(n));
+    }
+}
+
+/** Set bits [at, at + count) of dst. */
+void
+fillBits(std::vector<uint64_t> &dst, size_t at, size_t count)
+{
+    for (size_t i = 0; i < count; i += 64)
+        orWord(dst, at + i, mask(std::min<size_t>(64, count - i)));
+}
+
+/**
+ * Make dst bits [0, count) a copy of src bits [start, start + count).
+ * Bits past the end of src read as zero.
+ */
+void
+extractBits(std::vector<uint64_t> &dst, const std::vector<uint64_t> &src,
+            size_t start, size_t count)
+{
+    dst.resize(divCeil(count, 64));
+    for (size_t i = 0; i < dst.size(); i++) {
+        const size_t idx = (start + 64 * i) / 64;
+        const size_t shift = (start + 64 * i) % 64;
+        uint64_t word = idx < src.size() ? src[idx] >> shift : 0;
+        if (shift && idx + 1 < src.size())
+            word |= src[idx + 1] << (64 - shift);
+        dst[i] = word;
+    }
+    if (count % 64)
+        dst.back() &= mask(count % 64);
+}
+
+/** Make dst bits [0, count) the even numbered bits of src. */
+void
+compressEven(std::vector<uint64_t> &dst, const std::vector<uint64_t> &src,
+             size_t count)
+{
+    dst.assign(divCeil(count, 64), 0);
+    for (size_t i = 0; i < src.size() && i / 2 < dst.size(); i++) {
+        uint64_t x = src[i] & 0x5555555555555555ULL;
+        x = (x | (x >> 1)) & 0x3333333333333333ULL;
+        x = (x | (x >> 2)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x >> 4)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x >> 8)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x >> 16)) & 0x00000000FFFFFFFFULL;
+        dst[i / 2] |= x << (32 * (i % 2));
+    }
+    if (count % 64)
+        dst.back() &= mask(count % 64);
+}
+
+} // anonymous namespace
+
 AccessMapPatternMatching::AccessMapPatternMatching(
     const AccessMapPatternMatchingParams &p)
     : ClockedObject(p), blkSize(p.block_size), limitStride(p.limit_stride),
@@ -124,8 +199,8 @@ void
 AccessMapPatternMatching::setEntryState(AccessMapEntry &entry,
     Addr block, enum AccessMapState state)
 {
-    enum AccessMapState old = entry.states[block];
-    entry.states[block] = state;
+    enum AccessMapState old = entry.getState(block);
+    entry.setState(block, state);
 
     //do not update stats when initializing
     if (state == AM_INIT) return;
@@ -182,80 +257,146 @@ AccessMapPatternMatching::calculatePrefetch(const Base::PrefetchInfo &pfi,
     setEntryState(*am_entry_curr, current_block, AM_ACCESS);
 
     /**
-     * Create a contiguous copy of the 3 entries states.
-     * With this, we avoid doing boundaries checking in the loop that looks
-     * for prefetch candidates, mark out of range positions with AM_INVALID
+     * Lay the bit planes of the 3 entries out back to back, forwards and
+     * reversed. This snapshots the states, so marking prefetches below
+     * doesn't affect the search, and avoids bounds checking: the lines of
+     * a missing zone are neither valid nor accessed.
+     *
+     * am_entry_prev => window bits [               0 ..   lines_per_zone-1]
+     * am_entry_curr => window bits [  lines_per_zone .. 2*lines_per_zone-1]
+     * am_entry_next => window bits [2*lines_per_zone .. 3*lines_per_zone-1]
+     *
+     * In the reversed planes bit i is bit 3*lines_per_zone-1-i of the above.
      */
-    std::vector<AccessMapState> states(3 * lines_per_zone);
-    for (unsigned idx = 0; idx < lines_per_zone; idx += 1) {
-        states[idx] =
-            am_entry_prev != nullptr ? am_entry_prev->states[idx] : AM_INVALID;
-        states[idx + lines_per_zone] = am_entry_curr->states[idx];
-        states[idx + 2 * lines_per_zone] =
-            am_entry_next != nullptr ? am_entry_next->states[idx] : AM_INVALID;
+    const size_t window_words = divCeil(3 * lines_per_zone, 64);
+    window.accessed.assign(window_words, 0);
+    window.accessedRev.assign(window_words, 0);
+    window.valid.assign(window_words, 0);
+    window.validRev.assign(window_words, 0);
+    const AccessMapEntry *zones[3] = {
+        am_entry_prev, am_entry_curr, am_entry_next };
+    for (int zone = 0; zone < 3; zone++) {
+        const AccessMapEntry *entry = zones[zone];
+        if (!entry)
+            continue;
+        const size_t at = zone * lines_per_zone;
+        const size_t rev_at = (2 - zone) * lines_per_zone;
+        insertBits(window.accessed, at, entry->accessed, lines_per_zone);
+        insertBits(window.accessedRev, rev_at, entry->accessedRev,
+                   lines_per_zone);
+        fillBits(window.valid, at, lines_per_zone);
+        fillBits(window.validRev, rev_at, lines_per_zone);
     }
 
-    /**
-     * am_entry_prev->states => states[               0 ..   lines_per_zone-1]
-     * am_entry_curr->states => states[  lines_per_zone .. 2*lines_per_zone-1]
-     * am_entry_next->states => states[2*lines_per_zone .. 3*lines_per_zone-1]
-     */
-
-    // index of the current_block in the new vector
+    // index of the current_block in the window
     Addr states_current_block = current_block + lines_per_zone;
     // consider strides 1..lines_per_zone/2
     int max_stride = limitStride == 0 ? lines_per_zone / 2 : limitStride + 1;
-    for (int stride = 1; stride < max_stride; stride += 1) {
-        // Test accessed positive strides
-        if (checkCandidate(states, states_current_block, stride)) {
-            // candidate found, current_block - stride
-            Addr pf_addr;
-            if (stride > current_block) {
-                // The index (current_block - stride) falls in the range of
-                // the previous zone (am_entry_prev), adjust the address
-                // accordingly
-                Addr blk = states_current_block - stride;
-                pf_addr = (am_addr - 1) * hotZoneSize + blk * blkSize;
-                setEntryState(*am_entry_prev, blk, AM_PREFETCH);
-            } else {
-                // The index (current_block - stride) falls within
-                // am_entry_curr
-                Addr blk = current_block - stride;
-                pf_addr = am_addr * hotZoneSize + blk * blkSize;
-                setEntryState(*am_entry_curr, blk, AM_PREFETCH);
-            }
-            addresses.push_back(Queued::AddrPriority(pf_addr, 0));
-            if (addresses.size() == degree) {
-                break;
-            }
-        }
+    if (max_stride <= 1)
+        return;
+
+    std::vector<uint64_t> &pos = window.posCandidates;
+    std::vector<uint64_t> &neg = window.negCandidates;
+    findCandidates(states_current_block, max_stride - 1, pos, neg);
+
+    // Go through the candidates by increasing stride, positive stride
+    // first, stopping once enough prefetches have been generated
+    for (size_t word = 0; word < pos.size(); word++) {
+        uint64_t pending = pos[word] | neg[word];
+        while (pending) {
+            const int bit = findLsbSet(pending);
+            pending &= pending - 1;
+            const Addr stride = 64 * word + bit + 1;
 
-        // Test accessed negative strides
-        if (checkCandidate(states, states_current_block, -stride)) {
-            // candidate found, current_block + stride
-            Addr pf_addr;
-            if (current_block + stride >= lines_per_zone) {
-                // The index (current_block + stride) falls in the range of
-                // the next zone (am_entry_next), adjust the address
-                // accordingly
-                Addr blk = (states_current_block + stride) % lines_per_zone;
-                pf_addr = (am_addr + 1) * hotZoneSize + blk * blkSize;
-                setEntryState(*am_entry_next, blk, AM_PREFETCH);
-            } else {
-                // The index (current_block + stride) falls within
-                // am_entry_curr
-                Addr blk = current_block + stride;
-                pf_addr = am_addr * hotZoneSize + blk * blkSize;
-                setEntryState(*am_entry_curr, blk, AM_PREFETCH);
+            if (bits(pos[word], bit)) {
+                // candidate found, current_block - stride
+                Addr pf_addr;
+                if (stride > current_block) {
+                    // The index (current_block - stride) falls in the range
+                    // of the previous zone (am_entry_prev), adjust the
+                    // address accordingly
+                    Addr blk = states_current_block - stride;
+                    pf_addr = (am_addr - 1) * hotZoneSize + blk * blkSize;
+                    setEntryState(*am_entry_prev, blk, AM_PREFETCH);
+                } else {
+                    // The index (current_block - stride) falls within
+                    // am_entry_curr
+                    Addr blk = current_block - stride;
+                    pf_addr = am_addr * hotZoneSize + blk * blkSize;
+                    setEntryState(*am_entry_curr, blk, AM_PREFETCH);
+                }
+                addresses.push_back(Queued::AddrPriority(pf_addr, 0));
+                if (addresses.size() == degree) {
+                    return;
+                }
             }
-            addresses.push_back(Queued::AddrPriority(pf_addr, 0));
-            if (addresses.size() == degree) {
-                break;
+
+            if (bits(neg[word], bit)) {
+                // candidate found, current_block + stride
+                Addr pf_addr;
+                if (current_block + stride >= lines_per_zone) {
+                    // The index (current_block + stride) falls in the range
+                    // of the next zone (am_entry_next), adjust the address
+                    // accordingly
+                    Addr blk =
+                        (states_current_block + stride) % lines_per_zone;
+                    pf_addr = (am_addr + 1) * hotZoneSize + blk * blkSize;
+                    setEntryState(*am_entry_next, blk, AM_PREFETCH);
+                } else {
+                    // The index (current_block + stride) falls within
+                    // am_entry_curr
+                    Addr blk = current_block + stride;
+                    pf_addr = am_addr * hotZoneSize + blk * blkSize;
+                    setEntryState(*am_entry_curr, blk, AM_PREFETCH);
+                }
+                addresses.push_back(Queued::AddrPriority(pf_addr, 0));
+                if (addresses.size() == degree) {
+                    return;
+                }
             }
         }
     }
 }
 
+void
+AccessMapPatternMatching::findCandidates(Addr current, size_t num_strides,
+    std::vector<uint64_t> &pos, std::vector<uint64_t> &neg)
+{
+    const size_t last = 3 * (hotZoneSize / blkSize) - 1;
+    const size_t k = num_strides;
+
+    // Each mask has bit j set when the line for stride j + 1 qualifies.
+    // Lines at current + stride are a forward run of the window, lines at
+    // current - stride a forward run of the reversed window, and lines at
+    // current +/- 2 * stride every other bit of a run twice as long.
+    auto candidates = [&](const std::vector<uint64_t> &fwd, size_t fwd_at,
+                          const std::vector<uint64_t> &tgt_valid,
+                          size_t tgt_at, int odd_step,
+                          std::vector<uint64_t> &out) {
+        extractBits(window.s, fwd, fwd_at + 1, k);
+        extractBits(window.tmp, fwd, fwd_at + 2, 2 * k);
+        compressEven(window.s2, window.tmp, k);
+        extractBits(window.tmp, fwd, fwd_at + 2 + odd_step, 2 * k);
+        compressEven(window.s2p1, window.tmp, k);
+        extractBits(window.tgt, tgt_valid, tgt_at, k);
+        out.resize(window.s.size());
+        for (size_t i = 0; i < out.size(); i++) {
+            out[i] = window.tgt[i] & window.s[i] &
+                (window.s2[i] | window.s2p1[i]);
+        }
+    };
+
+    // Positive strides: current + k, current + 2k and current + 2k + 1
+    // must have been accessed, and current - k must be valid.
+    candidates(window.accessed, current, window.validRev,
+               last + 1 - current, 1, pos);
+    // Negative strides: the same mirrored, so current - k, current - 2k
+    // and current - 2k + 1 must have been accessed (the latter is one
+    // step back in the reversed window), and current + k must be valid.
+    candidates(window.accessedRev, last - current, window.valid,
+               current + 1, -1, neg);
+}
+
 AMPM::AMPM(const AMPMPrefetcherParams &p)
   : Queued(p), ampm(*p.ampm)
 {
@@ -38,6 +38,11 @@
 #ifndef __MEM_CACHE_PREFETCH_ACCESS_MAP_PATTERN_MATCHING_HH__
 #define __MEM_CACHE_PREFETCH_ACCESS_MAP_PATTERN_MATCHING_HH__
 
+#include <algorithm>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/intmath.hh"
 #include "mem/cache/prefetch/associative_set.hh"
 #include "mem/cache/prefetch/queued.hh"
 #include "mem/packet.hh"
@@ -89,24 +94,60 @@ class AccessMapPatternMatching : public ClockedObject
         AM_INVALID
     };
 
-    /** AccessMapEntry data type */
+    /**
+     * AccessMapEntry data type. The state of each cacheline takes two
+     * bits, one in each of the accessed and prefetched bit planes, so that
+     * prefetch candidates can be found with whole word bitmask operations
+     * rather than by walking the lines one by one.
+     */
     struct AccessMapEntry : public TaggedEntry
     {
-        /** vector containing the state of the cachelines in this zone */
-        std::vector<AccessMapState> states;
+        /** Number of cachelines in the zone */
+        size_t numLines;
+        /** Lines in the AM_ACCESS state, line i at bit i */
+        std::vector<uint64_t> accessed;
+        /** Same as accessed, but line i at bit numLines - 1 - i */
+        std::vector<uint64_t> accessedRev;
+        /** Lines in the AM_PREFETCH state, line i at bit i */
+        std::vector<uint64_t> prefetched;
 
         AccessMapEntry(size_t num_entries)
-          : TaggedEntry(), states(num_entries, AM_INIT)
+          : TaggedEntry(), numLines(num_entries),
+            accessed(divCeil(num_entries, 64), 0),
+            accessedRev(divCeil(num_entries, 64), 0),
+            prefetched(divCeil(num_entries, 64), 0)
         {
         }
 
+        AccessMapState
+        getState(Addr line) const
+        {
+            if (bits(accessed[line / 64], line % 64))
+                return AM_ACCESS;
+            if (bits(prefetched[line / 64], line % 64))
+                return AM_PREFETCH;
+            return AM_INIT;
+        }
+
+        void
+        setState(Addr line, AccessMapState state)
+        {
+            assert(state != AM_INVALID);
+            Addr rev = numLines - 1 - line;
+            replaceBits(accessed[line / 64], line % 64, state == AM_ACCESS);
+            replaceBits(accessedRev[rev / 64], rev % 64,
+                        state == AM_ACCESS);
+            replaceBits(prefetched[line / 64], line % 64,
+                        state == AM_PREFETCH);
+        }
+
         void
         invalidate() override
         {
             TaggedEntry::invalidate();
-            for (auto &entry : states) {
-                entry = AM_INIT;
-            }
+            std::fill(accessed.begin(), accessed.end(), 0);
+            std::fill(accessedRev.begin(), accessedRev.end(), 0);
+            std::fill(prefetched.begin(), prefetched.end(), 0);
         }
     };
     /** Access map table */
@@ -138,25 +179,32 @@ class AccessMapPatternMatching : public ClockedObject
     unsigned usefulDegree;
 
     /**
-     * Given a target cacheline, this function checks if the cachelines
-     * that follow the provided stride have been accessed. If so, the line
-     * is considered a good candidate.
-     * @param states vector containing the states of three contiguous hot zones
-     * @param current target block (cacheline)
-     * @param stride access stride to obtain the reference cachelines
-     * @return true if current is a prefetch candidate
+     * Bit planes of the previous, current and next zones laid out back to
+     * back, rebuilt for every access. Kept here to reuse their storage.
      */
-    inline bool checkCandidate(std::vector<AccessMapState> const &states,
-                        Addr current, int stride) const
+    struct Window
     {
-        enum AccessMapState tgt   = states[current - stride];
-        enum AccessMapState s     = states[current + stride];
-        enum AccessMapState s2    = states[current + 2 * stride];
-        enum AccessMapState s2_p1 = states[current + 2 * stride + 1];
-        return (tgt != AM_INVALID &&
-                ((s == AM_ACCESS && s2 == AM_ACCESS) ||
-                (s == AM_ACCESS && s2_p1 == AM_ACCESS)));
-    }
+        /** Accessed lines, and the lines of the zones which exist */
+        std::vector<uint64_t> accessed, valid;
+        /** The same with the window reversed */
+        std::vector<uint64_t> accessedRev, validRev;
+        /** Per stride masks used while looking for candidates */
+        std::vector<uint64_t> tmp, s, s2, s2p1, tgt;
+        std::vector<uint64_t> posCandidates, negCandidates;
+    } window;
+
+    /**
+     * Find the prefetch candidates around a line of the window. For each
+     * stride k, bit k - 1 of pos is set if line current - k is a candidate
+     * (lines current + k and current + 2k or current + 2k + 1 have been
+     * accessed, and current - k belongs to an existing zone), and bit
+     * k - 1 of neg if line current + k is one (the same, mirrored).
+     * @param current target block (cacheline) within the window
+     * @param num_strides strides 1 to num_strides are checked
+     */
+    void findCandidates(Addr current, size_t num_strides,
+                        std::vector<uint64_t> &pos,
+                        std::vector<uint64_t> &neg);
 
     /**
      * Obtain an AccessMapEntry  from the AccessMapTable, if the entry is not
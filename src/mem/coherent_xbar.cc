@@ -181,8 +181,11 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // store the old header delay so we can restore it if needed
     Tick old_header_delay = pkt->headerDelay;
 
-    // a request sees the frontend and forward latency
+    // a request sees the frontend and forward latency, and waits for
+    // the layer if forwarded in a burst
     Tick xbar_delay = (frontendLatency + forwardLatency) * clockPeriod();
+    if (!is_express_snoop)
+        xbar_delay += reqLayers[mem_side_port_id]->burstDelay();
 
     // set the packet header and payload delay
     calcPacketTiming(pkt, xbar_delay);
@@ -472,8 +475,10 @@ CoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
     unsigned int pkt_cmd = pkt->cmdToIndex();
 
-    // a response sees the response latency
-    Tick xbar_delay = responseLatency * clockPeriod();
+    // a response sees the response latency, and waits for the layer
+    // if forwarded in a burst
+    Tick xbar_delay = responseLatency * clockPeriod() +
+        respLayers[cpu_side_port_id]->burstDelay();
 
     // set the packet header and payload delay
     calcPacketTiming(pkt, xbar_delay);
@@ -619,10 +624,13 @@ CoherentXBar::recvTimingSnoopResp(PacketPtr pkt, PortID cpu_side_port_id)
     assert(!pkt->isExpressSnoop());
 
     // a snoop response sees the snoop response latency, and if it is
-    // forwarded as a normal response, the response latency
+    // forwarded as a normal response, the response latency, and waits
+    // for the layer if forwarded in a burst
     Tick xbar_delay =
         (forwardAsSnoop ? snoopResponseLatency : responseLatency) *
-        clockPeriod();
+        clockPeriod() + (forwardAsSnoop ?
+                         snoopLayers[dest_port_id]->burstDelay() :
+                         respLayers[dest_port_id]->burstDelay());
 
     // set the packet header and payload delay
     calcPacketTiming(pkt, xbar_delay);
@@ -46,6 +46,7 @@
 #include "debug/DRAM.hh"
 #include "debug/DRAMPower.hh"
 #include "debug/DRAMState.hh"
+#include "sim/core.hh"
 #include "sim/system.hh"
 
 namespace gem5
@@ -369,6 +370,11 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
     // for the state we need to track if it is a row hit or not
     bool row_hit = true;
 
+    recordRowOutcome(mem_pkt,
+                     bank_ref.openRow == mem_pkt->row ? DRAMRowTrace::Hit :
+                     bank_ref.openRow == Bank::NO_ROW ? DRAMRowTrace::Miss :
+                     DRAMRowTrace::Conflict);
+
     // Determine the access latency and update the bank state
     if (bank_ref.openRow == mem_pkt->row) {
         // nothing to do
@@ -616,6 +622,51 @@ DRAMInterface::doBurstAccess(MemPacket* mem_pkt, Tick next_burst_at,
     return std::make_pair(cmd_at, cmd_at + burst_gap);
 }
 
+void
+DRAMInterface::recordRowOutcome(const MemPacket* mem_pkt,
+                                DRAMRowTrace::Outcome outcome)
+{
+    // only sample one in every rowStatsSamplePeriod bursts into the
+    // address region histograms, as they are sparse
+    bool sample = false;
+    if (rowStatsSamplePeriod && --rowStatsCountdown == 0) {
+        rowStatsCountdown = rowStatsSamplePeriod;
+        sample = true;
+    }
+    const Addr region = mem_pkt->getAddr() & rowStatsRegionMask;
+
+    switch (outcome) {
+      case DRAMRowTrace::Hit:
+        stats.perBankRowHits[mem_pkt->bankId]++;
+        if (sample)
+            stats.regionRowHits.sample(region);
+        break;
+      case DRAMRowTrace::Miss:
+        stats.perBankRowMisses[mem_pkt->bankId]++;
+        if (sample)
+            stats.regionRowMisses.sample(region);
+        break;
+      default:
+        stats.perBankRowConflicts[mem_pkt->bankId]++;
+        if (sample)
+            stats.regionRowConflicts.sample(region);
+        break;
+    }
+
+    if (rowTrace)
+        rowTrace->record(curTick(), mem_pkt->bankId, outcome);
+}
+
+void
+DRAMInterface::closeRowTrace()
+{
+    if (rowTrace) {
+        rowTrace.reset();
+        simout.close(rowTraceStream);
+        rowTraceStream = nullptr;
+    }
+}
+
 void
 DRAMInterface::addRankToRankDelay(Tick cmd_at)
 {
@@ -658,6 +709,10 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
       timeStampOffset(0), activeRank(0),
       enableDRAMPowerdown(_p.enable_dram_powerdown),
       lastStatsResetTick(0),
+      rowStatsSamplePeriod(_p.row_stats_sample_period),
+      rowStatsCountdown(_p.row_stats_sample_period),
+      rowStatsRegionMask(~(Addr(_p.row_stats_region_size) - 1)),
+      rowTraceStream(nullptr),
       stats(*this)
 {
     DPRINTF(DRAM, "Setting up DRAM Interface\n");
@@ -736,6 +791,20 @@ DRAMInterface::DRAMInterface(const DRAMInterfaceParams &_p)
                   tRRD_L, tRRD, bankGroupsPerRank);
         }
     }
+
+    fatal_if(!isPowerOf2(_p.row_stats_region_size), "Row buffer stats "
+             "region size %d is not a power of two\n",
+             _p.row_stats_region_size);
+
+    if (_p.row_trace_interval) {
+        const std::string filename = _p.row_trace_file.empty() ?
+            name() + ".rowtrace" : _p.row_trace_file;
+        rowTraceStream = simout.create(filename, true, true);
+        rowTrace = std::make_unique<DRAMRowTrace>(*rowTraceStream->stream(),
+            banksPerRank * ranksPerChannel, _p.row_trace_interval,
+            sim_clock::Frequency);
+        registerExitCallback([this]() { closeRowTrace(); });
+    }
 }
 
 void
@@ -845,7 +914,8 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
     uint64_t row;
 
     // Get packed address, starting at 0
-    Addr addr = getCtrlAddr(pkt_addr);
+    const Addr ctrl_addr = getCtrlAddr(pkt_addr);
+    Addr addr = ctrl_addr;
 
     // truncate the address to a memory burst, which makes it unique to
     // a specific buffer, row, bank, rank and channel
@@ -900,6 +970,11 @@ DRAMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
     } else
         panic("Unknown address mapping policy chosen!");
 
+    // optionally hash the bank and rank, to spread the accesses that
+    // would otherwise conflict in the same bank
+    bank = xorHash(bank, ctrl_addr, bankXorMasks);
+    rank = xorHash(rank, ctrl_addr, rankXorMasks);
+
     assert(rank < ranksPerChannel);
     assert(bank < banksPerRank);
     assert(row < rowsPerBank);
@@ -1150,6 +1225,13 @@ DRAMInterface::Rank::Rank(const DRAMInterfaceParams &_p,
             banks[b].bankgr = b;
         }
     }
+
+    // Write completions and activations only update the state of this
+    // rank, and schedule its power event, so the ones of different ranks
+    // and channels falling on the same tick can be serviced in parallel.
+    // They are short though, so batching them alone does not pay off.
+    writeDoneEvent.setCommutative();
+    activateEvent.setCommutative();
 }
 
 void
@@ -1883,6 +1965,20 @@ DRAMInterface::DRAMStats::DRAMStats(DRAMInterface &_dram)
 
     ADD_STAT(bytesPerActivate, statistics::units::Byte::get(),
              "Bytes accessed per row activation"),
+    ADD_STAT(perBankRowHits, statistics::units::Count::get(),
+             "Per bank row buffer hits"),
+    ADD_STAT(perBankRowMisses, statistics::units::Count::get(),
+             "Per bank row buffer misses, with the bank precharged"),
+    ADD_STAT(perBankRowConflicts, statistics::units::Count::get(),
+             "Per bank row buffer conflicts, with another row open"),
+
+    ADD_STAT(regionRowHits, statistics::units::Count::get(),
+             "Sampled row buffer hits per address region"),
+    ADD_STAT(regionRowMisses, statistics::units::Count::get(),
+             "Sampled row buffer misses per address region"),
+    ADD_STAT(regionRowConflicts, statistics::units::Count::get(),
+             "Sampled row buffer conflicts per address region"),
+
     ADD_STAT(bytesRead, statistics::units::Byte::get(),
             "Total bytes read"),
     ADD_STAT(bytesWritten, statistics::units::Byte::get(),
@@ -1926,6 +2022,16 @@ DRAMInterface::DRAMStats::regStats()
     perBankRdBursts.init(dram.banksPerRank * dram.ranksPerChannel);
     perBankWrBursts.init(dram.banksPerRank * dram.ranksPerChannel);
 
+    perBankRowHits.init(dram.banksPerRank * dram.ranksPerChannel);
+    perBankRowMisses.init(dram.banksPerRank * dram.ranksPerChannel);
+    perBankRowConflicts.init(dram.banksPerRank * dram.ranksPerChannel);
+
+    // the region histograms are only populated when sampling
+    const auto region_flags = dram.rowStatsSamplePeriod ? pdf : nozero;
+    regionRowHits.init(0).flags(region_flags);
+    regionRowMisses.init(0).flags(region_flags);
+    regionRowConflicts.init(0).flags(region_flags);
+
     bytesPerActivate
         .init(dram.maxAccessesPerRow ?
               dram.maxAccessesPerRow : dram.rowBufferSize)
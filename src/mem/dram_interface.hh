@@ -46,6 +46,10 @@
 #ifndef __DRAM_INTERFACE_HH__
 #define __DRAM_INTERFACE_HH__
 
+#include <memory>
+
+#include "base/output.hh"
+#include "mem/dram_row_trace.hh"
 #include "mem/drampower.hh"
 #include "mem/mem_interface.hh"
 #include "params/DRAMInterface.hh"
@@ -536,6 +540,31 @@ class DRAMInterface : public MemInterface
     /** The time when stats were last reset used to calculate average power */
     Tick lastStatsResetTick;
 
+    /**
+     * Row buffer locality instrumentation. The outcome of every burst
+     * is counted per bank, one in every rowStatsSamplePeriod bursts is
+     * sampled into the address region histograms, and the per bank
+     * timeline is only kept when a trace interval is set.
+     */
+    const uint32_t rowStatsSamplePeriod;
+    uint32_t rowStatsCountdown;
+    const Addr rowStatsRegionMask;
+    OutputStream *rowTraceStream;
+    std::unique_ptr<DRAMRowTrace> rowTrace;
+
+    /**
+     * Account the row buffer outcome of a burst about to be issued.
+     *
+     * @param mem_pkt The burst
+     * @param outcome Whether the row was open, closed, or another row
+     *                was open in the bank
+     */
+    void recordRowOutcome(const MemPacket* mem_pkt,
+                          DRAMRowTrace::Outcome outcome);
+
+    /** Write out and close the row buffer timeline. */
+    void closeRowTrace();
+
     /**
      * Keep track of when row activations happen, in order to enforce
      * the maximum number of activations in the activation window. The
@@ -598,6 +627,17 @@ class DRAMInterface : public MemInterface
         statistics::Formula readRowHitRate;
         statistics::Formula writeRowHitRate;
         statistics::Histogram bytesPerActivate;
+
+        // Row buffer outcomes per bank, reads and writes combined
+        statistics::Vector perBankRowHits;
+        statistics::Vector perBankRowMisses;
+        statistics::Vector perBankRowConflicts;
+
+        // Sampled row buffer outcomes per address region
+        statistics::SparseHistogram regionRowHits;
+        statistics::SparseHistogram regionRowMisses;
+        statistics::SparseHistogram regionRowConflicts;
+
         // Number of bytes transferred to/from DRAM
         statistics::Scalar bytesRead;
         statistics::Scalar bytesWritten;
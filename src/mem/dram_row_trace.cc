@@ -0,0 +1,95 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/dram_row_trace.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "base/logging.hh"
+#include "sim/byteswap.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+constexpr char DRAMRowTrace::magic[8];
+
+DRAMRowTrace::DRAMRowTrace(std::ostream &_os, unsigned num_banks,
+                           Tick _interval, Tick tick_freq)
+    : os(_os), interval(_interval), intervalStart(0),
+      intervalEnd(_interval), counts(num_banks * NumOutcomes, 0)
+{
+    fatal_if(interval == 0, "A row buffer trace needs a non-zero "
+             "interval\n");
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version = htole(version);
+    header.numBanks = htole(uint32_t(num_banks));
+    header.interval = htole(uint64_t(interval));
+    header.tickFreq = htole(uint64_t(tick_freq));
+    os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+bool
+DRAMRowTrace::empty() const
+{
+    return std::all_of(counts.begin(), counts.end(),
+                       [](uint32_t c) { return c == 0; });
+}
+
+void
+DRAMRowTrace::flush()
+{
+    if (empty())
+        return;
+
+    const uint64_t start = htole(uint64_t(intervalStart));
+    os.write(reinterpret_cast<const char *>(&start), sizeof(start));
+    for (auto &c : counts) {
+        const uint32_t count = htole(c);
+        os.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        c = 0;
+    }
+
+    intervalStart = intervalEnd;
+    intervalEnd += interval;
+}
+
+void
+DRAMRowTrace::advance(Tick when)
+{
+    flush();
+    if (when >= intervalEnd) {
+        intervalStart = when - when % interval;
+        intervalEnd = intervalStart + interval;
+    }
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,168 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_DRAM_ROW_TRACE_HH__
+#define __MEM_DRAM_ROW_TRACE_HH__
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * A timeline of the row buffer outcomes of every bank of a DRAM
+ * channel, written to a compact binary stream. Time is divided in fixed
+ * intervals, and for every interval with at least one burst a record
+ * holds the number of row hits, misses and conflicts of each bank. The
+ * counts are kept in memory and only written out when an interval
+ * completes, so recording a burst is an increment. All the fields are
+ * little endian.
+ *
+ * util/plot_dram/row_buffer_heatmap.py turns the timeline into per bank
+ * heatmaps.
+ */
+class DRAMRowTrace
+{
+  public:
+    /** Row buffer outcome of a burst. */
+    enum Outcome
+    {
+        /** The row was already open */
+        Hit,
+        /** The bank was precharged, the row had to be activated */
+        Miss,
+        /** Another row was open, and had to be precharged first */
+        Conflict,
+        NumOutcomes
+    };
+
+    /** Layout of the stream header. */
+    struct Header
+    {
+        /** Identifies the format, see magic */
+        char magic[8];
+        /** Version of the format, see version */
+        uint32_t version;
+        /** Number of banks in a record, all ranks included */
+        uint32_t numBanks;
+        /** Length of an interval, in ticks */
+        uint64_t interval;
+        /** Number of ticks per second */
+        uint64_t tickFreq;
+    };
+
+    static_assert(sizeof(Header) == 32, "Unexpected trace header size");
+
+    /**
+     * Every record starts with the tick of the start of its interval,
+     * as a 64 bit value, followed by NumOutcomes 32 bit counts per bank,
+     * bank after bank.
+     */
+    static constexpr size_t
+    recordSize(unsigned num_banks)
+    {
+        return sizeof(uint64_t) + num_banks * NumOutcomes * sizeof(uint32_t);
+    }
+
+    /** Characters identifying the format at the start of the stream. */
+    static constexpr char magic[8] = {'g', 'e', 'm', '5', 'r', 'o', 'w',
+                                      'b'};
+
+    /** Version of the format. */
+    static constexpr uint32_t version = 1;
+
+    /**
+     * Start a timeline, writing its header.
+     *
+     * @param os Stream to write to, which must outlive the trace
+     * @param num_banks Number of banks, all ranks included
+     * @param interval Length of an interval, in ticks
+     * @param tick_freq Number of ticks per second
+     */
+    DRAMRowTrace(std::ostream &os, unsigned num_banks, Tick interval,
+                 Tick tick_freq);
+
+    /** Write out the interval in progress. */
+    ~DRAMRowTrace() { flush(); }
+
+    DRAMRowTrace(const DRAMRowTrace &) = delete;
+    DRAMRowTrace &operator=(const DRAMRowTrace &) = delete;
+
+    /**
+     * Count a burst. Bursts have to be recorded in tick order. A burst
+     * in an interval which has already been flushed is counted in the
+     * next interval, so that every record has a start of its own.
+     *
+     * @param when Tick of the burst
+     * @param bank Index of the bank, all ranks included
+     * @param outcome Row buffer outcome of the burst
+     */
+    void
+    record(Tick when, unsigned bank, Outcome outcome)
+    {
+        if (when >= intervalEnd)
+            advance(when);
+        ++counts[bank * NumOutcomes + outcome];
+    }
+
+    /**
+     * Write out the interval in progress, if it has any burst, and move
+     * on to the next one.
+     */
+    void flush();
+
+  private:
+    /**
+     * Write out the interval in progress and move on to the interval
+     * holding a tick. Intervals without bursts are skipped.
+     */
+    void advance(Tick when);
+
+    std::ostream &os;
+
+    const Tick interval;
+
+    /** Start and end of the interval in progress */
+    Tick intervalStart;
+    Tick intervalEnd;
+
+    /** Counts of the interval in progress, per bank and outcome */
+    std::vector<uint32_t> counts;
+
+    /** True when the interval in progress has no burst yet */
+    bool empty() const;
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_DRAM_ROW_TRACE_HH__
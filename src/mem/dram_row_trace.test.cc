@@ -0,0 +1,152 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "mem/dram_row_trace.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+/** A record read back from a trace. */
+struct Record
+{
+    uint64_t start;
+    std::vector<uint32_t> counts;
+};
+
+/** Read the header and all the records of a trace. */
+std::vector<Record>
+readTrace(const std::string &data, DRAMRowTrace::Header &header)
+{
+    EXPECT_GE(data.size(), sizeof(header));
+    std::memcpy(&header, data.data(), sizeof(header));
+
+    const size_t size = DRAMRowTrace::recordSize(header.numBanks);
+    EXPECT_EQ((data.size() - sizeof(header)) % size, 0);
+
+    std::vector<Record> records;
+    for (size_t pos = sizeof(header); pos + size <= data.size();
+         pos += size) {
+        Record record;
+        std::memcpy(&record.start, data.data() + pos, sizeof(uint64_t));
+        record.counts.resize(header.numBanks * DRAMRowTrace::NumOutcomes);
+        std::memcpy(record.counts.data(), data.data() + pos +
+                    sizeof(uint64_t), size - sizeof(uint64_t));
+        records.push_back(record);
+    }
+    return records;
+}
+
+} // anonymous namespace
+
+/** The header describes the stream, and nothing else is written. */
+TEST(DRAMRowTraceTest, Header)
+{
+    std::ostringstream os;
+    {
+        DRAMRowTrace trace(os, 16, 1000, 1000000000000);
+    }
+
+    DRAMRowTrace::Header header;
+    auto records = readTrace(os.str(), header);
+    EXPECT_EQ(std::memcmp(header.magic, DRAMRowTrace::magic,
+                          sizeof(header.magic)), 0);
+    EXPECT_EQ(header.version, DRAMRowTrace::version);
+    EXPECT_EQ(header.numBanks, 16);
+    EXPECT_EQ(header.interval, 1000);
+    EXPECT_EQ(header.tickFreq, 1000000000000);
+    EXPECT_TRUE(records.empty());
+}
+
+/**
+ * Bursts are counted per interval, bank and outcome, and intervals
+ * without bursts are skipped.
+ */
+TEST(DRAMRowTraceTest, Intervals)
+{
+    std::ostringstream os;
+    {
+        DRAMRowTrace trace(os, 2, 100, 1000);
+        trace.record(0, 0, DRAMRowTrace::Miss);
+        trace.record(10, 0, DRAMRowTrace::Hit);
+        trace.record(99, 1, DRAMRowTrace::Conflict);
+        trace.record(100, 1, DRAMRowTrace::Hit);
+        trace.record(450, 0, DRAMRowTrace::Conflict);
+        trace.record(450, 0, DRAMRowTrace::Conflict);
+    }
+
+    DRAMRowTrace::Header header;
+    auto records = readTrace(os.str(), header);
+    ASSERT_EQ(records.size(), 3);
+
+    EXPECT_EQ(records[0].start, 0);
+    EXPECT_EQ(records[0].counts,
+              std::vector<uint32_t>({1, 1, 0, 0, 0, 1}));
+    EXPECT_EQ(records[1].start, 100);
+    EXPECT_EQ(records[1].counts,
+              std::vector<uint32_t>({0, 0, 0, 1, 0, 0}));
+    EXPECT_EQ(records[2].start, 400);
+    EXPECT_EQ(records[2].counts,
+              std::vector<uint32_t>({0, 0, 2, 0, 0, 0}));
+}
+
+/**
+ * Flushing writes out the interval in progress only once, and the
+ * bursts which follow in the same interval are counted in the next one
+ * rather than in a record with the same start.
+ */
+TEST(DRAMRowTraceTest, Flush)
+{
+    std::ostringstream os;
+    {
+        DRAMRowTrace trace(os, 1, 100, 1000);
+        trace.record(5, 0, DRAMRowTrace::Hit);
+        trace.flush();
+        trace.flush();
+        trace.record(50, 0, DRAMRowTrace::Miss);
+        trace.record(150, 0, DRAMRowTrace::Conflict);
+        trace.record(320, 0, DRAMRowTrace::Hit);
+    }
+
+    DRAMRowTrace::Header header;
+    auto records = readTrace(os.str(), header);
+    ASSERT_EQ(records.size(), 3);
+    EXPECT_EQ(records[0].start, 0);
+    EXPECT_EQ(records[0].counts, std::vector<uint32_t>({1, 0, 0}));
+    EXPECT_EQ(records[1].start, 100);
+    EXPECT_EQ(records[1].counts, std::vector<uint32_t>({0, 1, 1}));
+    EXPECT_EQ(records[2].start, 300);
+    EXPECT_EQ(records[2].counts, std::vector<uint32_t>({1, 0, 0}));
+}
@@ -0,0 +1,501 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/fast_dram.hh"
+
+#include <algorithm>
+
+#include "base/bitfield.hh"
+#include "base/trace.hh"
+#include "debug/FastDRAM.hh"
+#include "mem/mem_interface.hh"
+#include "sim/stats.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+FastDRAM::FastDRAM(const FastDRAMParams &p) :
+    AbstractMemory(p),
+    port(name() + ".port", *this),
+    addrMapping(p.addr_mapping), pageMgmt(p.page_policy),
+    burstSize((p.devices_per_rank * p.burst_length *
+               p.device_bus_width) / 8),
+    burstsPerRowBuffer(burstSize ?
+                       p.devices_per_rank * p.device_rowbuffer_size /
+                       burstSize : 0),
+    burstsPerStripe(burstSize && range.interleaved() ?
+                    range.granularity() / burstSize : 1),
+    ranksPerChannel(p.ranks_per_channel), banksPerRank(p.banks_per_rank),
+    bankXorMasks(p.bank_xor_masks), rankXorMasks(p.rank_xor_masks),
+    tCL(p.tCL), tCWL(p.tCWL), tRAS(p.tRAS), tWR(p.tWR), tRTP(p.tRTP),
+    tRP(p.tRP), tBURST(p.tBURST), tRFC(p.tRFC), tREFI(p.tREFI),
+    tWTR(p.tWTR), tRTW(p.tRTW), tCS(p.tCS),
+    frontendLatency(p.static_frontend_latency),
+    backendLatency(p.static_backend_latency),
+    readBufferSize(p.read_buffer_size),
+    writeBufferSize(p.write_buffer_size),
+    ranks(p.ranks_per_channel), busBusyUntil(0), lastWasRead(true),
+    lastRank(0), readsQueued(0), writesQueued(0), retryReq(false),
+    releaseEvent([this]{ release(); }, name()),
+    stats(*this)
+{
+    fatal_if(burstSize == 0 || burstsPerRowBuffer == 0,
+             "%s: the burst and row buffer sizes must not be zero\n",
+             name());
+    fatal_if(ranksPerChannel == 0 || banksPerRank == 0,
+             "%s: there must be at least a rank and a bank\n", name());
+    fatal_if(tREFI != 0 && tRFC >= tREFI,
+             "%s: tRFC must be smaller than tREFI\n", name());
+    checkXorMasks(name(), addrMapping, burstSize, burstsPerRowBuffer,
+                  burstsPerStripe, banksPerRank, ranksPerChannel,
+                  bankXorMasks, rankXorMasks);
+
+    for (auto &rank : ranks)
+        rank.banks.resize(banksPerRank);
+
+    // The latency of an access to a closed bank starts with the
+    // activation, and the one of a row conflict with the precharge.
+    // Both end with the data burst.
+    const double scale[NumAccessKinds] = {
+        p.row_hit_scale, p.row_miss_scale, p.row_conflict_scale
+    };
+    const Tick rcd[2] = {p.tRCD, p.tRCD_WR};
+    const Tick cl[2] = {tCL, tCWL};
+    for (int dir = 0; dir < 2; ++dir) {
+        const Tick col = cl[dir] + tBURST;
+        const Tick lat[NumAccessKinds] = {
+            col, rcd[dir] + col, tRP + rcd[dir] + col
+        };
+        for (int kind = 0; kind < NumAccessKinds; ++kind) {
+            fatal_if(scale[kind] < 0, "%s: negative latency scale\n",
+                     name());
+            // the data burst itself is never shortened
+            accessLatency[dir][kind] = std::max<Tick>(tBURST,
+                lat[kind] * scale[kind]);
+        }
+    }
+}
+
+void
+FastDRAM::init()
+{
+    AbstractMemory::init();
+
+    if (port.isConnected()) {
+        port.sendRangeChange();
+    }
+}
+
+Tick
+FastDRAM::recvAtomic(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    access(pkt);
+
+    // the timing state is left alone, assume a closed bank
+    return frontendLatency + backendLatency +
+        accessLatency[pkt->isRead() ? 0 : 1][RowMiss];
+}
+
+Tick
+FastDRAM::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
+{
+    Tick latency = recvAtomic(pkt);
+    getBackdoor(_backdoor);
+    return latency;
+}
+
+void
+FastDRAM::recvFunctional(PacketPtr pkt)
+{
+    pkt->pushLabel(name());
+
+    // the memory is updated when the requests arrive, only the
+    // responses may be more recent
+    if (!port.trySatisfyFunctional(pkt))
+        functionalAccess(pkt);
+
+    pkt->popLabel();
+}
+
+void
+FastDRAM::decode(Addr addr, unsigned &rank, unsigned &bank,
+                 Addr &row) const
+{
+    // get the burst number, relative to the start of the memory
+    const Addr ctrl_addr = range.getOffset(addr);
+    addr = ctrl_addr / burstSize;
+
+    if (addrMapping == enums::RoRaBaChCo ||
+        addrMapping == enums::RoRaBaCoCh) {
+        addr = addr / burstsPerRowBuffer;
+    } else {
+        assert(addrMapping == enums::RoCoRaBaCh);
+        addr = addr / std::min(burstsPerRowBuffer, burstsPerStripe);
+    }
+
+    bank = addr % banksPerRank;
+    addr = addr / banksPerRank;
+
+    rank = addr % ranksPerChannel;
+    addr = addr / ranksPerChannel;
+
+    // the higher order column bits, if any, are above the rank bits
+    if (addrMapping == enums::RoCoRaBaCh &&
+        burstsPerStripe < burstsPerRowBuffer)
+        addr = addr / (burstsPerRowBuffer / burstsPerStripe);
+
+    row = addr;
+
+    // flip the bank and rank bits by the parity of their masks
+    bank = xorHash(bank, ctrl_addr, bankXorMasks);
+    rank = xorHash(rank, ctrl_addr, rankXorMasks);
+}
+
+bool
+FastDRAM::refresh(Rank &rank, Tick &when)
+{
+    if (tREFI == 0)
+        return false;
+
+    // the refresh takes the end of every interval
+    Tick interval = when / tREFI;
+    if (when - interval * tREFI >= tREFI - tRFC) {
+        ++interval;
+        when = interval * tREFI;
+        ++stats.refreshStalls;
+    }
+
+    if (interval == rank.refreshInterval)
+        return false;
+
+    // the refresh leaves all the banks precharged
+    rank.refreshInterval = interval;
+    for (auto &bank : rank.banks)
+        bank.rowOpen = false;
+    return true;
+}
+
+Tick
+FastDRAM::reserve(Addr addr, bool is_read, Tick arrival)
+{
+    unsigned rank_id;
+    unsigned bank_id;
+    Addr row;
+    decode(addr, rank_id, bank_id, row);
+
+    Rank &rank = ranks[rank_id];
+    Bank &bank = rank.banks[bank_id];
+
+    Tick start = arrival;
+    refresh(rank, start);
+
+    // the first command of the access, a column access, an activation
+    // or a precharge, waits for the bank
+    AccessKind kind;
+    if (bank.rowOpen && bank.openRow == row) {
+        kind = RowHit;
+        start = std::max(start, bank.colAllowedAt);
+    } else if (bank.rowOpen) {
+        kind = RowConflict;
+        start = std::max(start, bank.preAllowedAt);
+    } else {
+        kind = RowMiss;
+        start = std::max(start, bank.actAllowedAt);
+    }
+
+    // waiting for the bank may have taken us into a refresh
+    if (refresh(rank, start)) {
+        kind = RowMiss;
+        start = std::max(start, bank.actAllowedAt);
+    }
+
+    const int dir = is_read ? 0 : 1;
+    const Tick latency = accessLatency[dir][kind];
+
+    // the data burst then waits for the bus
+    Tick bus_free = busBusyUntil;
+    if (is_read != lastWasRead)
+        bus_free += is_read ? tWTR : tRTW;
+    else if (rank_id != lastRank)
+        bus_free += tCS;
+
+    const Tick ready = start + latency - tBURST;
+    const Tick burst_start = std::max(ready, bus_free);
+    const Tick burst_end = burst_start + tBURST;
+
+    busBusyUntil = burst_end;
+    lastWasRead = is_read;
+    lastRank = rank_id;
+
+    // update the bank with respect to the column command of the burst
+    const Tick col = std::max(start, burst_start - (is_read ? tCL : tCWL));
+    if (kind != RowHit) {
+        const Tick act = kind == RowConflict ? start + tRP : start;
+        bank.preAllowedAt = act + tRAS;
+    }
+    bank.preAllowedAt = std::max(bank.preAllowedAt,
+                                 is_read ? col + tRTP : burst_end + tWR);
+    bank.colAllowedAt = col + tBURST;
+    bank.openRow = row;
+
+    // with a closed page policy, precharge as soon as possible
+    bank.rowOpen = pageMgmt == enums::open ||
+        pageMgmt == enums::open_adaptive;
+    bank.actAllowedAt = bank.rowOpen ? 0 : bank.preAllowedAt + tRP;
+
+    DPRINTF(FastDRAM, "%s %#x rank %d bank %d row %d: kind %d, start %d, "
+            "burst %d\n", is_read ? "Read" : "Write", addr, rank_id,
+            bank_id, row, kind, start, burst_start);
+
+    if (is_read) {
+        stats.readAccesses[kind]++;
+        stats.readAccessLat[kind] += latency;
+        stats.totQLat += start - arrival;
+        stats.totBusLat += burst_start - ready;
+        stats.totMemAccLat += burst_end - arrival;
+    } else {
+        stats.writeAccesses[kind]++;
+    }
+    stats.busBusyTicks += tBURST;
+
+    return burst_end;
+}
+
+void
+FastDRAM::pruneQueued()
+{
+    while (!queued.empty() && queued.front().first <= curTick()) {
+        if (queued.front().second)
+            --readsQueued;
+        else
+            --writesQueued;
+        queued.pop_front();
+    }
+}
+
+bool
+FastDRAM::recvTimingReq(PacketPtr pkt)
+{
+    panic_if(pkt->cacheResponding(), "Should not see packets where cache "
+             "is responding");
+
+    panic_if(!(pkt->isRead() || pkt->isWrite()),
+             "Should only see read and writes at memory controller, "
+             "saw %s to %#llx\n", pkt->cmdString(), pkt->getAddr());
+
+    // we should not get a new request after committing to retry the
+    // current one, but unfortunately the CPU violates this rule, so
+    // simply ignore it for now
+    if (retryReq)
+        return false;
+
+    const bool is_read = pkt->isRead();
+    const Addr first = pkt->getAddr() / burstSize;
+    const Addr last = (pkt->getAddr() + pkt->getSize() - 1) / burstSize;
+    const unsigned bursts = last - first + 1;
+
+    // like the controller, refuse the request if its queue is full,
+    // and retry once the burst at the head of the queues is done
+    pruneQueued();
+    const bool full = is_read ?
+        readsQueued + bursts > readBufferSize :
+        writesQueued + bursts > writeBufferSize;
+    if (full && !queued.empty()) {
+        retryReq = true;
+        ++stats.numRetries;
+        if (!releaseEvent.scheduled())
+            schedule(releaseEvent, queued.front().first);
+        return false;
+    }
+
+    if (is_read)
+        ++stats.readReqs;
+    else
+        ++stats.writeReqs;
+
+    Tick burst_end = curTick();
+    for (Addr burst = first; burst <= last; ++burst) {
+        burst_end = reserve(burst * burstSize, is_read, curTick());
+        queued.emplace_back(burst_end, is_read);
+        if (is_read)
+            ++readsQueued;
+        else
+            ++writesQueued;
+    }
+
+    // the header and payload delays are charged on the response, as
+    // done by the controller
+    const Tick receive_delay = pkt->headerDelay + pkt->payloadDelay;
+    pkt->headerDelay = pkt->payloadDelay = 0;
+
+    bool needs_response = pkt->needsResponse();
+    access(pkt);
+    if (needs_response) {
+        assert(pkt->isResponse());
+        // reads are answered once the data is out, and writes once
+        // they are queued
+        const Tick when = is_read ?
+            burst_end + frontendLatency + backendLatency :
+            curTick() + frontendLatency;
+        port.schedTimingResp(pkt, when + receive_delay);
+    } else {
+        pendingDelete.reset(pkt);
+    }
+
+    return true;
+}
+
+void
+FastDRAM::release()
+{
+    assert(retryReq);
+    retryReq = false;
+    port.sendRetryReq();
+}
+
+Port &
+FastDRAM::getPort(const std::string &if_name, PortID idx)
+{
+    if (if_name != "port") {
+        return AbstractMemory::getPort(if_name, idx);
+    } else {
+        return port;
+    }
+}
+
+FastDRAM::FastDRAMStats::FastDRAMStats(FastDRAM &mem)
+    : statistics::Group(&mem),
+      ADD_STAT(readReqs, statistics::units::Count::get(),
+               "Number of read requests accepted"),
+      ADD_STAT(writeReqs, statistics::units::Count::get(),
+               "Number of write requests accepted"),
+      ADD_STAT(readAccesses, statistics::units::Count::get(),
+               "Number of read bursts per kind of access"),
+      ADD_STAT(writeAccesses, statistics::units::Count::get(),
+               "Number of write bursts per kind of access"),
+      ADD_STAT(readAccessLat, statistics::units::Tick::get(),
+               "Total latency from the table of the read bursts per kind "
+               "of access"),
+      ADD_STAT(totQLat, statistics::units::Tick::get(),
+               "Total ticks spent waiting for the banks by the read "
+               "bursts"),
+      ADD_STAT(totBusLat, statistics::units::Tick::get(),
+               "Total ticks spent waiting for the data bus by the read "
+               "bursts"),
+      ADD_STAT(totMemAccLat, statistics::units::Tick::get(),
+               "Total ticks from the arrival to the end of the read "
+               "bursts"),
+      ADD_STAT(busBusyTicks, statistics::units::Tick::get(),
+               "Total ticks the data bus is busy"),
+      ADD_STAT(refreshStalls, statistics::units::Count::get(),
+               "Number of commands stalled by a refresh"),
+      ADD_STAT(numRetries, statistics::units::Count::get(),
+               "Number of requests refused as a queue was full"),
+      ADD_STAT(avgQLat, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average bank queueing delay per read burst"),
+      ADD_STAT(avgBusLat, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average data bus queueing delay per read burst"),
+      ADD_STAT(avgMemAccLat, statistics::units::Rate<
+                    statistics::units::Tick, statistics::units::Count>::get(),
+               "Average memory access latency per read burst"),
+      ADD_STAT(busUtil, statistics::units::Ratio::get(),
+               "Data bus utilization in percentage")
+{
+}
+
+void
+FastDRAM::FastDRAMStats::regStats()
+{
+    using namespace statistics;
+
+    statistics::Group::regStats();
+
+    const char *kinds[NumAccessKinds] = {"rowHit", "rowMiss", "rowConflict"};
+    for (auto *vector : {&readAccesses, &writeAccesses, &readAccessLat}) {
+        vector->init(NumAccessKinds);
+        for (int kind = 0; kind < NumAccessKinds; ++kind)
+            vector->subname(kind, kinds[kind]);
+    }
+
+    avgQLat.precision(2);
+    avgBusLat.precision(2);
+    avgMemAccLat.precision(2);
+    busUtil.precision(2);
+
+    avgQLat = totQLat / sum(readAccesses);
+    avgBusLat = totBusLat / sum(readAccesses);
+    avgMemAccLat = totMemAccLat / sum(readAccesses);
+    busUtil = 100 * busBusyTicks / simTicks;
+}
+
+FastDRAM::MemoryPort::MemoryPort(const std::string& _name,
+                                 FastDRAM& _memory)
+    : QueuedResponsePort(_name, &_memory, queue),
+      queue(_memory, *this, true), mem(_memory)
+{ }
+
+AddrRangeList
+FastDRAM::MemoryPort::getAddrRanges() const
+{
+    AddrRangeList ranges;
+    ranges.push_back(mem.getAddrRange());
+    return ranges;
+}
+
+Tick
+FastDRAM::MemoryPort::recvAtomic(PacketPtr pkt)
+{
+    return mem.recvAtomic(pkt);
+}
+
+Tick
+FastDRAM::MemoryPort::recvAtomicBackdoor(
+        PacketPtr pkt, MemBackdoorPtr &_backdoor)
+{
+    return mem.recvAtomicBackdoor(pkt, _backdoor);
+}
+
+void
+FastDRAM::MemoryPort::recvFunctional(PacketPtr pkt)
+{
+    mem.recvFunctional(pkt);
+}
+
+bool
+FastDRAM::MemoryPort::recvTimingReq(PacketPtr pkt)
+{
+    return mem.recvTimingReq(pkt);
+}
+
+} // namespace memory
+} // namespace gem5
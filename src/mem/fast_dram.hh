@@ -0,0 +1,278 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * FastDRAM declaration
+ */
+
+#ifndef __MEM_FAST_DRAM_HH__
+#define __MEM_FAST_DRAM_HH__
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "base/statistics.hh"
+#include "enums/AddrMap.hh"
+#include "enums/PageManage.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/qport.hh"
+#include "params/FastDRAM.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * The fast DRAM is an analytical model of a DRAM channel and its
+ * controller, for design-space sweeps where the detailed MemCtrl and
+ * DRAMInterface are too slow and the SimpleMemory too inaccurate.
+ *
+ * It tracks the open row and the availability of every bank, and
+ * looks the access latency up in a table computed from the DRAM
+ * timings, for row hits, accesses to a closed bank, and row
+ * conflicts. The data bus is reserved for a burst per access, with
+ * the bus turnaround and rank switching penalties, which queues the
+ * accesses when the bandwidth is exhausted, and the banks are
+ * unavailable during the refresh at the end of every refresh
+ * interval. The requests are served in order, and the timing of an
+ * access is settled when it arrives, so there is a single event per
+ * response.
+ *
+ * The latencies of the table can be scaled per kind of access to
+ * match the detailed controller, see configs/dram/fast_dram_calibrate.py.
+ *
+ * @sa  \ref gem5MemorySystem "gem5 Memory System"
+ */
+class FastDRAM : public AbstractMemory
+{
+
+  private:
+
+    class MemoryPort : public QueuedResponsePort
+    {
+      private:
+        RespPacketQueue queue;
+        FastDRAM& mem;
+
+      public:
+        MemoryPort(const std::string& _name, FastDRAM& _memory);
+
+      protected:
+        Tick recvAtomic(PacketPtr pkt) override;
+        Tick recvAtomicBackdoor(
+                PacketPtr pkt, MemBackdoorPtr &_backdoor) override;
+        void recvFunctional(PacketPtr pkt) override;
+        bool recvTimingReq(PacketPtr pkt) override;
+        AddrRangeList getAddrRanges() const override;
+    };
+
+    MemoryPort port;
+
+    /** The kinds of access, indexing the latency table. */
+    enum AccessKind
+    {
+        RowHit,
+        RowMiss,
+        RowConflict,
+        NumAccessKinds
+    };
+
+    /** State of a bank. */
+    struct Bank
+    {
+        /** The open row, if any */
+        Addr openRow = 0;
+        bool rowOpen = false;
+
+        /** Earliest tick for the next column command */
+        Tick colAllowedAt = 0;
+
+        /** Earliest tick for the next precharge */
+        Tick preAllowedAt = 0;
+
+        /** Earliest tick for the next activation */
+        Tick actAllowedAt = 0;
+    };
+
+    /** State of a rank. */
+    struct Rank
+    {
+        std::vector<Bank> banks;
+
+        /** The refresh interval the rank was last accessed in */
+        Tick refreshInterval = 0;
+    };
+
+    /** Organisation of the channel */
+    const enums::AddrMap addrMapping;
+    const enums::PageManage pageMgmt;
+    const unsigned burstSize;
+    const unsigned burstsPerRowBuffer;
+    const unsigned burstsPerStripe;
+    const unsigned ranksPerChannel;
+    const unsigned banksPerRank;
+
+    /** XOR hashing of the bank and rank, as in MemInterface */
+    const std::vector<Addr> bankXorMasks;
+    const std::vector<Addr> rankXorMasks;
+
+    /** The timings used in addition to the latency table */
+    const Tick tCL;
+    const Tick tCWL;
+    const Tick tRAS;
+    const Tick tWR;
+    const Tick tRTP;
+    const Tick tRP;
+    const Tick tBURST;
+    const Tick tRFC;
+    const Tick tREFI;
+    const Tick tWTR;
+    const Tick tRTW;
+    const Tick tCS;
+    const Tick frontendLatency;
+    const Tick backendLatency;
+
+    /** Capacity of the read and write queues of the controller */
+    const unsigned readBufferSize;
+    const unsigned writeBufferSize;
+
+    /**
+     * Latency from the activation, if any, to the end of the data
+     * burst of an access, per direction (read first) and kind of
+     * access, scaled by the calibration factors.
+     */
+    Tick accessLatency[2][NumAccessKinds];
+
+    std::vector<Rank> ranks;
+
+    /** When the data bus is available again */
+    Tick busBusyUntil;
+
+    /** Direction and rank of the last burst, for the turnarounds */
+    bool lastWasRead;
+    unsigned lastRank;
+
+    /**
+     * End of the data burst of the accesses still in the controller
+     * queues, and whether they are reads. The bus is reserved in
+     * order, so the ticks are sorted.
+     */
+    std::deque<std::pair<Tick, bool>> queued;
+    unsigned readsQueued;
+    unsigned writesQueued;
+
+    /** Remember if we have to retry a request when there is room */
+    bool retryReq;
+
+    /** Send a retry once a queue entry was freed. */
+    void release();
+
+    EventFunctionWrapper releaseEvent;
+
+    /** Forget the accesses done by now. */
+    void pruneQueued();
+
+    /**
+     * Decode the rank, bank and row of an address, following the
+     * address mapping of the DRAMInterface.
+     */
+    void decode(Addr addr, unsigned &rank, unsigned &bank,
+                Addr &row) const;
+
+    /**
+     * Stall a command that falls in the refresh of its rank until
+     * the end of the refresh, and close the rows of the rank if it
+     * was refreshed since it was last accessed.
+     *
+     * @param rank The rank accessed
+     * @param when Tick of the command, updated if stalled
+     * @return True if the rows of the rank were closed
+     */
+    bool refresh(Rank &rank, Tick &when);
+
+    /**
+     * Settle the timing of a burst and update the state of the
+     * channel.
+     *
+     * @param addr Address of the burst
+     * @param is_read True for a read, false for a write
+     * @param arrival When the burst reaches the controller
+     * @return The end of the data burst
+     */
+    Tick reserve(Addr addr, bool is_read, Tick arrival);
+
+    /**
+     * Upstream caches need this packet until true is returned, so
+     * hold it for deletion until a subsequent call
+     */
+    std::unique_ptr<Packet> pendingDelete;
+
+    struct FastDRAMStats : public statistics::Group
+    {
+        FastDRAMStats(FastDRAM &mem);
+
+        void regStats() override;
+
+        statistics::Scalar readReqs;
+        statistics::Scalar writeReqs;
+        statistics::Vector readAccesses;
+        statistics::Vector writeAccesses;
+        statistics::Vector readAccessLat;
+        statistics::Scalar totQLat;
+        statistics::Scalar totBusLat;
+        statistics::Scalar totMemAccLat;
+        statistics::Scalar busBusyTicks;
+        statistics::Scalar refreshStalls;
+        statistics::Scalar numRetries;
+
+        statistics::Formula avgQLat;
+        statistics::Formula avgBusLat;
+        statistics::Formula avgMemAccLat;
+        statistics::Formula busUtil;
+    } stats;
+
+  public:
+
+    FastDRAM(const FastDRAMParams &p);
+
+    Port &getPort(const std::string &if_name,
+                  PortID idx=InvalidPortID) override;
+    void init() override;
+
+  protected:
+    Tick recvAtomic(PacketPtr pkt);
+    Tick recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor);
+    void recvFunctional(PacketPtr pkt);
+    bool recvTimingReq(PacketPtr pkt);
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif //__MEM_FAST_DRAM_HH__
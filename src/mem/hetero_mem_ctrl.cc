@@ -74,6 +74,10 @@ HeteroMemCtrl::HeteroMemCtrl(const HeteroMemCtrlParams &p) :
     dram->setCtrl(this, commandWindow);
     nvm->setCtrl(this, commandWindow);
 
+    fatal_if(nvm->eventQueue() != eventQueue(),
+             "%s: the memory interface must use the event queue of the "
+             "controller\n", name());
+
     readBufferSize = dram->readBufferSize + nvm->readBufferSize;
     writeBufferSize = dram->writeBufferSize + nvm->writeBufferSize;
 
@@ -418,7 +422,7 @@ HeteroMemCtrl::drain()
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
-          allIntfDrained())) {
+          allIntfDrained() && port.crossingDrained())) {
 
         DPRINTF(Drain, "Memory controller not drained, write: %d, read: %d,"
                 " resp: %d\n", totalWriteQueueSize, totalReadQueueSize,
@@ -87,6 +87,11 @@ MemCtrl::MemCtrl(const MemCtrlParams &p) :
 
     dram->setCtrl(this, commandWindow);
 
+    // the interface is driven by the events of the controller
+    fatal_if(dram->eventQueue() != eventQueue(),
+             "%s: the memory interface must use the event queue of the "
+             "controller\n", name());
+
     // perform a basic check of the write thresholds
     if (p.write_low_thresh_perc >= p.write_high_thresh_perc)
         fatal("Write buffer low threshold %d must be smaller than the "
@@ -524,7 +529,7 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
         // if there is nothing left in any queue, signal a drain
         if (drainState() == DrainState::Draining &&
             !totalWriteQueueSize && !totalReadQueueSize &&
-            allIntfDrained()) {
+            allIntfDrained() && port.crossingDrained()) {
 
             DPRINTF(Drain, "Controller done draining\n");
             signalDrainDone();
@@ -543,7 +548,7 @@ MemCtrl::processRespondEvent(MemInterface* mem_intr,
     // so if there is a read that was forced to wait, retry now
     if (retry_rd_req) {
         retry_rd_req = false;
-        port.sendRetryReq();
+        port.retryReq();
     }
 }
 
@@ -637,7 +642,7 @@ MemCtrl::accessAndRespond(PacketPtr pkt, Tick static_latency,
 
         // queue the packet in the response queue to be sent out after
         // the static latency has passed
-        port.schedTimingResp(pkt, response_time);
+        port.respond(pkt, response_time);
     } else {
         // @todo the packet is going to be deleted, and the MemPacket
         // is still having a pointer to it
@@ -937,7 +942,8 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
                 // ensuring all banks are closed and
                 // have exited low power states
                 if (drainState() == DrainState::Draining &&
-                    respQEmpty() && allIntfDrained()) {
+                    respQEmpty() && allIntfDrained() &&
+                    port.crossingDrained()) {
 
                     DPRINTF(Drain, "MemCtrl controller done draining\n");
                     signalDrainDone();
@@ -1125,7 +1131,7 @@ MemCtrl::processNextReqEvent(MemInterface* mem_intr,
 
     if (retry_wr_req && totalWriteQueueSize < writeBufferSize) {
         retry_wr_req = false;
-        port.sendRetryReq();
+        port.retryReq();
     }
 }
 
@@ -1392,13 +1398,25 @@ MemCtrl::allIntfDrained() const
    return dram->allRanksDrained();
 }
 
+void
+MemCtrl::checkDrainDone()
+{
+    if (drainState() == DrainState::Draining && !totalWriteQueueSize &&
+        !totalReadQueueSize && respQEmpty() && allIntfDrained() &&
+        port.crossingDrained()) {
+
+        DPRINTF(Drain, "Controller done draining\n");
+        signalDrainDone();
+    }
+}
+
 DrainState
 MemCtrl::drain()
 {
     // if there is anything in any of our internal queues, keep track
     // of that as well
     if (!(!totalWriteQueueSize && !totalReadQueueSize && respQueue.empty() &&
-          allIntfDrained())) {
+          allIntfDrained() && port.crossingDrained())) {
 
         DPRINTF(Drain, "Memory controller not drained, write: %d, read: %d,"
                 " resp: %d\n", totalWriteQueueSize, totalReadQueueSize,
@@ -1447,7 +1465,9 @@ MemCtrl::getAddrRanges()
 MemCtrl::MemoryPort::
 MemoryPort(const std::string& name, MemCtrl& _ctrl)
     : QueuedResponsePort(name, &_ctrl, queue), queue(_ctrl, *this, true),
-      ctrl(_ctrl)
+      ctrl(_ctrl), requestorEvents(_ctrl),
+      crossingQueue(requestorEvents, *this, true, "CrossingRespQueue"),
+      crossing(false), inTransit(0)
 { }
 
 AddrRangeList
@@ -1459,9 +1479,13 @@ MemCtrl::MemoryPort::getAddrRanges() const
 void
 MemCtrl::MemoryPort::recvFunctional(PacketPtr pkt)
 {
+    // the controller may run in another thread
+    EventQueue::ScopedMigration migrate(ctrl.eventQueue(), inParallelMode);
+
     pkt->pushLabel(ctrl.name());
 
-    if (!queue.trySatisfyFunctional(pkt)) {
+    if (!queue.trySatisfyFunctional(pkt) &&
+        !crossingQueue.trySatisfyFunctional(pkt)) {
         // Default implementation of SimpleTimingPort::recvFunctional()
         // calls recvAtomic() and throws away the latency; we can save a
         // little here by just not calculating the latency.
@@ -1474,6 +1498,7 @@ MemCtrl::MemoryPort::recvFunctional(PacketPtr pkt)
 Tick
 MemCtrl::MemoryPort::recvAtomic(PacketPtr pkt)
 {
+    EventQueue::ScopedMigration migrate(ctrl.eventQueue(), inParallelMode);
     return ctrl.recvAtomic(pkt);
 }
 
@@ -1481,15 +1506,115 @@ Tick
 MemCtrl::MemoryPort::recvAtomicBackdoor(
         PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
+    EventQueue::ScopedMigration migrate(ctrl.eventQueue(), inParallelMode);
     return ctrl.recvAtomicBackdoor(pkt, backdoor);
 }
 
 bool
 MemCtrl::MemoryPort::recvTimingReq(PacketPtr pkt)
 {
+    if (inParallelMode && curEventQueue() != ctrl.eventQueue())
+        return recvCrossingReq(pkt);
+
     // pass it to the memory controller
     return ctrl.recvTimingReq(pkt);
 }
 
+bool
+MemCtrl::MemoryPort::recvCrossingReq(PacketPtr pkt)
+{
+    // this is called in the thread of the requestor, the only state it
+    // may touch is set once before anything is handed over
+    if (!crossing) {
+        requestorEvents = EventManager(curEventQueue());
+        crossing = true;
+        warn_if(simQuantum > ctrl.frontendLatency,
+                "%s: the quantum (%d ticks) exceeds the frontend latency, "
+                "responses to another event queue will be delayed\n",
+                name(), simQuantum);
+    }
+    panic_if(requestorEvents.eventQueue() != curEventQueue(),
+             "%s: requests from several event queues are not supported\n",
+             name());
+
+    // The other queues may be up to a quantum ahead, so the request
+    // can only arrive a quantum later. It takes the header delay of
+    // the packet into account, which leaves the timing untouched as
+    // long as the crossbar latency covers the quantum.
+    const Tick delay = std::max<Tick>(simQuantum, pkt->headerDelay);
+    pkt->headerDelay = 0;
+
+    ++inTransit;
+    ctrl.schedule(new EventFunctionWrapper([this, pkt]
+        {
+            const bool last = --inTransit == 0;
+            crossingReqs.push_back(pkt);
+            if (crossingReqs.size() == 1)
+                sendCrossingReqs();
+            if (last)
+                ctrl.checkDrainDone();
+        }, name() + ".crossingReqEvent", true), curTick() + delay);
+
+    // the requestor never waits for a retry, the controller does
+    return true;
+}
+
+void
+MemCtrl::MemoryPort::sendCrossingReqs()
+{
+    // stop at the first refusal, the controller asks for a retry when
+    // it has room again
+    while (!crossingReqs.empty() && ctrl.recvTimingReq(crossingReqs.front()))
+        crossingReqs.pop_front();
+}
+
+void
+MemCtrl::MemoryPort::retryReq()
+{
+    if (crossingReqs.empty())
+        sendRetryReq();
+    else
+        sendCrossingReqs();
+}
+
+void
+MemCtrl::MemoryPort::respond(PacketPtr pkt, Tick when)
+{
+    if (!crossing || !inParallelMode) {
+        schedTimingResp(pkt, when);
+        return;
+    }
+
+    // the response is queued in the event queue of the requestor, at
+    // least a quantum from now
+    ++inTransit;
+    requestorEvents.schedule(new EventFunctionWrapper([this, pkt]
+        {
+            crossingQueue.schedSendTiming(pkt, curTick());
+
+            // The drain state of the controller only changes between
+            // simulation runs or in its own queue. If it is draining,
+            // check whether it is done from its own queue, which is at
+            // most a quantum ahead of this one.
+            if (--inTransit == 0 &&
+                ctrl.drainState() == DrainState::Draining) {
+                ctrl.schedule(new EventFunctionWrapper(
+                    [this]{ ctrl.checkDrainDone(); },
+                    name() + ".crossingDrainEvent", true),
+                    curTick() + simQuantum);
+            }
+        }, name() + ".crossingRespEvent", true),
+        std::max(when, curTick() + simQuantum));
+}
+
+void
+MemCtrl::MemoryPort::recvRespRetry()
+{
+    if (crossing && inParallelMode)
+        crossingQueue.retry();
+    else
+        queue.retry();
+}
+
 } // namespace memory
 } // namespace gem5
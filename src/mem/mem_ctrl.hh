@@ -46,6 +46,7 @@
 #ifndef __MEM_CTRL_HH__
 #define __MEM_CTRL_HH__
 
+#include <atomic>
 #include <deque>
 #include <string>
 #include <unordered_set>
@@ -249,16 +250,66 @@ class MemCtrl : public qos::MemCtrl
 
     // For now, make use of a queued response port to avoid dealing with
     // flow control for the responses being sent back
+    //
+    // The controller and its interfaces may be placed in an event queue
+    // of their own, so that the channels of a multi-channel memory are
+    // simulated in parallel. The requests from a requestor in another
+    // event queue, typically the crossbar in front of the channels, are
+    // then handed over through events at least a quantum in the future,
+    // and the responses are sent back by a packet queue serviced in the
+    // event queue of the requestor. The flow control is local to each
+    // side of this boundary.
     class MemoryPort : public QueuedResponsePort
     {
 
         RespPacketQueue queue;
         MemCtrl& ctrl;
 
+        /** Event queue of the requestor when it is not the one of the
+         * controller, responses are scheduled there */
+        EventManager requestorEvents;
+
+        /** Responses to a requestor in another event queue */
+        RespPacketQueue crossingQueue;
+
+        /** Set once a request came from another event queue */
+        bool crossing;
+
+        /** Requests from another event queue, waiting for the
+         * controller to accept them */
+        std::deque<PacketPtr> crossingReqs;
+
+        /** Requests and responses handed over between the event
+         * queues, but not arrived yet */
+        std::atomic<unsigned> inTransit;
+
       public:
 
         MemoryPort(const std::string& name, MemCtrl& _ctrl);
 
+        /**
+         * Send a timing response, through the event queue of the
+         * requestor if needed.
+         *
+         * @param pkt Response to send
+         * @param when Tick at which to send the response
+         */
+        void respond(PacketPtr pkt, Tick when);
+
+        /**
+         * Let a request refused by the controller try again. Requests
+         * handed over from another event queue are retried locally.
+         */
+        void retryReq();
+
+        /** Check that no packet is in transit between event queues,
+         * or waiting for the controller to accept it. */
+        bool
+        crossingDrained() const
+        {
+            return inTransit == 0 && crossingReqs.empty();
+        }
+
       protected:
 
         Tick recvAtomic(PacketPtr pkt) override;
@@ -269,8 +320,21 @@ class MemCtrl : public qos::MemCtrl
 
         bool recvTimingReq(PacketPtr) override;
 
+        void recvRespRetry() override;
+
         AddrRangeList getAddrRanges() const override;
 
+      private:
+
+        /**
+         * Hand over a request from the event queue of the requestor
+         * to the one of the controller.
+         */
+        bool recvCrossingReq(PacketPtr pkt);
+
+        /** Pass the requests handed over to the controller. */
+        void sendCrossingReqs();
+
     };
 
     /**
@@ -683,6 +747,13 @@ class MemCtrl : public qos::MemCtrl
      */
     virtual bool allIntfDrained() const;
 
+    /**
+     * Signal the end of a drain if nothing is left in the queues of the
+     * controller, or in transit to or from it. Used when the last
+     * packet in transit between event queues arrives.
+     */
+    void checkDrainDone();
+
     DrainState drain() override;
 
     /**
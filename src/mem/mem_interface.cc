@@ -40,8 +40,11 @@
 
 #include "mem/mem_interface.hh"
 
+#include <algorithm>
+
 #include "base/bitfield.hh"
 #include "base/cprintf.hh"
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "sim/system.hh"
 
@@ -51,6 +54,49 @@ namespace gem5
 namespace memory
 {
 
+void
+checkXorMasks(const std::string &name, enums::AddrMap mapping,
+              uint32_t burst_size, uint32_t bursts_per_row_buffer,
+              uint32_t bursts_per_stripe, uint32_t banks, uint32_t ranks,
+              const std::vector<Addr> &bank_masks,
+              const std::vector<Addr> &rank_masks)
+{
+    if (bank_masks.empty() && rank_masks.empty())
+        return;
+
+    // the hashed index has to stay within the banks (ranks), so only
+    // hash a power of two number of them, and not beyond their bits
+    fatal_if(!bank_masks.empty() && (!isPowerOf2(banks) ||
+             (1ULL << bank_masks.size()) > banks),
+             "%s: %d bank XOR masks do not fit %d banks\n", name,
+             bank_masks.size(), banks);
+    fatal_if(!rank_masks.empty() && (!isPowerOf2(ranks) ||
+             (1ULL << rank_masks.size()) > ranks),
+             "%s: %d rank XOR masks do not fit %d ranks\n", name,
+             rank_masks.size(), ranks);
+
+    // the bank bits are right above the column (or channel stripe)
+    // bits below them, and the rank bits right above the bank bits
+    const uint64_t below_bank = uint64_t(burst_size) *
+        (mapping == enums::RoCoRaBaCh ?
+         std::min(bursts_per_row_buffer, bursts_per_stripe) :
+         bursts_per_row_buffer);
+    fatal_if(!isPowerOf2(below_bank),
+             "%s: XOR masks need a power of two number of bytes below "
+             "the bank bits, not %d\n", name, below_bank);
+
+    const unsigned bank_shift = floorLog2(below_bank);
+    const unsigned index_bits = ceilLog2(banks) + ceilLog2(ranks);
+    const Addr mapped = mask(index_bits) << bank_shift;
+    for (const auto *masks : {&bank_masks, &rank_masks}) {
+        for (Addr m : *masks) {
+            fatal_if(m & mapped, "%s: XOR mask %#x overlaps the bank and "
+                     "rank bits %#x of the address mapping\n", name, m,
+                     mapped);
+        }
+    }
+}
+
 MemInterface::MemInterface(const MemInterfaceParams &_p)
     : AbstractMemory(_p),
       addrMapping(_p.addr_mapping),
@@ -65,13 +111,18 @@ MemInterface::MemInterface(const MemInterfaceParams &_p)
                       range.granularity() / burstSize : 1),
       ranksPerChannel(_p.ranks_per_channel),
       banksPerRank(_p.banks_per_rank), rowsPerBank(0),
+      bankXorMasks(_p.bank_xor_masks), rankXorMasks(_p.rank_xor_masks),
       tCK(_p.tCK), tCS(_p.tCS), tBURST(_p.tBURST),
       tRTW(_p.tRTW),
       tWTR(_p.tWTR),
       readBufferSize(_p.read_buffer_size),
       writeBufferSize(_p.write_buffer_size),
       numWritesQueued(0)
-{}
+{
+    checkXorMasks(name(), addrMapping, burstSize, burstsPerRowBuffer,
+                  burstsPerStripe, banksPerRank, ranksPerChannel,
+                  bankXorMasks, rankXorMasks);
+}
 
 void
 MemInterface::setCtrl(MemCtrl* _ctrl, unsigned int command_window,
@@ -52,6 +52,7 @@
 #include <utility>
 #include <vector>
 
+#include "base/bitfield.hh"
 #include "base/compiler.hh"
 #include "base/statistics.hh"
 #include "enums/AddrMap.hh"
@@ -67,6 +68,45 @@ namespace gem5
 namespace memory
 {
 
+/**
+ * Hash an index decoded from an address, flipping every bit of the
+ * index by the parity of the address bits in its mask.
+ *
+ * @param index The bank or rank index given by the address mapping
+ * @param addr The address within the memory
+ * @param masks One mask per bit of the index, least significant first
+ * @return The hashed index
+ */
+inline uint64_t
+xorHash(uint64_t index, Addr addr, const std::vector<Addr> &masks)
+{
+    for (size_t i = 0; i < masks.size(); i++)
+        index ^= uint64_t(popCount(addr & masks[i]) & 1) << i;
+    return index;
+}
+
+/**
+ * Check the XOR masks hashing the bank and rank indices of a memory,
+ * and fatal if a hashed index could go beyond the banks (ranks), or if
+ * a mask includes the bank or rank bits of the address mapping, as the
+ * hashed mapping would then no longer be a permutation.
+ *
+ * @param name Name of the memory, for the error messages
+ * @param mapping The address mapping
+ * @param burst_size Size of a burst in bytes
+ * @param bursts_per_row_buffer Number of bursts in a row buffer
+ * @param bursts_per_stripe Number of bursts in a channel stripe
+ * @param banks Number of banks per rank
+ * @param ranks Number of ranks per channel
+ * @param bank_masks One mask per bit of the bank index
+ * @param rank_masks One mask per bit of the rank index
+ */
+void checkXorMasks(const std::string &name, enums::AddrMap mapping,
+                   uint32_t burst_size, uint32_t bursts_per_row_buffer,
+                   uint32_t bursts_per_stripe, uint32_t banks,
+                   uint32_t ranks, const std::vector<Addr> &bank_masks,
+                   const std::vector<Addr> &rank_masks);
+
 /**
  * General interface to memory device
  * Includes functions and parameters shared across media types
@@ -141,6 +181,13 @@ class MemInterface : public AbstractMemory
     const uint32_t banksPerRank;
     uint32_t rowsPerBank;
 
+    /**
+     * XOR hashing of the bank and rank indices, one address mask per
+     * bit of the index
+     */
+    const std::vector<Addr> bankXorMasks;
+    const std::vector<Addr> rankXorMasks;
+
     /**
      * General timing requirements
      */
@@ -129,8 +129,10 @@ NoncoherentXBar::recvTimingReq(PacketPtr pkt, PortID cpu_side_port_id)
     // store the old header delay so we can restore it if needed
     Tick old_header_delay = pkt->headerDelay;
 
-    // a request sees the frontend and forward latency
-    Tick xbar_delay = (frontendLatency + forwardLatency) * clockPeriod();
+    // a request sees the frontend and forward latency, and waits for
+    // the layer if forwarded in a burst
+    Tick xbar_delay = (frontendLatency + forwardLatency) * clockPeriod() +
+        reqLayers[mem_side_port_id]->burstDelay();
 
     // set the packet header and payload delay
     calcPacketTiming(pkt, xbar_delay);
@@ -205,8 +207,10 @@ NoncoherentXBar::recvTimingResp(PacketPtr pkt, PortID mem_side_port_id)
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
     unsigned int pkt_cmd = pkt->cmdToIndex();
 
-    // a response sees the response latency
-    Tick xbar_delay = responseLatency * clockPeriod();
+    // a response sees the response latency, and waits for the layer
+    // if forwarded in a burst
+    Tick xbar_delay = responseLatency * clockPeriod() +
+        respLayers[cpu_side_port_id]->burstDelay();
 
     // set the packet header and payload delay
     calcPacketTiming(pkt, xbar_delay);
@@ -132,7 +132,8 @@ NVMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
     uint64_t row;
 
     // Get packed address, starting at 0
-    Addr addr = getCtrlAddr(pkt_addr);
+    const Addr ctrl_addr = getCtrlAddr(pkt_addr);
+    Addr addr = ctrl_addr;
 
     // truncate the address to a memory burst, which makes it unique to
     // a specific buffer, row, bank, rank and channel
@@ -187,6 +188,11 @@ NVMInterface::decodePacket(const PacketPtr pkt, Addr pkt_addr,
     } else
         panic("Unknown address mapping policy chosen!");
 
+    // optionally hash the bank and rank, to spread the accesses that
+    // would otherwise conflict in the same bank
+    bank = xorHash(bank, ctrl_addr, bankXorMasks);
+    rank = xorHash(rank, ctrl_addr, rankXorMasks);
+
     assert(rank < ranksPerChannel);
     assert(bank < banksPerRank);
     assert(row < rowsPerBank);
@@ -51,5 +51,11 @@ class MemTraceProbe(BaseMemProbe):
     # packet trace output file, disabled by default
     trace_file = Param.String("", "Packet trace output file")
 
+    # Compress and write the trace from a separate thread
+    trace_buffer_size = Param.MemorySize('0', "Size of the buffer the "
+                                         "trace is written to a separate "
+                                         "thread through (0 writes from "
+                                         "the simulation thread)")
+
     # System object to look up the name associated with a requestor ID
     system = Param.System(Parent.any, "System the probe belongs to")
@@ -53,6 +53,12 @@ class StackDistProbe(BaseMemProbe):
     # enable verification stack
     verify = Param.Bool(False, "Verify behaviuor with reference implementation")
 
+    # SHARDS style spatial sampling, for very long runs
+    sampling_rate = Param.Float(1.0, "Fraction of the cache lines to track "
+                                "when estimating stack distances (1 tracks "
+                                "every line, histograms count the sampled "
+                                "requests only)")
+
     # linear histogram bins and enable/disable
     linear_hist_bins = Param.Unsigned('16', "Bins in linear histograms")
     disable_linear_hists = Param.Bool(False, "Disable linear histograms")
@@ -52,6 +52,7 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
     : BaseMemProbe(p),
       traceStream(nullptr),
       system(p.system),
+      stats(this),
       withPC(p.with_pc)
 {
     std::string filename;
@@ -74,7 +75,7 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
                                   (p.trace_compress ? ".gz" : ""));
     }
 
-    traceStream = new ProtoOutputStream(filename);
+    traceStream = new ProtoOutputStream(filename, p.trace_buffer_size);
 
     // Register a callback to compensate for the destructor not
     // being called. The callback forces the stream to flush and
@@ -82,6 +83,15 @@ MemTraceProbe::MemTraceProbe(const MemTraceProbeParams &p)
     registerExitCallback([this]() { closeStreams(); });
 }
 
+MemTraceProbe::MemTraceProbeStats::MemTraceProbeStats(MemTraceProbe *parent)
+    : statistics::Group(parent),
+      ADD_STAT(packets, statistics::units::Count::get(),
+               "Number of packets written to the trace"),
+      ADD_STAT(bufferStalls, statistics::units::Count::get(),
+               "Number of packets which waited for the trace writer thread")
+{
+}
+
 void
 MemTraceProbe::startup()
 {
@@ -105,6 +115,7 @@ MemTraceProbe::closeStreams()
 {
     if (traceStream != NULL)
         delete traceStream;
+    traceStream = nullptr;
 }
 
 void
@@ -121,7 +132,9 @@ MemTraceProbe::handleRequest(const probing::PacketInfo &pkt_info)
         pkt_msg.set_pc(pkt_info.pc);
     pkt_msg.set_pkt_id(pkt_info.id);
 
-    traceStream->write(pkt_msg);
+    stats.packets++;
+    if (traceStream->write(pkt_msg))
+        stats.bufferStalls++;
 }
 
 } // namespace gem5
@@ -41,6 +41,7 @@
 #include "mem/packet.hh"
 #include "mem/probes/base.hh"
 #include "proto/protoio.hh"
+#include "sim/stats.hh"
 
 namespace gem5
 {
@@ -71,6 +72,17 @@ class MemTraceProbe : public BaseMemProbe
 
     System *system;
 
+    struct MemTraceProbeStats : public statistics::Group
+    {
+        MemTraceProbeStats(MemTraceProbe *parent);
+
+        /** Number of packets written to the trace */
+        statistics::Scalar packets;
+
+        /** Number of packets which waited for space in the buffer */
+        statistics::Scalar bufferStalls;
+    } stats;
+
   private:
 
     /** Include the Program Counter in the memory trace */
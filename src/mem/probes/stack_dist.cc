@@ -43,12 +43,26 @@
 namespace gem5
 {
 
+namespace
+{
+
+/** Check the sampling rate before the calculator is built with it. */
+double
+checkSamplingRate(double sampling_rate)
+{
+    fatal_if(sampling_rate <= 0 || sampling_rate > 1,
+             "The stack distance probe sampling rate must be in (0, 1].");
+    return sampling_rate;
+}
+
+} // anonymous namespace
+
 StackDistProbe::StackDistProbe(const StackDistProbeParams &p)
     : BaseMemProbe(p),
       lineSize(p.line_size),
       disableLinearHists(p.disable_linear_hists),
       disableLogHists(p.disable_log_hists),
-      calc(p.verify),
+      calc(p.verify, checkSamplingRate(p.sampling_rate)),
       stats(this)
 {
     fatal_if(p.system->cacheLineSize() > p.line_size,
@@ -106,6 +120,10 @@ StackDistProbe::handleRequest(const probing::PacketInfo &pkt_info)
     // Align the address to a cache line size
     const Addr aligned_addr(roundDown(pkt_info.addr, lineSize));
 
+    // Only the sampled lines are tracked
+    if (!calc.isSampled(aligned_addr))
+        return;
+
     // Calculate the stack distance
     const uint64_t sd(calc.calcStackDistAndUpdate(aligned_addr).first);
     if (sd == StackDistCalc::Infinity) {
@@ -38,8 +38,10 @@
 #ifndef __MEM_STACK_DIST_CALC_HH__
 #define __MEM_STACK_DIST_CALC_HH__
 
+#include <cstdint>
 #include <limits>
-#include <map>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "base/types.hh"
@@ -50,29 +52,33 @@ namespace gem5
 /**
   * The stack distance calculator is a passive object that merely
   * observes the addresses pass to it. It calculates stack distances
-  * of incoming addresses based on the partial sum hierarchy tree
-  * algorithm described by Alamasi et al.
-  * http://doi.acm.org/10.1145/773039.773043.
+  * of incoming addresses, i.e. the number of unique addresses
+  * accessed since the last access to the same address.
   *
-  * A tree structure is maintained and updated at each transaction
-  * (unique or non-unique). The tree is implemented as an STL vector
-  * with layers of the form <map> Each layer in this tree is an
-  * ordered map <uint64_t, Node*>. Nodes are structs which take form
-  * of leaf, intermediate and root nodes. For example, in a tree with 3
-  * layers, tree[0][5] gives a leaf node pointer for key=5 tree[1][1]
-  * gives an intermediate node pointer for key=1 tree[2][0] gives the
-  * root node in the tree.
+  * Every access is given a slot, and slots are handed out in
+  * increasing order, so the most recently used address is the one
+  * with the highest slot. Only the latest slot of each address is
+  * live. A Fenwick tree (binary indexed tree) over the slots counts
+  * the live ones, which makes the stack distance of an address the
+  * number of live slots above its own, found in O(log n) time.
   *
   * At every transaction a hash-map (aiMap) is looked up to check if
   * the address was already encountered before. Based on this lookup a
   * transaction can be termed as unique or non-unique.
   *
+  * When the slots run out they are compacted: the live ones are
+  * renumbered from zero, in the same order, and the tree is rebuilt
+  * in linear time. The number of slots is kept at about twice the
+  * number of addresses tracked, so memory is bounded by the working
+  * set rather than by the number of accesses, and the cost of a
+  * compaction is amortised over the accesses that filled the slots.
+  *
   * In addition to the normal stack distance calculation, a feature to
-  * mark an old node in the tree is added. This is useful if it is
+  * mark an old address in the stack is added. This is useful if it is
   * required to see the reuse pattern. For example, BackInvalidates
   * from a lower level (e.g. membus to L2), can be marked (isMarked
-  * flag of Node set to True). Then later if this same address is
-  * accessed (by L1), the value of the isMarked flag would be
+  * flag of the address set to True). Then later if this same address
+  * is accessed (by L1), the value of the isMarked flag would be
   * True. This would give some insight on how the BackInvalidates
   * policy of the lower level affect the read/write accesses in an
   * application.
@@ -80,40 +86,25 @@ namespace gem5
   * There are two functions provided to interface with the calculator:
   * 1. pair<uint64_t, bool> calcStackDistAndUpdate(Addr r_address,
   *                                                bool addNewNode)
-  * At every unique transaction a new leaf node is added at tree[0](leaf layer)
-  * and linked to the layer above (if addNewNode is True). The sums of all
-  * the intermediate nodes is updated till the root. The stack-distance is
-  * returned as a Constant representing INFINITY.
+  * At every unique transaction the address is pushed on the stack (if
+  * addNewNode is True) and the stack-distance is returned as a
+  * Constant representing INFINITY.
   *
-  * At every non-unique transaction the tree is traversed from the
-  * leaf at the returned index to the root, the old node is deleted
-  * from the tree, and the sums (to the right are collected) and
-  * decremented. The collected sum represets the stack distance of the
-  * found node. If this node was marked then a bool flag set to True
-  * is returned with the stack_distance. During this operation a node
-  * is discarded at the leaf layer always. Moreover during the
-  * traversal upwards using the updateSum() method, if an intermediate
-  * node is found with no children connected to it, then that is
-  * discarded too.
+  * At every non-unique transaction the address is removed from the
+  * stack, and the number of addresses above it is returned as the
+  * stack distance, along with the value of its mark flag. If
+  * addNewNode is True the address is then pushed on the top of the
+  * stack again, unmarked.
   *
   * The return value of this function is a pair representing the
   * stack_distance and the value of the marked flag.
   *
   * 2. pair<uint64_t , bool> calcStackDist(Addr r_address, bool mark)
   * This is a stripped down version of the above function which is used to
-  * just inspect the tree, and mark a leaf node (if mark flag is set). The
-  * functionality to add a new node is removed.
-  *
-  * At every unique transaction the stack-distance is returned as a constant
-  * representing INFINITY.
-  *
-  * At every non-unique transaction the tree is traversed from the
-  * leaf at the returned index to the root, and the sums (to the right)
-  * are collected. The collected sum represets the stack distance of
-  * the found node.
+  * just inspect the stack, and mark an address (if mark flag is set).
   *
-  * This function does NOT Modify the stack. (No node is added or
-  * deleted).  It is just used to mark a node already created and get
+  * This function does NOT Modify the stack. (No address is added or
+  * removed).  It is just used to mark an address already seen and get
   * its stack distance.
   *
   * The return value of this function is a pair representing the stack
@@ -139,7 +130,7 @@ namespace gem5
   *  *I: stack-distance = infinity,
   *  *SD: Stack Distance
   *  *r_address: address to be added, *prevMark: value of isMarked flag
-  *                                                              of the Node)
+  *                                                           of the address)
   *
   * Invalidates refer to a type of packet that removes something from
   * a cache, either autonoumously (due-to cache's own replacement
@@ -151,14 +142,14 @@ namespace gem5
   * Delete Old Entry |calcStackDistAndUpdate|Writebacks/Cleanevicts|
   * Dist.of Old entry|calcStackDist         |Cleanevicts/Invalidate|
   *
-  * Node Balancing: The tree structure is maintained by an
-  * updateTree() operation called when an intermediate node is
-  * required. The update operation is roughly categorized as a root
-  * update or intermediate layer update. When number of leaf nodes
-  * grow over a power of 2 then a new layer is added at the top of the
-  * tree and a new root node is initialized. The old node at the lower
-  * layer is connected to this.  In an intermediate node update
-  * operation a new intermediate node is added to the required layer.
+  * Sampling: For very long runs the calculator can instead estimate
+  * the stack distances from a spatially hashed sample of the
+  * addresses, as in SHARDS (Waldspurger et al., FAST'15). An address
+  * is sampled if the hash of the address falls below a threshold set
+  * by the sampling rate R. Only the sampled addresses should be passed
+  * to the calculator (see isSampled()), which then tracks about R
+  * times fewer addresses, and returns their stack distances scaled by
+  * 1/R.
   *
   * Debugging: Debugging can be enabled by setting the verifyStack flag
   * true. Debugging is implemented using a dummy stack that behaves in
@@ -176,92 +167,77 @@ class StackDistCalc
 
   private:
 
-    struct Node;
+    /**
+     * State kept for every address in the stack
+     */
+    struct Entry
+    {
+        // Slot of the latest access to the address
+        uint64_t slot = 0;
 
-    typedef std::map<uint64_t, Node*> IndexNodeMap;
-    typedef std::map<Addr, uint64_t> AddressIndexMap;
-    typedef std::vector<IndexNodeMap> TreeType;
+        /**
+         * Flag to indicate if this address is marked. Used in case
+         * where stack distance of a touched address is required.
+         */
+        bool isMarked = false;
+    };
+
+    typedef std::unordered_map<Addr, Entry> AddressEntryMap;
 
     /**
-     * Gets sum from the node upwards recursively till the root.  This
-     * function is called first by getSumsLeavesToRoot, and then
-     * recursively calls itself.
-     *
-     * @param node pointer to the node which is updated
-     * @param from_left variable which says that the request arrived
-     *        from the left
-     * @param sum_from_below Sum of left and right children below
-     * @param level level in the tree the calling node is located
-     * @param stack_dist stack distance of the node below
-     * @return The stack distance of the current address.
-     *
+     * Count the live slots up to and including the given one.
+     * @param slot the last slot to count
+     * @return Number of live slots in [0, slot]
      */
-    uint64_t getSum(Node* node, bool from_left, uint64_t sum_from_below,
-                    uint64_t stack_dist, uint64_t level) const;
+    uint64_t countLive(uint64_t slot) const;
 
     /**
-     * Gets the sum from the leaf node specified. This function
-     * is called by calcStackDist.
-     *
-     * @param node pointer to the node which is updated
-     * @return The stack distance of the current address.
-     *
+     * Add to the count of live slots of the given slot in the tree.
+     * @param slot the slot to update
+     * @param delta 1 if the slot becomes live, -1 if it is released
      */
-    uint64_t getSumsLeavesToRoot(Node* node) const;
+    void updateLive(uint64_t slot, int64_t delta);
 
     /**
-     * Updates the nodes upwards recursively till the root.
-     * This function is first called by updateSumsLeavesToRoot,
-     * and then it recursively calls itself.
-     *
-     * @param node pointer to the node which is updated
-     * @param from_left variable which says that the request arrived
-     * from the left
-     * @param sum_from_below Sum of left and right children below
-     * @param level level in the tree the calling node is located
-     * @param stack_dist stack distance of the node below
-     * @param discard_node whether the calling node was discarded or not
-     * @return The stack distance of the current address.
-     *
+     * Give the address the next slot, on the top of the stack,
+     * compacting the slots first if they have run out.
+     * @param entry address and entry to give the slot to
      */
-    uint64_t updateSum(Node* node,
-                       bool from_left, uint64_t sum_from_below, uint64_t level,
-                       uint64_t stack_dist, bool discard_node);
+    void allocateSlot(AddressEntryMap::value_type &entry);
 
     /**
-     * Updates the leaf nodes and nodes above. This function is
-     * called by the calcStackDistAndUpdate.
-     *
-     * @param node pointer to the node which is updated
-     * @param is_new_leaf is true if this is a newly added node
-     * @return The stack distance of the current address.
-     *
+     * Release the slot of an address which is accessed again, or
+     * removed from the stack.
+     * @param entry entry of the address
      */
-    uint64_t updateSumsLeavesToRoot(Node* node, bool is_new_leaf);
+    void releaseSlot(const Entry &entry);
 
     /**
-     * updateTree is a tree balancing operation, which maintains the
-     * binary tree structure.
-     * This method is called whenever index%2 == 0 (i.e. every
-     * alternate cycle) The two main operation are :
-     * OP1. Moving the root node one layer up if index counter
-     *       crosses power of 2
-     * OP2. Addition of intermediate nodes as and when required
-     *      and linking them to their parents in the layer above.
+     * Renumber the live slots from zero keeping their order, resize
+     * the slots to about twice the number of addresses tracked, and
+     * rebuild the tree.
      */
-    void updateTree();
+    void compact();
 
     /**
-     * This method is used for verification purposes
-     * It recursively traverses upwards from the given node till
-     * the root to check if the ultimate parent node (root-node) points
-     * to null.
-     *
-     * @param node pointer to the node whose sanity is being checked
-     * @param level the level at which this node is located in the tree
-     *
+     * Stack distance of an address in the stack, that is the number of
+     * addresses which have been accessed since.
+     * @param entry entry of the address
+     * @return Unscaled stack distance
+     */
+    uint64_t
+    stackDistOf(const Entry &entry) const
+    {
+        return aiMap.size() - countLive(entry.slot);
+    }
+
+    /**
+     * Scale a stack distance of the sampled addresses to an estimate of
+     * the stack distance over all addresses.
+     * @param stack_dist stack distance among the sampled addresses
+     * @return The estimated stack distance
      */
-    void sanityCheckTree(const Node* node, uint64_t level = 0) const;
+    uint64_t scale(uint64_t stack_dist) const;
 
     /**
      * Return the counter for address accesses (unique and
@@ -272,15 +248,6 @@ class StackDistCalc
      */
     uint64_t getIndex() const { return index; }
 
-    /**
-     * Query depth of the tree (tree[0] represents leaf layer while
-     * tree[treeDepth] represents the root layer, all layers in
-     * between contain intermediate nodes)
-     *
-     * @return Tree depth
-     */
-    uint64_t getTreeDepth() const { return tree.size() - 1; }
-
     /**
      * Print the last n items on the stack.
      * This method prints top n entries in the tree based implementation as
@@ -305,19 +272,35 @@ class StackDistCalc
                              bool update_stack = false);
 
   public:
-    StackDistCalc(bool verify_stack = false);
-
-    ~StackDistCalc();
+    /**
+     * @param verify_stack check every stack distance against the naive
+     *        implementation
+     * @param sample_rate fraction of the addresses to sample, 1 to
+     *        track every address
+     */
+    StackDistCalc(bool verify_stack = false, double sample_rate = 1.0);
 
     /**
      * A convenient way of refering to infinity.
      */
     static constexpr uint64_t Infinity = std::numeric_limits<uint64_t>::max();
 
+    /**
+     * Check whether an address is part of the sample, and should be
+     * passed to the calculator. Always true without sampling.
+     * @param r_address The address to check
+     * @return true if the address is sampled
+     */
+    bool isSampled(const Addr r_address) const;
+
+    /**
+     * Number of unique addresses currently tracked.
+     */
+    uint64_t size() const { return aiMap.size(); }
 
     /**
      * Process the given address. If Mark is true then set the
-     * mark flag of the leaf node.
+     * mark flag of the address.
      * This function returns the stack distance of the incoming
      * address and the previous status of the mark flag.
      *
@@ -330,14 +313,14 @@ class StackDistCalc
 
     /**
      * Process the given address:
-     *  - Lookup the tree for the given address
-     *  - delete old node if found in tree
-     *  - add a new node (if addNewNode flag is set)
+     *  - Lookup the stack for the given address
+     *  - remove the address from the stack if found
+     *  - push the address on the stack (if addNewNode flag is set)
      * This function returns the stack distance of the incoming
      * address and the status of the mark flag.
      *
      * @param r_address The current address to process
-     * @param addNewNode If true, a new node is added to the tree
+     * @param addNewNode If true, the address is pushed on the stack
      * @return The stack distance of the current address and the mark flag.
      */
     std::pair<uint64_t, bool> calcStackDistAndUpdate(const Addr r_address,
@@ -346,66 +329,41 @@ class StackDistCalc
   private:
 
     /**
-     * Node which takes form of Leaf, INode or Root
+     * Smallest number of slots, so that a small working set does not
+     * need compacting too often.
      */
-    struct Node
-    {
-        // Sum of the left children
-        uint64_t sumLeft;
-
-        // Sum of the right children
-        uint64_t sumRight;
-
-        // Flag to indicate that sumLeft has gone from non-zero value to 0
-        bool discardLeft;
-
-        // Flag to indicate that sumRight has gone from non-zero value to 0
-        bool discardRight;
-
-        // Index of the current element in the Map
-        uint64_t nodeIndex;
-
-        // Pointer to the parent
-        Node* parent;
-
-        // Flag to mark the node as the right/left child
-        bool isLeftNode;
-
-        /**
-         * Flag to indicate if this address is marked. Used in case
-         * where stack distance of a touched address is required.
-         */
-        bool isMarked;
-
-        /**
-         * The discard flags are false by default they become true if
-         * the node is reached again in a future lookup.
-         */
-        Node() : sumLeft(0), sumRight(0), discardLeft(false),
-                 discardRight(false), nodeIndex(0),
-                 parent(nullptr), isLeftNode(true), isMarked(false)
-        { }
-    };
+    static constexpr uint64_t minSlots = 1024;
 
     /**
      * Internal counter for address accesses (unique and non-unique)
-     * This counter increments everytime the calcStackDist() method is
-     * called. This counter is used as a key for the hash- map at the
-     * leaf layer. Practically at every call to the calculator this
-     * counter is incremented and a new leaf node is added in the tree
-     * at the leaf layer using this counter value as the key.
+     * This counter increments everytime an address is pushed on the
+     * stack.
      */
     uint64_t index;
 
-    // Binary tree of partial sums
-    TreeType tree;
+    /**
+     * Fenwick tree counting the live slots, 1-based: tree[i] holds the
+     * number of live slots in [i - lsb(i), i - 1].
+     */
+    std::vector<uint64_t> tree;
+
+    /**
+     * Address owning each slot, or nullptr if the slot is not live.
+     * Unordered map elements do not move, so they can be pointed to.
+     */
+    std::vector<AddressEntryMap::value_type *> slots;
+
+    // Next slot to hand out, all the slots above are free
+    uint64_t nextSlot;
+
+    // Hash map which returns the state of each address in the stack
+    AddressEntryMap aiMap;
 
-    // Hash map which returns last seen index of each address
-    AddressIndexMap aiMap;
+    // Fraction of the addresses sampled
+    const double sampleRate;
 
-    // Keeps count of number of the next unique index for each
-    // level in the tree
-    std::vector<uint64_t> nextIndex;
+    // Addresses are sampled if their hash is below this threshold
+    const uint64_t sampleThreshold;
 
     // Dummy Stack for verification
     std::vector<uint64_t> stack;
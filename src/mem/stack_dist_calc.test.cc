@@ -0,0 +1,157 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "mem/stack_dist_calc.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Naive LRU stack, the most recently used address at the back. */
+uint64_t
+naiveStackDist(std::vector<Addr> &stack, Addr addr, bool update)
+{
+    auto it = std::find(stack.rbegin(), stack.rend(), addr);
+    if (it == stack.rend()) {
+        if (update)
+            stack.push_back(addr);
+        return StackDistCalc::Infinity;
+    }
+    const uint64_t dist = it - stack.rbegin();
+    if (update) {
+        stack.erase(std::next(it).base());
+        stack.push_back(addr);
+    }
+    return dist;
+}
+
+} // anonymous namespace
+
+TEST(StackDistCalcTest, ColdAndReuse)
+{
+    StackDistCalc calc;
+
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0).first,
+              StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x40).first,
+              StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x80).first,
+              StackDistCalc::Infinity);
+
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x80).first, 0);
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0).first, 2);
+    EXPECT_EQ(calc.calcStackDist(0x40).first, 2);
+    EXPECT_EQ(calc.size(), 3);
+}
+
+TEST(StackDistCalcTest, MarkAndRemove)
+{
+    StackDistCalc calc;
+
+    calc.calcStackDistAndUpdate(0x0);
+    calc.calcStackDistAndUpdate(0x40);
+
+    // Marking an address doesn't change the stack
+    EXPECT_EQ(calc.calcStackDist(0x0, true), std::make_pair(uint64_t(1),
+                                                            false));
+    EXPECT_EQ(calc.calcStackDist(0x0), std::make_pair(uint64_t(1), true));
+    calc.calcStackDist(0x0, true);
+
+    // Removing it returns the mark
+    EXPECT_EQ(calc.calcStackDistAndUpdate(0x0, false),
+              std::make_pair(uint64_t(1), true));
+    EXPECT_EQ(calc.size(), 1);
+    EXPECT_EQ(calc.calcStackDist(0x0).first, StackDistCalc::Infinity);
+    EXPECT_EQ(calc.calcStackDist(0x40).first, 0);
+}
+
+/**
+ * A long random trace over a working set larger than the initial
+ * number of slots, so that the slots get compacted many times.
+ */
+TEST(StackDistCalcTest, MatchesNaiveStack)
+{
+    StackDistCalc calc;
+    std::vector<Addr> stack;
+    std::mt19937_64 rng(42);
+
+    for (int i = 0; i < 200000; i++) {
+        // Mostly reuse a small set, sometimes touch a larger one
+        const Addr addr = (rng() % 8 ? rng() % 64 : rng() % 4096) * 64;
+        const int op = rng() % 16;
+        if (op == 0) {
+            ASSERT_EQ(calc.calcStackDistAndUpdate(addr, false).first,
+                      naiveStackDist(stack, addr, false));
+            stack.erase(std::remove(stack.begin(), stack.end(), addr),
+                        stack.end());
+        } else if (op == 1) {
+            ASSERT_EQ(calc.calcStackDist(addr).first,
+                      naiveStackDist(stack, addr, false));
+        } else {
+            ASSERT_EQ(calc.calcStackDistAndUpdate(addr).first,
+                      naiveStackDist(stack, addr, true));
+        }
+        ASSERT_EQ(calc.size(), stack.size());
+    }
+}
+
+TEST(StackDistCalcTest, Sampling)
+{
+    const double rate = 0.125;
+    StackDistCalc calc(false, rate);
+
+    // Cycle through a working set of lines, every reuse is at a stack
+    // distance of num_lines - 1
+    const uint64_t num_lines = 1 << 14;
+    uint64_t sampled = 0;
+    for (Addr line = 0; line < num_lines; line++)
+        sampled += calc.isSampled(line * 64);
+    EXPECT_NEAR(double(sampled) / num_lines, rate, 0.02);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (Addr line = 0; line < num_lines; line++) {
+            const Addr addr = line * 64;
+            if (!calc.isSampled(addr))
+                continue;
+            const uint64_t dist = calc.calcStackDistAndUpdate(addr).first;
+            if (pass == 0) {
+                EXPECT_EQ(dist, StackDistCalc::Infinity);
+            } else {
+                EXPECT_NEAR(double(dist), double(num_lines - 1),
+                            0.1 * num_lines);
+            }
+        }
+    }
+    EXPECT_EQ(calc.size(), sampled);
+}
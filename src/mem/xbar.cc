@@ -61,6 +61,7 @@ BaseXBar::BaseXBar(const BaseXBarParams &p)
       responseLatency(p.response_latency),
       headerLatency(p.header_latency),
       width(p.width),
+      maxBurstPackets(p.max_burst_packets),
       gotAddrRanges(p.port_default_connection_count +
                           p.port_mem_side_ports_connection_count, false),
       gotAllAddrRanges(false), defaultPortID(InvalidPortID),
@@ -144,13 +145,19 @@ BaseXBar::Layer<SrcType, DstType>::Layer(DstType& _port, BaseXBar& _xbar,
                                        const std::string& _name) :
     statistics::Group(&_xbar, _name.c_str()),
     port(_port), xbar(_xbar), _name(xbar.name() + "." + _name), state(IDLE),
-    waitingForPeer(NULL), releaseEvent([this]{ releaseLayer(); }, name()),
+    waitingForPeer(NULL), burstPort(NULL), burstPackets(0), burstWait(0),
+    releaseEvent([this]{ releaseLayer(); }, name()),
     ADD_STAT(occupancy, statistics::units::Tick::get(), "Layer occupancy (ticks)"),
-    ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization")
+    ADD_STAT(utilization, statistics::units::Ratio::get(), "Layer utilization"),
+    ADD_STAT(burstPacketCount, statistics::units::Count::get(),
+             "Packets forwarded in bursts, after the first one")
 {
     occupancy
         .flags(statistics::nozero);
 
+    burstPacketCount
+        .flags(statistics::nozero);
+
     utilization
         .precision(1)
         .flags(statistics::nozero);
@@ -169,10 +176,22 @@ void BaseXBar::Layer<SrcType, DstType>::occupyLayer(Tick until)
 
     // until should never be 0 as express snoops never occupy the layer
     assert(until != 0);
-    xbar.schedule(releaseEvent, until);
 
-    // account for the occupied ticks
-    occupancy += until - curTick();
+    if (releaseEvent.scheduled()) {
+        // in a burst, the packet occupies the layer after the previous
+        // ones, so push the release back by the time it needs
+        const Tick busy_time = until - xbar.clockEdge();
+        until = releaseEvent.when() + busy_time;
+        xbar.reschedule(releaseEvent, until);
+        occupancy += busy_time;
+        ++burstPacketCount;
+        burstWait = 0;
+    } else {
+        xbar.schedule(releaseEvent, until);
+
+        // account for the occupied ticks
+        occupancy += until - curTick();
+    }
 
     DPRINTF(BaseXBar, "The crossbar layer is now busy from tick %d to %d\n",
             curTick(), until);
@@ -188,6 +207,24 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
     // this state again in zero time if the peer does not immediately
     // call the layer when receiving the retry
 
+    // in burst mode, a busy layer takes further packets from the port
+    // it is forwarding for, unless another port is waiting, and the
+    // packet waits for the layer by having its header delayed instead
+    if (state == BUSY && src_port == burstPort &&
+        burstPackets < xbar.maxBurstPackets && releaseEvent.scheduled() &&
+        waitingForPeer == NULL && waitingForLayer.empty()) {
+        // the wait grows with every packet of the burst, so end the
+        // burst before it gets close to the header delay sanity check
+        // of calcPacketTiming, leaving room for the delay the packet
+        // already carries
+        const Tick wait = releaseEvent.when() - xbar.clockEdge();
+        if (wait <= sim_clock::as_int::us / 2) {
+            ++burstPackets;
+            burstWait = wait;
+            return true;
+        }
+    }
+
     // first we see if the layer is busy, next we check if the
     // destination port is already engaged in a transaction waiting
     // for a retry from the peer
@@ -206,6 +243,10 @@ BaseXBar::Layer<SrcType, DstType>::tryTiming(SrcType* src_port)
 
     state = BUSY;
 
+    // start a new burst
+    burstPort = src_port;
+    burstPackets = 1;
+
     return true;
 }
 
@@ -239,6 +280,13 @@ BaseXBar::Layer<SrcType, DstType>::failedTiming(SrcType* src_port,
     // test
     assert(state == BUSY);
 
+    // end the burst, and when in a burst the layer is already occupied
+    // until after the header is sent
+    burstPort = NULL;
+    burstWait = 0;
+    if (releaseEvent.scheduled())
+        return;
+
     // occupy the bus accordingly
     occupyLayer(busy_time);
 }
@@ -253,6 +301,7 @@ BaseXBar::Layer<SrcType, DstType>::releaseLayer()
 
     // update the state
     state = IDLE;
+    burstPort = NULL;
 
     // bus layer is now idle, so if someone is waiting we can retry
     if (!waitingForLayer.empty()) {
@@ -296,6 +345,7 @@ BaseXBar::Layer<SrcType, DstType>::retryWaiting()
         // update the state to busy and reset the retrying port, we
         // have done our bit and sent the retry
         state = BUSY;
+        burstPort = NULL;
 
         // occupy the crossbar layer until the next clock edge
         occupyLayer(xbar.clockEdge());
@@ -129,6 +129,17 @@ class BaseXBar : public ClockedObject
          */
         bool tryTiming(SrcType* src_port);
 
+        /**
+         * Get the time the packet just accepted by tryTiming has to
+         * wait for the layer, and should be added to its header
+         * delay. This is only non-zero in burst mode, where the packet
+         * is forwarded while the layer is still busy with the previous
+         * packets of the burst.
+         *
+         * @return Ticks to delay the packet by
+         */
+        Tick burstDelay() const { return burstWait; }
+
         /**
          * Deal with a destination port accepting a packet by potentially
          * removing the source port from the retry list (if retrying) and
@@ -216,6 +227,16 @@ class BaseXBar : public ClockedObject
          */
         SrcType* waitingForPeer;
 
+        /**
+         * Burst mode, forwarding back-to-back packets from the same
+         * source port in a single occupancy of the layer. The port and
+         * number of packets of the current burst, and the time the
+         * packet being forwarded waits for the layer.
+         */
+        SrcType* burstPort;
+        unsigned burstPackets;
+        Tick burstWait;
+
         /**
          * Release the layer after being occupied and return to an
          * idle state where we proceed to send a retry to any
@@ -229,9 +250,12 @@ class BaseXBar : public ClockedObject
          * the time the layer spends in the busy state and are thus only
          * relevant when the memory system is in timing mode.
          */
-        statistics::Scalar occupancy;
+        statistics::ShardedScalar occupancy;
         statistics::Formula utilization;
 
+        /** Packets forwarded as part of a burst, after the first one */
+        statistics::ShardedScalar burstPacketCount;
+
     };
 
     class ReqLayer : public Layer<ResponsePort, RequestPort>
@@ -315,6 +339,8 @@ class BaseXBar : public ClockedObject
     const Cycles headerLatency;
     /** the width of the xbar in bytes */
     const uint32_t width;
+    /** Maximum number of packets in a burst of a layer */
+    const unsigned maxBurstPackets;
 
     AddrRangeMap<PortID, 3> portMap;
 
@@ -397,11 +423,12 @@ class BaseXBar : public ClockedObject
      * size are two-dimensional vectors that are indexed by the
      * CPU-side port and memory-side port id (thus the neighbouring memory-side
      * ports and neighbouring CPU-side ports), summing up both directions
-     * (request and response).
+     * (request and response). They are sharded, as the crossbar may be
+     * used from the threads of several event queues.
      */
-    statistics::Vector transDist;
-    statistics::Vector2d pktCount;
-    statistics::Vector2d pktSize;
+    statistics::ShardedVector transDist;
+    statistics::ShardedVector2d pktCount;
+    statistics::ShardedVector2d pktSize;
 
   public:
 
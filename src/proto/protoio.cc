@@ -37,16 +37,27 @@
 
 #include "proto/protoio.hh"
 
+#include <algorithm>
+#include <cstring>
 #include <string>
 
+#include "base/bitfield.hh"
 #include "base/logging.hh"
 
 using namespace google::protobuf;
 
 ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
+    ProtoOutputStream(filename, 0)
+{
+}
+
+ProtoOutputStream::ProtoOutputStream(const std::string& filename,
+                                     size_t buffer_size) :
     fileStream(filename.c_str(),
             std::ios::out | std::ios::binary | std::ios::trunc),
-    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL)
+    wrappedFileStream(NULL), gzipStream(NULL), zeroCopyStream(NULL),
+    ringSize(buffer_size ? gem5::alignToPowerOfTwo(buffer_size) : 0),
+    head(0), tail(0), closing(false), writerWaiting(false)
 {
     if (!fileStream.good())
         panic("Could not open %s for writing\n", filename);
@@ -69,10 +80,22 @@ ProtoOutputStream::ProtoOutputStream(const std::string& filename) :
 
     // Note that each type of stream (packet, instruction etc) should
     // add its own header and perform the appropriate checks
+
+    if (ringSize) {
+        ring.reset(new uint8_t[ringSize]);
+        writer = std::thread([this]() { drain(); });
+    }
 }
 
 ProtoOutputStream::~ProtoOutputStream()
 {
+    // Let the writer thread empty the buffer, and wait for it
+    if (writer.joinable()) {
+        closing.store(true);
+        wakeWriter();
+        writer.join();
+    }
+
     // As the compression is optional, see if the stream exists
     if (gzipStream != NULL)
         delete gzipStream;
@@ -80,24 +103,113 @@ ProtoOutputStream::~ProtoOutputStream()
     fileStream.close();
 }
 
-void
+bool
 ProtoOutputStream::write(const Message& msg)
 {
-    // Due to the byte limit of the coded stream we create it for
-    // every single mesage (based on forum discussions around the size
-    // limitation)
-    io::CodedOutputStream codedStream(zeroCopyStream);
-
-    // Write the size of the message to the stream
 #   if GOOGLE_PROTOBUF_VERSION < 3001000
         auto msg_size = msg.ByteSize();
 #   else
         auto msg_size = msg.ByteSizeLong();
 #   endif
-    codedStream.WriteVarint32(msg_size);
 
-    // Write the message itself to the stream
-    msg.SerializeWithCachedSizes(&codedStream);
+    if (!ringSize) {
+        // Due to the byte limit of the coded stream we create it for
+        // every single mesage (based on forum discussions around the size
+        // limitation)
+        io::CodedOutputStream codedStream(zeroCopyStream);
+
+        // Write the size of the message to the stream
+        codedStream.WriteVarint32(msg_size);
+
+        // Write the message itself to the stream
+        msg.SerializeWithCachedSizes(&codedStream);
+        return false;
+    }
+
+    // Serialize the message, prepended with its size as above, and hand
+    // it over to the writer thread
+    const size_t size_bytes = io::CodedOutputStream::VarintSize32(msg_size);
+    record.resize(size_bytes + msg_size);
+    uint8_t* const data = reinterpret_cast<uint8_t*>(&record[0]);
+    io::CodedOutputStream::WriteVarint32ToArray(msg_size, data);
+    msg.SerializeWithCachedSizesToArray(data + size_bytes);
+
+    return push(data, record.size());
+}
+
+bool
+ProtoOutputStream::push(const uint8_t* data, size_t size)
+{
+    bool stalled = false;
+    uint64_t pos = head.load(std::memory_order_relaxed);
+    while (size) {
+        const uint64_t used = pos - tail.load(std::memory_order_acquire);
+        const size_t space = ringSize - used;
+        if (!space) {
+            // The writer thread is behind, give it a chance to catch up
+            stalled = true;
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Copy up to the end of the free space or of the buffer,
+        // whichever comes first
+        const size_t offset = pos & (ringSize - 1);
+        const size_t count = std::min({size, space, ringSize - offset});
+        std::memcpy(&ring[offset], data, count);
+        data += count;
+        size -= count;
+        pos += count;
+        head.store(pos);
+        wakeWriter();
+    }
+    return stalled;
+}
+
+void
+ProtoOutputStream::wakeWriter()
+{
+    // The writer thread announces it is about to wait before checking
+    // for data one last time, so either it sees the new data, or it is
+    // seen waiting here
+    if (writerWaiting.load()) {
+        std::lock_guard<std::mutex> lock(writerMutex);
+        writerCond.notify_one();
+    }
+}
+
+void
+ProtoOutputStream::drain()
+{
+    uint64_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+        // Check for closing before looking at the data, so that
+        // everything written before the stream was closed is seen
+        const bool closed = closing.load();
+        const uint64_t end = head.load();
+        if (pos == end) {
+            if (closed)
+                break;
+            std::unique_lock<std::mutex> lock(writerMutex);
+            writerWaiting.store(true);
+            if (head.load() == pos && !closing.load())
+                writerCond.wait(lock);
+            writerWaiting.store(false);
+            continue;
+        }
+
+        // Write out everything available, in at most two pieces as the
+        // data may wrap around the end of the buffer
+        io::CodedOutputStream codedStream(zeroCopyStream);
+        while (pos != end) {
+            const size_t offset = pos & (ringSize - 1);
+            const size_t count = std::min<uint64_t>(end - pos,
+                                                    ringSize - offset);
+            codedStream.WriteRaw(&ring[offset], count);
+            pos += count;
+        }
+        tail.store(pos);
+    }
 }
 
 ProtoInputStream::ProtoInputStream(const std::string& filename) :
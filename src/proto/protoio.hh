@@ -49,7 +49,14 @@
 #include <google/protobuf/io/zero_copy_stream_impl.h>
 #include <google/protobuf/message.h>
 
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 
 /**
  * A ProtoStream provides the shared functionality of the input and
@@ -86,6 +93,13 @@ class ProtoStream
  * basis to avoid having to deal with huge data structures. The latter
  * is made possible by encoding the length of each message in the
  * stream.
+ *
+ * Optionally, the compression and the file writes can be moved off the
+ * calling thread. The messages are then serialized into a ring buffer,
+ * which a writer thread drains into the file. The ring has a single
+ * producer and a single consumer, and is lock free. When it is full
+ * the producer waits for the writer to catch up, so no message is ever
+ * dropped, and the file is the same as without the buffer.
  */
 class ProtoOutputStream : public ProtoStream
 {
@@ -100,6 +114,17 @@ class ProtoOutputStream : public ProtoStream
      */
     ProtoOutputStream(const std::string& filename);
 
+    /**
+     * Create an output stream for a given file name, written by a
+     * separate thread through a buffer of the given size. A size of
+     * zero writes from the calling thread, as above.
+     *
+     * @param filename Path to the file to create or truncate
+     * @param buffer_size Size of the buffer in bytes, rounded up to a
+     *                    power of two
+     */
+    ProtoOutputStream(const std::string& filename, size_t buffer_size);
+
     /**
      * Destruct the output stream, and also flush and close the
      * underlying file streams and coded streams.
@@ -111,11 +136,34 @@ class ProtoOutputStream : public ProtoStream
      * size.
      *
      * @param msg Message to write to the stream
+     * @return True if the message had to wait for space in the buffer
      */
-    void write(const google::protobuf::Message& msg);
+    bool write(const google::protobuf::Message& msg);
 
   private:
 
+    /**
+     * Copy serialized bytes to the ring buffer, waiting for the writer
+     * thread to make space if needed.
+     *
+     * @param data Bytes to copy
+     * @param size Number of bytes
+     * @return True if there was not enough space at some point
+     */
+    bool push(const uint8_t* data, size_t size);
+
+    /**
+     * Body of the writer thread, which moves the bytes from the ring
+     * buffer to the file until the stream is closed.
+     */
+    void drain();
+
+    /**
+     * Wake up the writer thread if it is waiting for data.
+     */
+    void wakeWriter();
+
+
     /// Underlying file output stream
     std::ofstream fileStream;
 
@@ -128,6 +176,40 @@ class ProtoOutputStream : public ProtoStream
     /// Top-level zero-copy stream, either with compression or not
     google::protobuf::io::ZeroCopyOutputStream* zeroCopyStream;
 
+    /// Serialized message, reused between writes to the ring buffer
+    std::string record;
+
+    /// Ring buffer, empty when writing from the calling thread
+    std::unique_ptr<uint8_t[]> ring;
+
+    /// Size of the ring buffer, a power of two
+    size_t ringSize;
+
+    /**
+     * Total number of bytes written to and read from the ring buffer.
+     * Each is only updated by one side, and they are never wrapped, so
+     * their difference is the occupancy of the buffer.
+     * @{
+     */
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+    /** @} */
+
+    /// Set when the stream is closed, to stop the writer thread
+    std::atomic<bool> closing;
+
+    /**
+     * Used to wake up the writer thread when it waits for data. The
+     * producer only takes the lock when the writer thread is waiting.
+     * @{
+     */
+    std::atomic<bool> writerWaiting;
+    std::mutex writerMutex;
+    std::condition_variable writerCond;
+    /** @} */
+
+    /// Thread moving the bytes from the ring buffer to the file
+    std::thread writer;
 };
 
 /**
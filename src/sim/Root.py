@@ -66,6 +66,27 @@ class Root(SimObject):
     # Simulation Quantum for multiple main event queue simulation.
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
+    # Stretch each quantum to end sim_quantum ticks after the earliest
+    # pending event in any queue. sim_quantum must then be a lower bound on
+    # the latency of every event scheduled into another queue.
+    adaptive_sim_quantum = Param.Bool(False,
+        "synchronise relative to the earliest pending event")
+
+    # Events marked as commutative (e.g. the write completion and activation
+    # events of the DRAM ranks) that are scheduled for the same tick and
+    # priority can be serviced in parallel by a pool of host threads. Only
+    # supported in single eventq simulations. Batching is opt-in, as every
+    # batch is handed over to the pool threads and waited for, which costs
+    # more than servicing a few small events such as the DRAM rank ones.
+    # Only enable it when the batches are large, or their events costly.
+    event_batch_threads = Param.Unsigned(1,
+        "host threads servicing batches of commutative events")
+
+    # Account the host time spent servicing each kind of event. The profile
+    # is written to event_profile.txt and, in the folded stack format used
+    # by flame graph tools, to event_profile.folded on every stats dump.
+    profile_events = Param.Bool(False,
+        "profile the host time spent servicing events")
 
     full_system = Param.Bool("if this is a full system simulation")
 
@@ -0,0 +1,143 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#include <algorithm>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+
+#include "base/cprintf.hh"
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace
+{
+
+/** Keys interned by all the profilers, indexed by their id. */
+std::mutex keysMutex;
+std::vector<std::string> keys;
+std::unordered_map<std::string, int32_t> keyIds;
+
+} // anonymous namespace
+
+int32_t
+EventProfiler::intern(const Event *event)
+{
+    std::string event_key = key(event);
+
+    std::lock_guard<std::mutex> lock(keysMutex);
+    auto it = keyIds.find(event_key);
+    if (it != keyIds.end())
+        return it->second;
+
+    const int32_t id = keys.size();
+    keys.push_back(event_key);
+    keyIds.emplace(std::move(event_key), id);
+    return id;
+}
+
+void
+EventProfiler::record(Event *event, uint64_t host_ns, uint64_t count)
+{
+    if (event->profileId < 0)
+        event->profileId = intern(event);
+
+    const size_t id = event->profileId;
+    if (id >= _entries.size())
+        _entries.resize(id + 1);
+
+    Entry &entry = _entries[id];
+    entry.count += count;
+    entry.hostNs += host_ns;
+}
+
+std::string
+EventProfiler::key(const Event *event)
+{
+    std::string name = event->name();
+
+    // Events without a name of their own are named after their instance
+    // number, aggregate them by description only.
+    if (name.compare(0, 6, "Event_") == 0)
+        return event->description();
+
+    const std::string wrapped = ".wrapped_function_event";
+    if (name.size() > wrapped.size() &&
+        name.compare(name.size() - wrapped.size(), wrapped.size(),
+                     wrapped) == 0) {
+        name.resize(name.size() - wrapped.size());
+    }
+
+    std::replace(name.begin(), name.end(), '.', ';');
+    return name + ";" + event->description();
+}
+
+void
+EventProfiler::dump(const std::vector<const EventProfiler *> &profilers,
+                    std::ostream &table, std::ostream &folded)
+{
+    std::vector<Entry> merged;
+    for (const auto *profiler : profilers) {
+        if (profiler->_entries.size() > merged.size())
+            merged.resize(profiler->_entries.size());
+        for (size_t id = 0; id < profiler->_entries.size(); id++) {
+            merged[id].count += profiler->_entries[id].count;
+            merged[id].hostNs += profiler->_entries[id].hostNs;
+        }
+    }
+
+    std::vector<size_t> sorted;
+    uint64_t total_ns = 0;
+    for (size_t id = 0; id < merged.size(); id++) {
+        if (!merged[id].count)
+            continue;
+        sorted.push_back(id);
+        total_ns += merged[id].hostNs;
+    }
+    std::sort(sorted.begin(), sorted.end(),
+        [&merged](size_t a, size_t b) {
+            return merged[a].hostNs > merged[b].hostNs;
+        });
+
+    std::lock_guard<std::mutex> lock(keysMutex);
+
+    ccprintf(table, "%12s %14s %8s %10s  %s\n",
+             "count", "host_seconds", "percent", "ns/event", "event");
+    for (const size_t id : sorted) {
+        const Entry &entry = merged[id];
+        ccprintf(table, "%12d %14.6f %7.2f%% %10.1f  %s\n",
+                 entry.count, entry.hostNs / 1e9,
+                 total_ns ? 100.0 * entry.hostNs / total_ns : 0.0,
+                 entry.count ? double(entry.hostNs) / entry.count : 0.0,
+                 keys[id]);
+        ccprintf(folded, "%s %d\n", keys[id], entry.hostNs);
+    }
+}
+
+} // namespace gem5
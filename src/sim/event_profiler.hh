@@ -0,0 +1,105 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+class Event;
+
+/**
+ * Host time profile of the events serviced by an event queue. Events are
+ * aggregated by their owner, derived from the event name, and their
+ * description. Each event queue has its own profiler so that recording
+ * needs no synchronisation, the profiles of all queues are merged when
+ * they are dumped.
+ *
+ * The key of an event is only built the first time the event is
+ * recorded. It is interned in a table shared by all the profilers and
+ * the event keeps its index, so recording an event again is a plain
+ * array update.
+ */
+class EventProfiler
+{
+  public:
+    struct Entry
+    {
+        /** Number of times the events were serviced. */
+        uint64_t count = 0;
+        /** Host nanoseconds spent servicing the events. */
+        uint64_t hostNs = 0;
+    };
+
+    /**
+     * Account for servicing an event.
+     *
+     * @param event The serviced event.
+     * @param host_ns Host nanoseconds spent servicing it.
+     * @param count Number of events serviced, more than one when the
+     *        event led a batch of commutative events.
+     */
+    void record(Event *event, uint64_t host_ns, uint64_t count=1);
+
+    /** The entries of this profile, indexed by interned key. */
+    const std::vector<Entry> &entries() const { return _entries; }
+
+    void clear() { _entries.clear(); }
+
+    /**
+     * Build the profile key of an event, a list of frames separated by
+     * semicolons made of the components of the owner name followed by
+     * the description of the event.
+     */
+    static std::string key(const Event *event);
+
+    /**
+     * Merge several profiles and write them out.
+     *
+     * @param profilers The profiles to merge.
+     * @param table Stream receiving a table sorted by host time.
+     * @param folded Stream receiving the profile in the folded stack
+     *        format consumed by flame graph tools.
+     */
+    static void dump(const std::vector<const EventProfiler *> &profilers,
+                     std::ostream &table, std::ostream &folded);
+
+  private:
+    /** Intern the key of an event and return its index. */
+    static int32_t intern(const Event *event);
+
+    /** Entries indexed by interned key, grown on demand. */
+    std::vector<Entry> _entries;
+};
+
+} // namespace gem5
+
+#endif // __SIM_EVENT_PROFILER_HH__
@@ -31,6 +31,7 @@
 #include "sim/eventq.hh"
 
 #include <cassert>
+#include <chrono>
 #include <iostream>
 #include <mutex>
 #include <string>
@@ -38,14 +39,18 @@
 #include <vector>
 
 #include "base/logging.hh"
+#include "base/stats/storage.hh"
 #include "base/trace.hh"
+#include "base/work_stealing_pool.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/event_profiler.hh"
 
 namespace gem5
 {
 
 Tick simQuantum = 0;
+bool adaptiveSimQuantum = false;
 
 //
 // Main Event Queues
@@ -58,6 +63,36 @@ std::vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
 
+//! Thread pool servicing commutative event batches, if enabled.
+static std::unique_ptr<WorkStealingPool> eventBatchPool;
+
+typedef std::vector<std::pair<EventQueue *, Event *>> DeferredEvents;
+
+//! Events scheduled by the event the running thread is servicing as part
+//! of a batch. They are inserted once the batch is complete.
+static __thread DeferredEvents *_deferredEvents = nullptr;
+
+void
+setEventBatchThreads(unsigned num_threads)
+{
+    eventBatchPool.reset();
+    if (num_threads <= 1)
+        return;
+
+    // The helper threads update sharded stats through their own shards,
+    // the simulation thread keeps shard 0.
+    eventBatchPool.reset(new WorkStealingPool(num_threads,
+        [](unsigned participant) {
+            statistics::curStatShard(participant);
+        }));
+}
+
+unsigned
+eventBatchThreads()
+{
+    return eventBatchPool ? eventBatchPool->size() : 1;
+}
+
 EventQueue *
 getEventQueue(uint32_t index)
 {
@@ -195,9 +230,8 @@ EventQueue::remove(Event *event)
 }
 
 Event *
-EventQueue::serviceOne()
+EventQueue::popHead()
 {
-    std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
     Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
@@ -214,13 +248,34 @@ EventQueue::serviceOne()
         head = head->nextBin;
     }
 
+    return event;
+}
+
+Event *
+EventQueue::serviceOne()
+{
+    std::lock_guard<EventQueue> lock(*this);
+    Event *event = popHead();
+
     // handle action
     if (!event->squashed()) {
         // forward current cycle to the time when this event occurs.
         setCurTick(event->when());
+        if (event->flags.isSet(Event::Commutative) && eventBatchPool) {
+            serviceBatch(event);
+            return NULL;
+        }
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (_profiler) {
+            const auto start = std::chrono::steady_clock::now();
+            event->process();
+            const std::chrono::nanoseconds elapsed =
+                std::chrono::steady_clock::now() - start;
+            _profiler->record(event, elapsed.count());
+        } else {
+            event->process();
+        }
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -235,6 +290,67 @@ EventQueue::serviceOne()
     return NULL;
 }
 
+void
+EventQueue::serviceBatch(Event *first)
+{
+    // All the events of a bin share the same tick and priority, so the
+    // batch is the run of commutative events at the top of the bin.
+    std::vector<Event *> batch(1, first);
+    while (head && head->when() == first->when() &&
+           head->priority() == first->priority() &&
+           head->flags.isSet(Event::Commutative) && !head->squashed()) {
+        batch.push_back(popHead());
+    }
+
+    std::vector<DeferredEvents> deferred(batch.size());
+    const bool was_parallel = inParallelMode;
+    const auto start = std::chrono::steady_clock::now();
+
+    // Every thread servicing the batch, including this one, detaches
+    // from the queue while keeping its notion of the current tick. In
+    // parallel mode, schedule() then hands the new events to
+    // asyncInsert(), which defers them to the batch slot of the event.
+    inParallelMode = true;
+    eventBatchPool->run(batch.size(), [&](size_t i) {
+        EventQueue *const old_eq = _curEventQueue;
+        Tick *const old_tick = Gem5Internal::_curTickPtr;
+        _curEventQueue = nullptr;
+        Gem5Internal::_curTickPtr = &_curTick;
+        _deferredEvents = &deferred[i];
+
+        Event *event = batch[i];
+        if (debug::Event)
+            event->trace("executed");
+        event->process();
+        assert(!event->isExitEvent());
+
+        _deferredEvents = nullptr;
+        _curEventQueue = old_eq;
+        Gem5Internal::_curTickPtr = old_tick;
+    });
+    inParallelMode = was_parallel;
+
+    // The events of a batch overlap, account the batch as a whole.
+    if (_profiler) {
+        const std::chrono::nanoseconds elapsed =
+            std::chrono::steady_clock::now() - start;
+        _profiler->record(first, elapsed.count(), batch.size());
+    }
+
+    // Insert the new events in batch order, so that the order they are
+    // serviced in is deterministic. It only differs from the serial
+    // one for the events scheduled for the tick and priority of the
+    // batch itself, as they are serviced after the whole batch rather
+    // than right after the event scheduling them.
+    for (auto &events : deferred) {
+        for (auto &eq_event : events)
+            eq_event.first->insert(eq_event.second);
+    }
+
+    for (auto *event : batch)
+        event->release();
+}
+
 void
 Event::serialize(CheckpointOut &cp) const
 {
@@ -261,9 +377,15 @@ Event::unserialize(CheckpointIn &cp)
     // "flags = _flags" would just overwrite the initialization.
     // So, read in the checkpoint flags, but then set the Initialized
     // flag on top of it in order to avoid failures.
+    // The Commutative flag is a property of the event rather than of its
+    // state, keep the one the event was constructed with.
     assert(initialized());
+    const bool commutative = flags.isSet(Commutative);
     flags = _flags;
+    flags.clear(InitMask | Commutative);
     flags.set(Initialized);
+    if (commutative)
+        flags.set(Commutative);
 
     // need to see if original event was in a scheduled, unsquashed
     // state, but don't want to restore those flags in the current
@@ -420,9 +542,20 @@ EventQueue::EventQueue(const std::string &n)
 {
 }
 
+EventQueue::~EventQueue()
+{
+    while (!empty())
+        deschedule(getHead());
+}
+
 void
 EventQueue::asyncInsert(Event *event)
 {
+    if (_deferredEvents) {
+        _deferredEvents->emplace_back(this, event);
+        return;
+    }
+
     async_queue_mutex.lock();
     async_queue.push_back(event);
     async_queue_mutex.unlock();
@@ -442,4 +575,24 @@ EventQueue::handleAsyncInsertions()
     async_queue_mutex.unlock();
 }
 
+void
+EventQueue::enableProfiling()
+{
+    if (!_profiler)
+        _profiler.reset(new EventProfiler);
+}
+
+Tick
+EventQueue::nextAsyncTick()
+{
+    Tick next = MaxTick;
+    async_queue_mutex.lock();
+
+    for (const auto *event : async_queue)
+        next = std::min(next, event->when());
+
+    async_queue_mutex.unlock();
+    return next;
+}
+
 } // namespace gem5
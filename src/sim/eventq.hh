@@ -56,6 +56,7 @@ namespace gem5
 {
 
 class EventQueue;       // forward declaration
+class EventProfiler;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -65,6 +66,12 @@ class BaseGlobalEvent;
 //! Queue B should be at least simQuantum ticks away in future.
 extern Tick simQuantum;
 
+//! Adaptive quantum synchronisation for multiple eventq simulation. When
+//! set, the queues synchronize simQuantum ticks after the earliest pending
+//! event in any queue rather than simQuantum ticks after the last
+//! synchronisation, skipping periods in which no queue has work to do.
+extern bool adaptiveSimQuantum;
+
 //! Current number of allocated main event queues.
 extern uint32_t numMainEventQueues;
 
@@ -79,6 +86,22 @@ extern __thread EventQueue *_curEventQueue;
 //! Current mode of execution: parallel / serial
 extern bool inParallelMode;
 
+/**
+ * Service batches of commutative events scheduled for the same tick and
+ * priority in parallel with a pool of host threads.
+ *
+ * Batching is disabled by default. Handing a batch over to the pool
+ * costs a synchronisation of its threads, so it only speeds up the
+ * simulation if the batches hold enough work to amortise it.
+ *
+ * @param num_threads Number of threads servicing a batch, including the
+ *        simulation thread. Batching is disabled if it is at most 1.
+ */
+void setEventBatchThreads(unsigned num_threads);
+
+//! Number of threads servicing commutative event batches.
+unsigned eventBatchThreads();
+
 //! Function for returning eventq queue for the provided
 //! index. The function allocates a new queue in case one
 //! does not exist for the index, provided that the index
@@ -99,8 +122,8 @@ class EventBase
     typedef unsigned short FlagsType;
     typedef ::gem5::Flags<FlagsType> Flags;
 
-    static const FlagsType PublicRead    = 0x003f; // public readable flags
-    static const FlagsType PublicWrite   = 0x001d; // public writable flags
+    static const FlagsType PublicRead    = 0x007f; // public readable flags
+    static const FlagsType PublicWrite   = 0x005d; // public writable flags
     static const FlagsType Squashed      = 0x0001; // has been squashed
     static const FlagsType Scheduled     = 0x0002; // has been scheduled
     static const FlagsType Managed       = 0x0004; // Use life cycle manager
@@ -113,8 +136,9 @@ class EventBase
     static const FlagsType Reserved0     = 0x0008;
     static const FlagsType IsExitEvent   = 0x0010; // special exit event
     static const FlagsType IsMainQueue   = 0x0020; // on main event queue
-    static const FlagsType Initialized   = 0x7a40; // somewhat random bits
-    static const FlagsType InitMask      = 0xffc0; // mask for init bits
+    static const FlagsType Commutative   = 0x0040; // may run in parallel
+    static const FlagsType Initialized   = 0x7a80; // somewhat random bits
+    static const FlagsType InitMask      = 0xff80; // mask for init bits
 
   public:
     /**
@@ -272,6 +296,11 @@ class Event : public EventBase, public Serializable
     Priority _priority; //!< event priority
     Flags flags;
 
+    /// Profile entry of this event, assigned by the EventProfiler the
+    /// first time it records the event.
+    int32_t profileId;
+    friend class EventProfiler;
+
 #ifndef NDEBUG
     /// Global counter to generate unique IDs for Event instances
     static Counter instanceCounter;
@@ -413,7 +442,7 @@ class Event : public EventBase, public Serializable
      */
     Event(Priority p = Default_Pri, Flags f = 0)
         : nextBin(nullptr), nextInBin(nullptr), _when(0), _priority(p),
-          flags(Initialized | f)
+          flags(Initialized | f), profileId(-1)
     {
         assert(f.noneSet(~PublicWrite));
 #ifndef NDEBUG
@@ -485,6 +514,36 @@ class Event : public EventBase, public Serializable
      */
     bool isExitEvent() const { return flags.isSet(IsExitEvent); }
 
+    /**
+     * Check whether the event commutes with the other commutative events
+     * of its tick and priority.
+     *
+     * @see setCommutative()
+     */
+    bool isCommutative() const { return flags.isSet(Commutative); }
+
+    /**
+     * Declare that processing this event commutes with processing any
+     * other commutative event scheduled for the same tick and priority.
+     * When event batching is enabled, such events are serviced in
+     * parallel by a pool of host threads, so they must only touch state
+     * private to their owner (or sharded stats) and must not deschedule
+     * or reschedule events. Events they schedule are inserted once the
+     * whole batch has been serviced, in batch order. This is a
+     * deterministic order, which matches the serial one except for
+     * events scheduled for the tick and priority of the batch itself:
+     * these are serviced after the whole batch, and not right after
+     * the event scheduling them.
+     *
+     * @see setEventBatchThreads()
+     */
+    void
+    setCommutative()
+    {
+        assert(!scheduled());
+        flags.set(Commutative);
+    }
+
     /**
      * Check whether this event will auto-delete
      *
@@ -656,6 +715,9 @@ class EventQueue
      */
     UncontendedMutex service_mutex;
 
+    //! Host time profile of the serviced events, null unless enabled.
+    std::unique_ptr<EventProfiler> _profiler;
+
     //! Insert / remove event from the queue. Should only be called
     //! by thread operating this queue.
     void insert(Event *event);
@@ -666,6 +728,13 @@ class EventQueue
     //! owning thread, should call this function instead of insert().
     void asyncInsert(Event *event);
 
+    //! Remove the head of the queue and return it.
+    Event *popHead();
+
+    //! Service the head event together with the commutative events that
+    //! follow it in the same bin on the event batch thread pool.
+    void serviceBatch(Event *first);
+
     EventQueue(const EventQueue &);
 
   public:
@@ -859,6 +928,16 @@ class EventQueue
 
     Event *serviceOne();
 
+    /**
+     * Start accounting the host time spent servicing each event. This
+     * must be called from the thread owning the queue or before the
+     * simulation threads start.
+     */
+    void enableProfiling();
+
+    //! The host time profile of this queue, null if not enabled.
+    EventProfiler *profiler() const { return _profiler.get(); }
+
     /**
      * process all events up to the given timestamp.  we inline a quick test
      * to see if there are any events to process; if so, call the internal
@@ -912,6 +991,15 @@ class EventQueue
      */
     void handleAsyncInsertions();
 
+    /**
+     * Earliest tick of the events that are waiting in the async_queue,
+     * i.e., of the events that were scheduled into this queue by other
+     * threads and have not been inserted yet.
+     *
+     * @return The earliest tick, or MaxTick if there are no such events.
+     */
+    Tick nextAsyncTick();
+
     /**
      *  Function to signal that the event loop should be woken up because
      *  an event has been scheduled by an agent outside the gem5 event
@@ -968,11 +1056,7 @@ class EventQueue
      */
     void checkpointReschedule(Event *event);
 
-    virtual ~EventQueue()
-    {
-        while (!empty())
-            deschedule(getHead());
-    }
+    virtual ~EventQueue();
 };
 
 inline void
@@ -0,0 +1,201 @@
+/*
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/**
+ * An event that logs its id when it is processed and, optionally,
+ * schedules a follow-up event a fixed delay later.
+ */
+class LogEvent : public Event
+{
+  public:
+    LogEvent(EventQueue &eq, std::vector<int> &log, std::mutex &m, int id,
+             bool commutative)
+        : eq(eq), log(log), m(m), id(id)
+    {
+        if (commutative)
+            setCommutative();
+    }
+
+    void
+    process() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            log.push_back(id);
+        }
+        if (next)
+            eq.schedule(next, when() + delay);
+    }
+
+    EventQueue &eq;
+    std::vector<int> &log;
+    std::mutex &m;
+    const int id;
+    Event *next = nullptr;
+    Tick delay = 0;
+};
+
+class EventBatchTest : public testing::Test
+{
+  protected:
+    EventBatchTest() : eq("test_eq") { curEventQueue(&eq); }
+
+    ~EventBatchTest() { setEventBatchThreads(1); }
+
+    /**
+     * Schedule num_events events at tick 100, all of them but the
+     * serial ones being commutative. Event i schedules event
+     * num_events + i delay ticks later. Service everything and return
+     * the processing order.
+     */
+    std::vector<int>
+    run(int num_events, const std::set<int> &serial={}, Tick delay=100)
+    {
+        std::vector<int> log;
+        std::mutex m;
+        std::vector<std::unique_ptr<LogEvent>> events;
+        for (int i = 0; i < 2 * num_events; i++) {
+            events.emplace_back(new LogEvent(eq, log, m, i,
+                                             !serial.count(i)));
+        }
+        for (int i = 0; i < num_events; i++) {
+            events[i]->next = events[num_events + i].get();
+            events[i]->delay = delay;
+            eq.schedule(events[i].get(), 100);
+        }
+
+        while (!eq.empty())
+            eq.serviceOne();
+        return log;
+    }
+
+    EventQueue eq;
+};
+
+} // anonymous namespace
+
+/**
+ * Without batching, events are serviced in scheduling order, the events
+ * of a bin being serviced last in first out.
+ */
+TEST_F(EventBatchTest, Serial)
+{
+    const std::vector<int> log = run(4);
+    ASSERT_EQ(log, std::vector<int>({3, 2, 1, 0, 4, 5, 6, 7}));
+    ASSERT_EQ(eq.getCurTick(), Tick(200));
+}
+
+/**
+ * A batch services every commutative event of the bin, and the events
+ * scheduled from the batch are inserted in batch order, which here is
+ * the order a serial execution would have scheduled them in.
+ */
+TEST_F(EventBatchTest, Batch)
+{
+    setEventBatchThreads(4);
+    ASSERT_EQ(eventBatchThreads(), 4u);
+
+    const int num_events = 64;
+    const std::vector<int> log = run(num_events);
+    ASSERT_EQ(log.size(), size_t(2 * num_events));
+
+    // Each bin is a single batch serviced in any order, but the whole
+    // first bin is serviced before the second one.
+    std::vector<int> first(log.begin(), log.begin() + num_events);
+    std::vector<int> second(log.begin() + num_events, log.end());
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+    for (int i = 0; i < num_events; i++) {
+        ASSERT_EQ(first[i], i);
+        ASSERT_EQ(second[i], num_events + i);
+    }
+    ASSERT_EQ(eq.getCurTick(), Tick(200));
+}
+
+/**
+ * A non commutative event ends the batch, the events that follow it in
+ * the bin are batched once it has been serviced.
+ */
+TEST_F(EventBatchTest, SerialEventSplitsBatch)
+{
+    setEventBatchThreads(2);
+
+    // Events 2 and 6 (the follow-up of event 2) are not commutative.
+    // The first bin is serviced as {3}, 2, {1, 0}. Since the batches
+    // insert their follow-ups in batch order, the second bin is
+    // serviced as {4, 5}, 6, {7}, as it would be serially.
+    const std::vector<int> log = run(4, {2, 6});
+    ASSERT_EQ(log.size(), size_t(8));
+    ASSERT_EQ(log[0], 3);
+    ASSERT_EQ(log[1], 2);
+
+    std::vector<int> batch(log.begin() + 2, log.begin() + 4);
+    std::sort(batch.begin(), batch.end());
+    ASSERT_EQ(batch, std::vector<int>({0, 1}));
+
+    batch.assign(log.begin() + 4, log.begin() + 6);
+    std::sort(batch.begin(), batch.end());
+    ASSERT_EQ(batch, std::vector<int>({4, 5}));
+    ASSERT_EQ(log[6], 6);
+    ASSERT_EQ(log[7], 7);
+}
+
+/**
+ * Events scheduled for the tick and priority of their own bin are
+ * serviced right after the event scheduling them when serial, but only
+ * once the whole batch has been serviced when batched.
+ */
+TEST_F(EventBatchTest, ZeroDelay)
+{
+    std::vector<int> log = run(2, {}, 0);
+    ASSERT_EQ(log, std::vector<int>({1, 3, 0, 2}));
+    ASSERT_EQ(eq.getCurTick(), Tick(100));
+
+    // The follow-ups make a second batch of the same bin.
+    setEventBatchThreads(2);
+    log = run(2, {}, 0);
+    ASSERT_EQ(log.size(), size_t(4));
+    std::vector<int> batch(log.begin(), log.begin() + 2);
+    std::sort(batch.begin(), batch.end());
+    ASSERT_EQ(batch, std::vector<int>({0, 1}));
+    batch.assign(log.begin() + 2, log.end());
+    std::sort(batch.begin(), batch.end());
+    ASSERT_EQ(batch, std::vector<int>({2, 3}));
+}
@@ -29,7 +29,12 @@
 
 #include "sim/global_event.hh"
 
+#include <algorithm>
+#include <chrono>
+
+#include "base/stats/storage.hh"
 #include "sim/cur_tick.hh"
+#include "sim/root.hh"
 
 namespace gem5
 {
@@ -143,6 +148,8 @@ GlobalEvent::BarrierEvent::process()
 void
 GlobalSyncEvent::BarrierEvent::process()
 {
+    const auto start = std::chrono::steady_clock::now();
+
     // wait for all queues to arrive at barrier, then process event
     if (globalBarrier()) {
         _globalEvent->process();
@@ -151,14 +158,48 @@ GlobalSyncEvent::BarrierEvent::process()
     // second barrier to force all queues to wait for event processing
     // to finish before continuing
     globalBarrier();
+
+    // The stat shard of a simulation thread is its event queue index.
+    const std::chrono::duration<double> waited =
+        std::chrono::steady_clock::now() - start;
+    rootStats.syncBarrierWait[statistics::curStatShard()] += waited.count();
+
     curEventQueue()->handleAsyncInsertions();
 }
 
+Tick
+GlobalSyncEvent::nextSyncTick() const
+{
+    const Tick fixed = curTick() + repeat;
+    if (!adaptiveSimQuantum)
+        return fixed;
+
+    // All the other threads are waiting on the barrier, so we can safely
+    // look at their queues. Any event that the earliest pending event
+    // schedules into another queue is at least simQuantum ticks in the
+    // future, so no queue can be affected by another one before that.
+    Tick earliest = MaxTick;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+        EventQueue *q = mainEventQueue[i];
+        if (!q->empty())
+            earliest = std::min(earliest, q->nextTick());
+        earliest = std::min(earliest, q->nextAsyncTick());
+    }
+
+    if (earliest >= MaxTick - repeat)
+        return fixed;
+
+    return std::max(fixed, earliest + repeat);
+}
+
 void
 GlobalSyncEvent::process()
 {
     if (repeat) {
-        schedule(curTick() + repeat);
+        const Tick when = nextSyncTick();
+        rootStats.numQuantumSyncs++;
+        rootStats.quantumTicks += when - curTick();
+        schedule(when);
     }
 }
 
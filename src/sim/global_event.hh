@@ -234,6 +234,14 @@ class GlobalSyncEvent : public BaseGlobalEventTemplate<GlobalSyncEvent>
     const char *description() const;
 
     Tick repeat;
+
+  private:
+    /**
+     * Compute the tick of the next synchronisation. With a fixed quantum
+     * this is repeat ticks from now, in adaptive mode the quantum is
+     * stretched to end repeat ticks after the earliest pending event.
+     */
+    Tick nextSyncTick() const;
 };
 
 } // namespace gem5
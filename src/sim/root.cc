@@ -41,10 +41,12 @@
 
 #include "base/hostinfo.hh"
 #include "base/logging.hh"
+#include "base/output.hh"
 #include "base/trace.hh"
 #include "debug/TimeSync.hh"
 #include "sim/core.hh"
 #include "sim/cur_tick.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq.hh"
 #include "sim/full_system.hh"
 #include "sim/root.hh"
@@ -75,6 +77,20 @@ Root::RootStats::RootStats()
              "The number of ticks simulated per host second (ticks/s)"),
     ADD_STAT(hostMemory, statistics::units::Byte::get(),
              "Number of bytes of host memory used"),
+    ADD_STAT(syncBarrierWait, statistics::units::Second::get(),
+             "Real time each event queue spent waiting on quantum "
+             "barriers"),
+    ADD_STAT(numQuantumSyncs, statistics::units::Count::get(),
+             "Number of quantum synchronisations between event queues"),
+    ADD_STAT(quantumTicks, statistics::units::Tick::get(),
+             "Number of ticks covered by the synchronised quanta"),
+    ADD_STAT(avgQuantum, statistics::units::Rate<
+                statistics::units::Tick, statistics::units::Count>::get(),
+             "Average length of a synchronised quantum"),
+    ADD_STAT(profiledEvents, statistics::units::Count::get(),
+             "Number of events accounted by the event profile"),
+    ADD_STAT(profiledHostSeconds, statistics::units::Second::get(),
+             "Real time spent servicing the profiled events"),
 
     statTime(true),
     startTick(0)
@@ -101,6 +117,38 @@ Root::RootStats::RootStats()
 
     simSeconds = simTicks / simFreq;
     hostTickRate = simTicks / hostSeconds;
+
+    syncBarrierWait.precision(6);
+    avgQuantum = quantumTicks / numQuantumSyncs;
+
+    profiledEvents
+        .functor([]() {
+                uint64_t count = 0;
+                for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+                    if (auto *profiler = mainEventQueue[i]->profiler()) {
+                        for (const auto &entry : profiler->entries())
+                            count += entry.count;
+                    }
+                }
+                return count;
+            })
+        .prereq(profiledEvents)
+        ;
+
+    profiledHostSeconds
+        .functor([]() {
+                uint64_t host_ns = 0;
+                for (uint32_t i = 0; i < numMainEventQueues; ++i) {
+                    if (auto *profiler = mainEventQueue[i]->profiler()) {
+                        for (const auto &entry : profiler->entries())
+                            host_ns += entry.hostNs;
+                    }
+                }
+                return host_ns / 1e9;
+            })
+        .precision(6)
+        .prereq(profiledEvents)
+        ;
 }
 
 void
@@ -187,6 +235,8 @@ Root::Root(const RootParams &p, int)
     lastTime.setTimer();
 
     simQuantum = p.sim_quantum;
+    adaptiveSimQuantum = p.adaptive_sim_quantum;
+    setEventBatchThreads(p.event_batch_threads);
 
     // Some of the statistics are global and need to be accessed by
     // stat formulas. The most convenient way to implement that is by
@@ -195,10 +245,47 @@ Root::Root(const RootParams &p, int)
     mergeStatGroup(&Root::RootStats::instance);
 }
 
+void
+Root::regStats()
+{
+    SimObject::regStats();
+
+    // All the event queues have been created by now, account the barrier
+    // wait time of each one of them separately.
+    rootStats.syncBarrierWait.init(numMainEventQueues);
+}
+
 void
 Root::startup()
 {
     timeSyncEnable(params().time_sync_enable);
+
+    if (params().profile_events) {
+        for (uint32_t i = 0; i < numMainEventQueues; ++i)
+            mainEventQueue[i]->enableProfiling();
+
+        statistics::registerDumpCallback([this]() { dumpEventProfile(); });
+        statistics::registerResetCallback([]() {
+            for (uint32_t i = 0; i < numMainEventQueues; ++i)
+                mainEventQueue[i]->profiler()->clear();
+        });
+    }
+}
+
+void
+Root::dumpEventProfile()
+{
+    std::vector<const EventProfiler *> profilers;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        profilers.push_back(mainEventQueue[i]->profiler());
+
+    // The profiles are cumulative since the last stats reset, so rewrite
+    // the files on every dump.
+    OutputStream *table = simout.create("event_profile.txt");
+    OutputStream *folded = simout.create("event_profile.folded");
+    EventProfiler::dump(profilers, *table->stream(), *folded->stream());
+    simout.close(table);
+    simout.close(folded);
 }
 
 void
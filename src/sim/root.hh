@@ -80,6 +80,9 @@ class Root : public SimObject
     void timeSync();
     EventFunctionWrapper syncEvent;
 
+    /** Write the event profiles of the main event queues out. */
+    void dumpEventProfile();
+
   public:
     /**
      * Use this function to get a pointer to the single Root object in the
@@ -110,6 +113,16 @@ class Root : public SimObject
         statistics::Formula hostTickRate;
         statistics::Value hostMemory;
 
+        /** Host seconds each event queue spent on quantum barriers. */
+        statistics::Vector syncBarrierWait;
+        statistics::Scalar numQuantumSyncs;
+        statistics::Scalar quantumTicks;
+        statistics::Formula avgQuantum;
+
+        /** Totals of the event profile, if enabled. */
+        statistics::Value profiledEvents;
+        statistics::Value profiledHostSeconds;
+
         static RootStats instance;
 
       private:
@@ -144,6 +157,10 @@ class Root : public SimObject
     // create() method.
     Root(const Params &p, int);
 
+    /** Size the per-queue barrier wait stats.
+     */
+    void regStats() override;
+
     /** Schedule the timesync event at startup().
      */
     void startup() override;
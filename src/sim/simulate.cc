@@ -48,6 +48,7 @@
 
 #include "base/logging.hh"
 #include "base/pollevent.hh"
+#include "base/stats/storage.hh"
 #include "base/types.hh"
 #include "sim/async.hh"
 #include "sim/eventq.hh"
@@ -101,8 +102,8 @@ class SimulatorThreads
             // We'll call these the "subordinate" threads.
             for (uint32_t i = 1; i < numQueues; i++) {
                 threads.emplace_back(
-                    [this](EventQueue *eq) {
-                        thread_main(eq);
+                    [this, i](EventQueue *eq) {
+                        thread_main(i, eq);
                     }, mainEventQueue[i]);
             }
         }
@@ -146,10 +147,15 @@ class SimulatorThreads
      * they enter the simulation loop concurrently.  When they exit the
      * loop, they return to waiting on threadBarrier.  This process is
      * repeated until the simulation terminates.
+     *
+     * Each thread updates the sharded stats through the shard matching
+     * its event queue index, the main thread owns shard 0.
      */
     void
-    thread_main(EventQueue *queue)
+    thread_main(uint32_t index, EventQueue *queue)
     {
+        statistics::curStatShard(index);
+
         /* Wait for all initialisation to complete */
         barrier.wait();
 
@@ -206,6 +212,9 @@ simulate(Tick num_cycles)
     if (numMainEventQueues > 1) {
         fatal_if(simQuantum == 0,
                  "Quantum for multi-eventq simulation not specified");
+        fatal_if(eventBatchThreads() > 1,
+                 "Commutative event batching is not supported in "
+                 "multi-eventq simulations");
 
         quantum_event.reset(
             new GlobalSyncEvent(curTick() + simQuantum, simQuantum,
@@ -0,0 +1,383 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script evaluates DRAM address mappings offline, replaying the
+# addresses of a packet trace against candidate mappings to predict
+# their row buffer hit, miss and conflict rates, the balance of the
+# accesses over the channels and banks, and the bandwidth given by a
+# first order timing model of the banks and data buses. The decoding
+# follows the AddrRange channel selection and MemInterface decodePacket,
+# including the XOR hashing of the channels (--mem-channels-xor-masks in
+# the example configurations) and of the banks and ranks (the
+# bank_xor_masks and rank_xor_masks parameters).
+#
+# The trace is either a protobuf packet trace, or a memory mapped packet
+# trace as written by util/encode_mapped_packet_trace.py. Without
+# --candidate, a search is done over the address mappings, with and
+# without channel and bank hashing.
+
+import argparse
+import os
+import struct
+import subprocess
+import sys
+
+mappings = ['RoRaBaCoCh', 'RoRaBaChCo', 'RoCoRaBaCh']
+
+def log2(value, what):
+    if value <= 0 or value & (value - 1):
+        print("The %s (%d) must be a power of two" % (what, value))
+        exit(-1)
+    return value.bit_length() - 1
+
+def parity(value):
+    return bin(value).count('1') & 1
+
+def lowest_bit(mask):
+    return (mask & -mask).bit_length() - 1
+
+class Mapping(object):
+    """An address mapping of a set of channels, decoding a physical
+    address to a channel, rank, bank and row"""
+
+    def __init__(self, name, args, addr_mapping, channel_masks=[],
+                 bank_masks=[], rank_masks=[]):
+        self.name = name
+        self.addr_mapping = addr_mapping
+        self.channel_masks = channel_masks
+        self.bank_masks = bank_masks
+        self.rank_masks = rank_masks
+
+        self.burst_size = args.burst_size
+        self.bursts_per_row = args.row_buffer_size // args.burst_size
+        self.banks = args.banks
+        self.ranks = args.ranks
+
+        channel_bits = log2(args.channels, "number of channels")
+        if channel_masks:
+            if len(channel_masks) != channel_bits:
+                print("%s: %d channel masks for %d channel bits" %
+                      (name, len(channel_masks), channel_bits))
+                exit(-1)
+            # as AddrRange, remove the lowest bit of every mask
+            self.removed_bits = sorted(lowest_bit(m) for m in channel_masks)
+        else:
+            # as the example configurations, interleave on the row
+            # buffer when the channel bits are above the column
+            if addr_mapping == 'RoRaBaChCo':
+                low_bit = log2(args.row_buffer_size, "row buffer size")
+            else:
+                low_bit = log2(args.channel_intlv, "channel interleaving")
+            self.removed_bits = list(range(low_bit, low_bit + channel_bits))
+            self.channel_masks = [1 << b for b in self.removed_bits]
+
+        if self.removed_bits:
+            granularity = 1 << self.removed_bits[0]
+            self.bursts_per_stripe = max(1, granularity // self.burst_size)
+        else:
+            self.bursts_per_stripe = 1
+
+    def describe(self):
+        desc = self.addr_mapping
+        for what, masks in (("channel", self.channel_masks),
+                            ("bank", self.bank_masks),
+                            ("rank", self.rank_masks)):
+            if masks and (what != "channel" or
+                          any(m & (m - 1) for m in masks)):
+                desc += " %s %s" % (what, " ".join(hex(m) for m in masks))
+        return desc
+
+    def decode(self, addr):
+        channel = 0
+        for i, mask in enumerate(self.channel_masks):
+            channel |= parity(addr & mask) << i
+
+        # remove the channel bits, highest first
+        ctrl_addr = addr
+        for bit in reversed(self.removed_bits):
+            ctrl_addr = ((ctrl_addr >> (bit + 1)) << bit) | \
+                        (ctrl_addr & ((1 << bit) - 1))
+
+        burst = ctrl_addr // self.burst_size
+        if self.addr_mapping == 'RoCoRaBaCh':
+            burst //= min(self.bursts_per_row, self.bursts_per_stripe)
+        else:
+            burst //= self.bursts_per_row
+
+        bank = burst % self.banks
+        burst //= self.banks
+        rank = burst % self.ranks
+        burst //= self.ranks
+        if self.addr_mapping == 'RoCoRaBaCh' and \
+           self.bursts_per_stripe < self.bursts_per_row:
+            burst //= self.bursts_per_row // self.bursts_per_stripe
+        row = burst
+
+        for i, mask in enumerate(self.bank_masks):
+            bank ^= parity(ctrl_addr & mask) << i
+        for i, mask in enumerate(self.rank_masks):
+            rank ^= parity(ctrl_addr & mask) << i
+
+        return channel, rank * self.banks + bank, row
+
+def evaluate(mapping, packets, args):
+    """Replay the packets against a mapping, with an open page policy
+    and requests served in order per channel"""
+    num_banks = args.banks * args.ranks
+    open_row = [[None] * num_banks for c in range(args.channels)]
+    bank_ready = [[0] * num_banks for c in range(args.channels)]
+    pre_allowed = [[0] * num_banks for c in range(args.channels)]
+    bus_free = [0] * args.channels
+    per_channel = [0] * args.channels
+    per_bank = [[0] * num_banks for c in range(args.channels)]
+    outcomes = [0, 0, 0]
+    latency = 0
+    first = None
+    last = 0
+
+    for tick, addr, size in packets:
+        arrival = 0 if args.saturate else tick
+        if first is None:
+            first = arrival
+        burst_addr = addr - addr % args.burst_size
+        while burst_addr < addr + size:
+            channel, bank, row = mapping.decode(burst_addr)
+            burst_addr += args.burst_size
+
+            per_channel[channel] += 1
+            per_bank[channel][bank] += 1
+
+            start = max(arrival, bank_ready[channel][bank])
+            if open_row[channel][bank] == row:
+                outcomes[0] += 1
+                col = start
+            elif open_row[channel][bank] is None:
+                outcomes[1] += 1
+                col = start + args.tRCD
+                pre_allowed[channel][bank] = start + args.tRAS
+            else:
+                outcomes[2] += 1
+                act = max(start, pre_allowed[channel][bank]) + args.tRP
+                col = act + args.tRCD
+                pre_allowed[channel][bank] = act + args.tRAS
+            open_row[channel][bank] = row
+
+            data = max(col + args.tCL, bus_free[channel])
+            bus_free[channel] = data + args.tBURST
+            bank_ready[channel][bank] = data - args.tCL
+            latency += bus_free[channel] - arrival
+            last = max(last, bus_free[channel])
+
+    bursts = sum(outcomes)
+    mean = bursts / args.channels
+    used_banks = [n for c in per_bank for n in c]
+    return {
+        'bursts': bursts,
+        'hit': 100.0 * outcomes[0] / bursts,
+        'miss': 100.0 * outcomes[1] / bursts,
+        'conflict': 100.0 * outcomes[2] / bursts,
+        'channel_imbalance': max(per_channel) / mean,
+        'bank_imbalance': max(used_banks) * len(used_banks) / bursts,
+        'bandwidth': bursts * args.burst_size * args.tick_freq /
+                     max(1, last - first) / 1e9,
+        'latency': latency / bursts / args.tick_freq * 1e9,
+    }
+
+def read_mapped(filename, max_packets):
+    header_format = '<8sIIQQ32x'
+    with open(filename, 'rb') as f:
+        magic, version, record_size, tick_freq, num_records = \
+            struct.unpack(header_format, f.read(struct.calcsize(
+                header_format)))
+        if magic != b'gem5pktm' or version != 1:
+            print("Unsupported mapped trace", filename)
+            exit(-1)
+        record = struct.Struct('<QQI')
+        packets = []
+        for i in range(min(num_records, max_packets)):
+            packets.append(record.unpack_from(f.read(record_size)))
+    return tick_freq, packets
+
+def read_proto(filename, max_packets):
+    util_dir = os.path.dirname(os.path.realpath(__file__))
+    # Make sure the proto definitions are up to date.
+    subprocess.check_call(['make', '--quiet', '-C', util_dir,
+                           'packet_pb2.py'])
+    import packet_pb2
+    import protolib
+
+    proto_in = protolib.openFileRd(filename)
+    if proto_in.read(4).decode() != "gem5":
+        print("Unrecognized file", filename)
+        exit(-1)
+
+    header = packet_pb2.PacketHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    packets = []
+    packet = packet_pb2.Packet()
+    while len(packets) < max_packets and \
+          protolib.decodeMessage(proto_in, packet):
+        packets.append((packet.tick, packet.addr, packet.size))
+    proto_in.close()
+    return header.tick_freq, packets
+
+def parse_masks(value):
+    return [int(m, 0) for m in value.split(':')] if value else []
+
+def parse_candidate(spec, args):
+    """A candidate is given as name=<name>,mapping=<mapping>, and
+    optionally channel=, bank= and rank= lists of masks separated by
+    colons"""
+    fields = dict(f.split('=', 1) for f in spec.split(','))
+    mapping = fields.get('mapping', 'RoRaBaCoCh')
+    if mapping not in mappings:
+        print("Unknown address mapping", mapping)
+        exit(-1)
+    return Mapping(fields.get('name', spec), args, mapping,
+                   parse_masks(fields.get('channel')),
+                   parse_masks(fields.get('bank')),
+                   parse_masks(fields.get('rank')))
+
+def search_candidates(args):
+    """The address mappings, each with and without channel hashing with
+    the low row bits, and permutation based bank interleaving, where the
+    bank bits are XORed with the low row bits"""
+    channel_bits = log2(args.channels, "number of channels")
+    bank_bits = log2(args.banks, "number of banks")
+    # the row is above the column, bank and rank bits in every mapping
+    row_bit = log2(args.row_buffer_size, "row buffer size") + bank_bits + \
+              log2(args.ranks, "number of ranks")
+    bank_masks = [1 << (row_bit + i) for i in range(bank_bits)]
+    intlv_bit = log2(args.channel_intlv, "channel interleaving")
+
+    candidates = []
+    for mapping in mappings:
+        for hash_channels in (False, True) if channel_bits else (False,):
+            channel_masks = []
+            if hash_channels:
+                # the channel bits are below the row in the physical
+                # address, shifting it up
+                low_bit = intlv_bit
+                if mapping == 'RoRaBaChCo':
+                    low_bit = log2(args.row_buffer_size, "row buffer")
+                channel_masks = [(1 << (low_bit + i)) |
+                                 (1 << (row_bit + channel_bits + i))
+                                 for i in range(channel_bits)]
+            for hash_banks in (False, True):
+                name = mapping + (" ch-xor" if hash_channels else "") + \
+                       (" bank-xor" if hash_banks else "")
+                candidates.append(Mapping(name, args, mapping,
+                                          channel_masks,
+                                          bank_masks if hash_banks else []))
+    return candidates
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Evaluate DRAM address mappings on a packet trace")
+    parser.add_argument("trace", help="protobuf or mapped packet trace")
+    parser.add_argument("--candidate", action="append", default=[],
+                        help="mapping to evaluate, as name=<name>,"
+                        "mapping=<RoRaBaCoCh|RoRaBaChCo|RoCoRaBaCh>"
+                        "[,channel=<masks>][,bank=<masks>][,rank=<masks>]"
+                        " with masks separated by colons, can be "
+                        "repeated")
+    parser.add_argument("--max-packets", type=int, default=1000000,
+                        help="number of packets to replay")
+    parser.add_argument("--saturate", action="store_true",
+                        help="ignore the trace ticks and issue all the "
+                        "packets at once, to compare peak bandwidths")
+
+    # The defaults are those of the DDR3_1600_8x8 and the example
+    # configurations
+    parser.add_argument("--channels", type=int, default=1)
+    parser.add_argument("--channel-intlv", type=int, default=128,
+                        help="channel interleaving granularity, in bytes")
+    parser.add_argument("--burst-size", type=int, default=64)
+    parser.add_argument("--row-buffer-size", type=int, default=8192)
+    parser.add_argument("--banks", type=int, default=8,
+                        help="banks per rank")
+    parser.add_argument("--ranks", type=int, default=2,
+                        help="ranks per channel")
+    parser.add_argument("--tRCD", type=float, default=13.75,
+                        help="in ns, as the other timings")
+    parser.add_argument("--tCL", type=float, default=13.75)
+    parser.add_argument("--tRP", type=float, default=13.75)
+    parser.add_argument("--tRAS", type=float, default=35)
+    parser.add_argument("--tBURST", type=float, default=5)
+    args = parser.parse_args()
+
+    with open(args.trace, 'rb') as f:
+        mapped = f.read(8) == b'gem5pktm'
+    if mapped:
+        args.tick_freq, packets = read_mapped(args.trace, args.max_packets)
+    else:
+        args.tick_freq, packets = read_proto(args.trace, args.max_packets)
+
+    if not packets:
+        print("No packets in", args.trace)
+        exit(-1)
+
+    # convert the timings to ticks
+    for timing in ['tRCD', 'tCL', 'tRP', 'tRAS', 'tBURST']:
+        setattr(args, timing,
+                int(getattr(args, timing) * args.tick_freq / 1e9))
+
+    if args.candidate:
+        candidates = [parse_candidate(c, args) for c in args.candidate]
+    else:
+        candidates = search_candidates(args)
+
+    results = [(evaluate(c, packets, args), c) for c in candidates]
+    results.sort(key=lambda r: (-r[0]['bandwidth'], r[0]['conflict']))
+
+    print("Replayed %d packets, %d bursts" %
+          (len(packets), results[0][0]['bursts']))
+    print("%-32s %7s %7s %7s %7s %7s %9s %9s" %
+          ("mapping", "hit %", "miss %", "confl %", "ch imb", "bk imb",
+           "GB/s", "lat (ns)"))
+    for result, candidate in results:
+        print("%-32s %7.2f %7.2f %7.2f %7.2f %7.2f %9.2f %9.2f" %
+              (candidate.name[:32], result['hit'], result['miss'],
+               result['conflict'], result['channel_imbalance'],
+               result['bank_imbalance'], result['bandwidth'],
+               result['latency']))
+
+    best = results[0][1]
+    print()
+    print("Best mapping:", best.describe())
+    print("  addr_mapping = '%s'" % best.addr_mapping)
+    if best.bank_masks:
+        print("  --mem-bank-xor-masks",
+              " ".join(hex(m) for m in best.bank_masks))
+    if best.rank_masks:
+        print("  rank_xor_masks = [%s]" %
+              ", ".join(hex(m) for m in best.rank_masks))
+    if any(m & (m - 1) for m in best.channel_masks):
+        print("  --mem-channels-xor-masks",
+              " ".join(hex(m) for m in best.channel_masks))
+
+if __name__ == "__main__":
+    main()
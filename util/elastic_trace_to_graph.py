@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf elastic trace (instruction dependency
+# trace) into the precomputed dependency graph replayed by the TraceCPU
+# when its dataTraceFile points at a graph rather than a protobuf trace.
+#
+# The graph is a flat little-endian file that the TraceCPU maps into
+# memory and replays in place. It contains a 64 byte header, one 64 byte
+# record per instruction in trace order and the incoming and outgoing
+# dependency edges of every instruction in compressed sparse row form:
+#
+#   header: magic "gem5egrf", version, window size, tick frequency,
+#           number of nodes, number of edges
+#   nodes:  seq num, rob num, phys addr, virt addr, pc, comp delay, size,
+#           flags, type
+#   uint64 dep_begin[nodes + 1], uint64 child_begin[nodes + 1]
+#   uint32 deps[edges], uint32 children[edges]
+#
+# An edge holds the distance in nodes between the two instructions shifted
+# left by one, with the lowest bit set for an order (ROB) dependency. The
+# conversion applies the same rules as the protobuf reader of the TraceCPU:
+# register dependencies that duplicate an order dependency are dropped and
+# dependencies on instructions not yet seen in the trace are ignored.
+#
+# Usage: elastic_trace_to_graph.py <protobuf elastic trace> <graph output>
+
+import array
+import struct
+import sys
+
+import protolib
+
+# Import the packet proto definitions. If they are not found, attempt
+# to generate them automatically. This assumes that the script is
+# executed from the gem5 root.
+try:
+    import inst_dep_record_pb2
+except:
+    print("Did not find proto definition, attempting to generate")
+    from subprocess import call
+    error = call(['protoc', '--python_out=util', '--proto_path=src/proto',
+                  'src/proto/inst_dep_record.proto'])
+    if not error:
+        import inst_dep_record_pb2
+        print("Generated proto definitions for instruction dependency record")
+    else:
+        print("Failed to import proto definitions")
+        exit(-1)
+
+GRAPH_MAGIC = b'gem5egrf'
+GRAPH_VERSION = 1
+
+# Must match ElasticGraph::Header and ElasticGraph::Node
+HEADER = struct.Struct('<8sII3Q24x')
+NODE = struct.Struct('<6Q2IB7x')
+
+MAX_DISTANCE = (1 << 31) - 1
+
+def encode_edge(distance, is_rob):
+    if distance > MAX_DISTANCE:
+        print("Dependency distance", distance, "is too large to encode")
+        exit(-1)
+    return (distance << 1) | (1 if is_rob else 0)
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <graph output>")
+        exit(-1)
+
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4)
+    if magic_number != b"gem5":
+        print("Unrecognized file")
+        exit(-1)
+
+    header = inst_dep_record_pb2.InstDepRecordHeader()
+    protolib.decodeMessage(proto_in, header)
+    print("Object id:", header.obj_id)
+    print("Tick frequency:", header.tick_freq)
+    print("Window size:", header.window_size)
+
+    nodes = bytearray()
+    deps = array.array('I')
+    dep_begin = array.array('Q', [0])
+    # Outgoing edges as (child index, edge) per parent, sorted at the end
+    children = []
+    index_of = {}
+    micro_op_count = 0
+
+    packet = inst_dep_record_pb2.InstDepRecord()
+    while protolib.decodeMessage(proto_in, packet):
+        idx = len(dep_begin) - 1
+
+        micro_op_count += 1
+        if packet.HasField('weight'):
+            micro_op_count += packet.weight
+
+        nodes += NODE.pack(packet.seq_num, micro_op_count,
+                           packet.p_addr if packet.HasField('p_addr') else 0,
+                           packet.v_addr if packet.HasField('v_addr') else 0,
+                           packet.pc if packet.HasField('pc') else 0,
+                           packet.comp_delay,
+                           packet.size if packet.HasField('size') else 0,
+                           packet.flags if packet.HasField('flags') else 0,
+                           packet.type)
+
+        rob_deps = list(packet.rob_dep)
+        reg_deps = [dep for dep in packet.reg_dep if dep not in rob_deps]
+        for is_rob, dep_list in ((True, rob_deps), (False, reg_deps)):
+            for dep in dep_list:
+                parent = index_of.get(dep)
+                if parent is None:
+                    continue
+                edge = encode_edge(idx - parent, is_rob)
+                deps.append(edge)
+                children[parent].append((idx, edge))
+
+        dep_begin.append(len(deps))
+        children.append([])
+        index_of[packet.seq_num] = idx
+
+    proto_in.close()
+
+    num_nodes = len(dep_begin) - 1
+    child_begin = array.array('Q', [0])
+    child_edges = array.array('I')
+    for child_list in children:
+        # Python's sort is stable, keeping the edges of a child in order
+        child_list.sort(key=lambda child: child[0])
+        child_edges.extend(edge for _, edge in child_list)
+        child_begin.append(len(child_edges))
+
+    if sys.byteorder != 'little':
+        for arr in (deps, dep_begin, child_begin, child_edges):
+            arr.byteswap()
+
+    try:
+        graph_out = open(sys.argv[2], 'wb')
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    graph_out.write(HEADER.pack(GRAPH_MAGIC, GRAPH_VERSION,
+                                header.window_size, header.tick_freq,
+                                num_nodes, len(deps)))
+    graph_out.write(nodes)
+    graph_out.write(dep_begin.tobytes())
+    graph_out.write(child_begin.tobytes())
+    graph_out.write(deps.tobytes())
+    graph_out.write(child_edges.tobytes())
+    graph_out.close()
+
+    print("Converted nodes:", num_nodes)
+    print("Dependency edges:", len(deps))
+
+if __name__ == "__main__":
+    main()
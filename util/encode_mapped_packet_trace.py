@@ -0,0 +1,123 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# This script converts a protobuf packet trace to the memory mapped
+# packet trace format read by the TraceGen of the traffic generator,
+# see src/cpu/testers/traffic_gen/mapped_trace.hh. The records are
+# sorted by tick, as the trace player seeks in the trace by a binary
+# search on the ticks.
+
+import os
+import protolib
+import struct
+import subprocess
+import sys
+
+util_dir = os.path.dirname(os.path.realpath(__file__))
+# Make sure the proto definitions are up to date.
+subprocess.check_call(['make', '--quiet', '-C', util_dir, 'packet_pb2.py'])
+import packet_pb2
+
+# Magic, version, record size, tick frequency, number of records and
+# reserved space, all Little Endian
+header_format = '<8sIIQQ32x'
+header_magic = b'gem5pktm'
+header_version = 1
+
+# Tick, address, size, flags, command and reserved space
+record_format = '<QQIII4x'
+record_size = struct.calcsize(record_format)
+
+def main():
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], " <protobuf input> <mapped output>")
+        exit(-1)
+
+    # Open the file in read mode
+    proto_in = protolib.openFileRd(sys.argv[1])
+
+    try:
+        mapped_out = open(sys.argv[2], 'w+b')
+    except IOError:
+        print("Failed to open ", sys.argv[2], " for writing")
+        exit(-1)
+
+    # Read the magic number in 4-byte Little Endian
+    magic_number = proto_in.read(4).decode()
+
+    if magic_number != "gem5":
+        print("Unrecognized file", sys.argv[1])
+        exit(-1)
+
+    print("Parsing packet header")
+
+    header = packet_pb2.PacketHeader()
+    protolib.decodeMessage(proto_in, header)
+
+    print("Tick frequency:", header.tick_freq)
+
+    # Leave room for the header, which is written once the number of
+    # records is known
+    mapped_out.write(bytes(struct.calcsize(header_format)))
+
+    print("Converting packets")
+
+    num_packets = 0
+    last_tick = 0
+    is_sorted = True
+    packet = packet_pb2.Packet()
+
+    # Decode the packet messages until we hit the end of the file
+    while protolib.decodeMessage(proto_in, packet):
+        num_packets += 1
+        is_sorted = is_sorted and packet.tick >= last_tick
+        last_tick = packet.tick
+        flags = packet.flags if packet.HasField('flags') else 0
+        mapped_out.write(struct.pack(record_format, packet.tick,
+                                     packet.addr, packet.size, flags,
+                                     packet.cmd))
+
+    print("Converted packets:", num_packets)
+
+    if not is_sorted:
+        print("Sorting packets by tick")
+        mapped_out.seek(struct.calcsize(header_format))
+        records = [mapped_out.read(record_size) for _ in range(num_packets)]
+        # Keep the order of the packets sent at the same tick
+        records.sort(key=lambda record: struct.unpack_from('<Q', record))
+        mapped_out.seek(struct.calcsize(header_format))
+        mapped_out.writelines(records)
+
+    mapped_out.seek(0)
+    mapped_out.write(struct.pack(header_format, header_magic,
+                                 header_version, record_size,
+                                 header.tick_freq, num_packets))
+
+    # We're done
+    mapped_out.close()
+    proto_in.close()
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import re
+import sys
+
+kinds = ["rowHit", "rowMiss", "rowConflict"]
+
+def parse_stats(stats):
+    """Return the stats of every dump as a dictionary"""
+    dumps = []
+    for line in stats:
+        if "Begin Simulation Statistics" in line:
+            dumps.append({})
+            continue
+        match = re.match("(\S+)\s+(\S+)\s+#.*", line)
+        if match and dumps:
+            try:
+                dumps[-1][match.group(1)] = float(match.group(2))
+            except ValueError:
+                pass
+    return dumps
+
+def solve(matrix, rhs):
+    """Solve a small linear system by Gaussian elimination"""
+    n = len(rhs)
+    rows = [matrix[i][:] + [rhs[i]] for i in range(n)]
+    for col in range(n):
+        pivot = max(range(col, n), key=lambda i: abs(rows[i][col]))
+        rows[col], rows[pivot] = rows[pivot], rows[col]
+        for i in range(col + 1, n):
+            factor = rows[i][col] / rows[col][col]
+            for j in range(col, n + 1):
+                rows[i][j] -= factor * rows[col][j]
+    x = [0.0] * n
+    for i in reversed(range(n)):
+        x[i] = (rows[i][n] - sum(rows[i][j] * x[j]
+                                 for j in range(i + 1, n))) / rows[i][i]
+    return x
+
+# Compare the detailed memory controller and the FastDRAM for every phase
+# of the configs/dram/fast_dram_calibrate.py script, and fit the latency
+# scales of the FastDRAM to the read latency of the detailed controller.
+# The scales only change the latency table, and the queueing changes with
+# it, so run the script again with the new scales until they settle.
+def main():
+
+    if len(sys.argv) != 2:
+        print("Usage: ", sys.argv[0], "<simout directory>")
+        exit(-1)
+
+    try:
+        stats = open(sys.argv[1] + '/stats.txt', 'r')
+    except IOError:
+        print("Failed to open ", sys.argv[1] + '/stats.txt', " for reading")
+        exit(-1)
+
+    try:
+        simout = open(sys.argv[1] + '/simout', 'r')
+    except IOError:
+        print("Failed to open ", sys.argv[1] + '/simout', " for reading")
+        exit(-1)
+
+    # Get the phases and the scales used from the simulation output
+    phases = []
+    scales = None
+    for line in simout:
+        match = re.match("Phase \d+: (.*)", line)
+        if match:
+            phases.append(match.group(1))
+        match = re.match("FastDRAM scales: hit (\S+), miss (\S+), "
+                         "conflict (\S+)", line)
+        if match:
+            scales = [float(s) for s in match.groups()]
+    simout.close()
+
+    if not phases or scales is None:
+        print("Failed to establish calibration details, ensure simout is "
+              "up-to-date")
+        exit(-1)
+
+    dumps = parse_stats(stats)
+    stats.close()
+
+    # Every row of the least squares problem is a phase, the unknowns
+    # are the relative changes of the scales
+    matrix = []
+    rhs = []
+
+    print("%-56s %10s %10s %7s %8s %8s %7s" %
+          ("phase", "lat (ns)", "fast (ns)", "err %", "GB/s", "fast",
+           "err %"))
+
+    for phase, dump in zip(phases, dumps):
+        try:
+            reads = dump["fast.tgen.totalReads"]
+            lat = dump["detailed.tgen.avgReadLatency"]
+            fast_lat = dump["fast.tgen.avgReadLatency"]
+            bw = dump["detailed.tgen.readBW"] + dump["detailed.tgen.writeBW"]
+            fast_bw = dump["fast.tgen.readBW"] + dump["fast.tgen.writeBW"]
+            table = [dump["fast.mem_ctrl.readAccessLat::" + kind]
+                     for kind in kinds]
+        except KeyError:
+            # no reads in this phase
+            continue
+
+        if reads == 0 or lat == 0:
+            continue
+
+        print("%-56s %10.2f %10.2f %7.2f %8.2f %8.2f %7.2f" %
+              (phase, lat / 1000, fast_lat / 1000,
+               100 * (fast_lat - lat) / lat, bw / 1e9, fast_bw / 1e9,
+               100 * (fast_bw - bw) / bw if bw else 0))
+
+        matrix.append([t / reads for t in table])
+        rhs.append(lat - fast_lat)
+
+    if not matrix:
+        print("No phase with reads to calibrate against")
+        exit(-1)
+
+    # Normal equations, slightly regularised so that a kind of access
+    # that never occurs keeps its scale
+    n = len(kinds)
+    normal = [[sum(row[i] * row[j] for row in matrix) for j in range(n)]
+              for i in range(n)]
+    trace = sum(normal[i][i] for i in range(n))
+    for i in range(n):
+        normal[i][i] += 1e-6 * trace
+    proj = [sum(row[i] * b for row, b in zip(matrix, rhs))
+            for i in range(n)]
+    change = solve(normal, proj)
+
+    new_scales = [max(0.05, s * (1 + c)) for s, c in zip(scales, change)]
+
+    print()
+    print("Suggested scales: --row-hit-scale %.4f --row-miss-scale %.4f "
+          "--row-conflict-scale %.4f" % tuple(new_scales))
+
+if __name__ == "__main__":
+    main()
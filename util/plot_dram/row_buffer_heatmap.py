@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+try:
+    import matplotlib.pyplot as plt
+    import numpy as np
+except ImportError:
+    print("Failed to import matplotlib and numpy")
+    exit(-1)
+
+import struct
+import sys
+
+outcomes = ["hits", "misses", "conflicts"]
+
+def read_trace(filename):
+    """Return the interval, the interval start ticks, and the counts per
+    interval, bank and outcome of a row buffer timeline"""
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    magic, version, num_banks, interval, tick_freq = \
+        struct.unpack_from('<8sIIQQ', data)
+    if magic != b'gem5rowb' or version != 1:
+        print("%s is not a row buffer timeline" % filename)
+        exit(-1)
+
+    record = struct.Struct('<Q%dI' % (num_banks * len(outcomes)))
+    starts = []
+    counts = []
+    for values in record.iter_unpack(data[32:]):
+        starts.append(values[0])
+        counts.append(values[1:])
+
+    counts = np.array(counts, dtype=float).reshape(len(starts), num_banks,
+                                                   len(outcomes))
+    return interval, tick_freq, np.array(starts), counts
+
+# This script plots the per bank row buffer timeline written by a
+# DRAMInterface with row_trace_interval set: the number of bursts, and
+# the fraction of them that hit, missed and conflicted in the row
+# buffer, per bank and interval. Idle intervals are left blank.
+def main():
+
+    if len(sys.argv) != 3:
+        print("Usage: ", sys.argv[0], "<row buffer timeline> <output file>")
+        exit(-1)
+
+    interval, tick_freq, starts, counts = read_trace(sys.argv[1])
+    if not len(starts):
+        print("No bursts in the timeline")
+        exit(-1)
+
+    # place the recorded intervals on a regular grid, in microseconds
+    index = (starts - starts[0]) // interval
+    num_banks = counts.shape[1]
+    bursts = np.full((num_banks, index[-1] + 1), np.nan)
+    bursts[:, index] = counts.sum(axis=2).T
+    extent = [starts[0] * 1e6 / tick_freq,
+              (starts[-1] + interval) * 1e6 / tick_freq,
+              num_banks - 0.5, -0.5]
+
+    fig, axes = plt.subplots(len(outcomes) + 1, 1, sharex=True,
+                             figsize=(10, 3 * (len(outcomes) + 1)))
+
+    im = axes[0].imshow(bursts, aspect='auto', interpolation='nearest',
+                        extent=extent, cmap='viridis')
+    axes[0].set_title("Bursts per interval")
+    fig.colorbar(im, ax=axes[0])
+
+    for i, outcome in enumerate(outcomes):
+        rate = np.full(bursts.shape, np.nan)
+        with np.errstate(invalid='ignore', divide='ignore'):
+            rate[:, index] = (counts[:, :, i] / counts.sum(axis=2)).T
+        rate[bursts == 0] = np.nan
+        im = axes[i + 1].imshow(rate, aspect='auto', interpolation='nearest',
+                                extent=extent, cmap='magma', vmin=0, vmax=1)
+        axes[i + 1].set_title("Fraction of row " + outcome)
+        fig.colorbar(im, ax=axes[i + 1])
+
+    for ax in axes:
+        ax.set_ylabel("Bank")
+    axes[-1].set_xlabel("Time (us)")
+
+    plt.savefig(sys.argv[2], bbox_inches='tight')
+
+    # summarise the whole timeline per bank as well
+    total = counts.sum(axis=0)
+    print("%6s %10s %8s %8s %8s" % ("bank", "bursts", "hit %", "miss %",
+                                    "confl %"))
+    for bank in range(num_banks):
+        n = total[bank].sum()
+        if n:
+            print("%6d %10d %8.2f %8.2f %8.2f" %
+                  ((bank, n) + tuple(100 * total[bank] / n)))
+
+if __name__ == "__main__":
+    main()